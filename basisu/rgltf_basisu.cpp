@@ -0,0 +1,93 @@
+/*
+ * rgltf
+ *
+ * Reference KHR_texture_basisu (KTX2) transcoder for rgltf, backed by the Basis Universal transcoder
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ */
+#include "rgltf_basisu.h"
+#include <basisu_transcoder.h>
+
+#include <mutex>
+
+// Get transcoder format for a raylib pixel format, images without alpha use the smaller RGB formats
+static bool GetTranscoderFormat(int format, bool alpha, basist::transcoder_texture_format *result, int *pixelFormat)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA: *result = basist::transcoder_texture_format::cTFASTC_4x4_RGBA; *pixelFormat = format; break;
+		case PIXELFORMAT_COMPRESSED_DXT5_RGBA:
+		case PIXELFORMAT_COMPRESSED_DXT1_RGB:
+		{
+			*result = alpha? basist::transcoder_texture_format::cTFBC3_RGBA : basist::transcoder_texture_format::cTFBC1_RGB;
+			*pixelFormat = alpha? PIXELFORMAT_COMPRESSED_DXT5_RGBA : PIXELFORMAT_COMPRESSED_DXT1_RGB;
+		} break;
+		case PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA:
+		case PIXELFORMAT_COMPRESSED_ETC2_RGB:
+		{
+			*result = alpha? basist::transcoder_texture_format::cTFETC2_RGBA : basist::transcoder_texture_format::cTFETC1_RGB;
+			*pixelFormat = alpha? PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA : PIXELFORMAT_COMPRESSED_ETC2_RGB;
+		} break;
+		case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: *result = basist::transcoder_texture_format::cTFRGBA32; *pixelFormat = format; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+Image TranscodeGLTFImage(const unsigned char *data, int dataSize, int format, void *userData)
+{
+	(void)userData;
+	Image image = { 0 };
+
+	// NOTE: Transcoder tables are initialized once, images are transcoded by several threads
+	static std::once_flag initialized;
+	std::call_once(initialized, basist::basisu_transcoder_init);
+
+	basist::ktx2_transcoder transcoder;
+	if (!transcoder.init(data, (uint32_t)dataSize) || !transcoder.start_transcoding()) return image;
+
+	basist::transcoder_texture_format transcoderFormat;
+	int pixelFormat = 0;
+	if (!GetTranscoderFormat(format, transcoder.get_has_alpha(), &transcoderFormat, &pixelFormat)) return image;
+
+	bool uncompressed = basist::basis_transcoder_format_is_uncompressed(transcoderFormat);
+	uint32_t unitSize = basist::basis_get_bytes_per_block_or_pixel(transcoderFormat);
+	uint32_t levels = transcoder.get_levels();
+
+	// Get size of all mipmap levels, stored consecutively as raylib expects
+	size_t size = 0;
+	for (uint32_t level = 0; level < levels; level++)
+	{
+		basist::ktx2_image_level_info info;
+		if (!transcoder.get_image_level_info(info, level, 0, 0)) return image;
+		size += (size_t)(uncompressed? info.m_orig_width*info.m_orig_height : info.m_total_blocks)*unitSize;
+	}
+
+	unsigned char *pixels = (unsigned char *)RL_MALLOC(size);
+	size_t offset = 0;
+
+	for (uint32_t level = 0; level < levels; level++)
+	{
+		basist::ktx2_image_level_info info;
+		transcoder.get_image_level_info(info, level, 0, 0);
+		uint32_t units = uncompressed? info.m_orig_width*info.m_orig_height : info.m_total_blocks;
+
+		if (!transcoder.transcode_image_level(level, 0, 0, pixels + offset, units, transcoderFormat))
+		{
+			RL_FREE(pixels);
+			return image;
+		}
+
+		offset += (size_t)units*unitSize;
+	}
+
+	image.data = pixels;
+	image.width = (int)transcoder.get_width();
+	image.height = (int)transcoder.get_height();
+	image.mipmaps = (int)levels;
+	image.format = pixelFormat;
+
+	return image;
+}
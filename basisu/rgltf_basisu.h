@@ -0,0 +1,42 @@
+/*
+ * rgltf
+ *
+ * Reference KHR_texture_basisu (KTX2) transcoder for rgltf, backed by the Basis Universal transcoder
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rgltf.h"
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Usage:
+//    GLTFLoadOptions options = { 0 };
+//    options.transcodeImage = TranscodeGLTFImage;
+//    GLTFModel model = LoadGLTFModelFromMemory(data, size, basePath, &options);
+
+RLAPI Image TranscodeGLTFImage(const unsigned char *data, int dataSize, int format, void *userData);    // Transcode KTX2 image with all its mipmaps (GLTFTranscodeImageCallback)
+
+#if defined(__cplusplus)
+}            // Prevents name mangling of functions
+#endif
@@ -0,0 +1,295 @@
+/*
+ * rgltf
+ *
+ * Micro-benchmark: vertex attribute decoding kernels (rgltf_decode.h) vs the
+ * previous per-component LOAD_ATTRIBUTE macro and temporary buffer conversions,
+ * base64 decoding vs cgltf_load_buffer_base64(), and EXT_meshopt_compression
+ * decoders (rgltf_meshopt.h) checked against known encoded streams
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ */
+#include "rgltf_decode.h"
+#include "rgltf_meshopt.h"
+
+#define CGLTF_IMPLEMENTATION
+#include "cgltf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VERTEX_COUNT 1000000
+#define ITERATIONS 20
+
+// Keep benchmarked calls opaque, so repeated iterations can't be merged
+#if defined(_MSC_VER)
+    #define BENCH_NOINLINE __declspec(noinline)
+#else
+    #define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+// Previous attributes loading code, kept for comparison
+#define LOAD_ATTRIBUTE(src, stride, count, numComp, dataType, dstPtr) \
+    { \
+        int n = 0; \
+        dataType *buffer = (dataType *)(src); \
+        for (unsigned int k = 0; k < (count); k++) \
+        {\
+            for (int l = 0; l < numComp; l++) \
+            {\
+                dstPtr[numComp*k + l] = buffer[n + l];\
+            }\
+            n += (int)((stride)/sizeof(dataType));\
+        }\
+    }
+
+static double GetTimeMs(void)
+{
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+BENCH_NOINLINE static void OldCopyVec3(float *dst, const void *src, size_t stride, size_t count) { LOAD_ATTRIBUTE(src, stride, count, 3, float, dst) }
+BENCH_NOINLINE static void NewCopyVec3(float *dst, const void *src, size_t stride, size_t count) { DecodeCopy(dst, src, stride, count, 3*sizeof(float)); }
+BENCH_NOINLINE static void NewColorsU16(unsigned char *dst, const void *src, size_t stride, size_t count) { DecodeColorsU16(dst, src, stride, count); }
+BENCH_NOINLINE static void NewColorsF32(unsigned char *dst, const void *src, size_t stride, size_t count) { DecodeColorsF32(dst, src, stride, count); }
+BENCH_NOINLINE static void NewIndicesU32(unsigned short *dst, const void *src, size_t count) { DecodeIndicesU32(dst, src, count); }
+
+BENCH_NOINLINE static void OldColorsU16(unsigned char *dst, const void *src, size_t stride, size_t count)
+{
+	unsigned short *temp = malloc(count*4*sizeof(unsigned short));
+	LOAD_ATTRIBUTE(src, stride, count, 4, unsigned short, temp)
+	for (size_t c = 0; c < count*4; c++) dst[c] = (unsigned char)(((float)temp[c]/65535.0f)*255.0f);
+	free(temp);
+}
+
+BENCH_NOINLINE static void OldColorsF32(unsigned char *dst, const void *src, size_t stride, size_t count)
+{
+	float *temp = malloc(count*4*sizeof(float));
+	LOAD_ATTRIBUTE(src, stride, count, 4, float, temp)
+	for (size_t c = 0; c < count*4; c++) dst[c] = (unsigned char)(temp[c]*255.0f);
+	free(temp);
+}
+
+BENCH_NOINLINE static void OldIndicesU32(unsigned short *dst, const void *src, size_t count)
+{
+	unsigned int *temp = malloc(count*sizeof(unsigned int));
+	LOAD_ATTRIBUTE(src, sizeof(unsigned int), count, 1, unsigned int, temp)
+	for (size_t d = 0; d < count; d++) dst[d] = (unsigned short)temp[d];
+	free(temp);
+}
+
+// Previous base64 decoding, cgltf allocates the output through the memory callbacks: they return the destination
+static void *BenchAlloc(void *user, cgltf_size size) { (void)size; return user; }
+static void BenchFree(void *user, void *ptr) { (void)user; (void)ptr; }
+
+BENCH_NOINLINE static void OldBase64(unsigned char *dst, const char *src, size_t size)
+{
+	cgltf_options options = { .memory = { .alloc = BenchAlloc, .free = BenchFree, .user_data = dst } };
+	void *out = NULL;
+	cgltf_load_buffer_base64(&options, size, src, &out);
+}
+
+BENCH_NOINLINE static void NewBase64(unsigned char *dst, const char *src, size_t length)
+{
+	DecodeBase64(dst, GetBase64DecodedSize(src, length), src);
+}
+
+// Encode size bytes as base64 text (padded, null terminated)
+static char *EncodeBase64(const unsigned char *data, size_t size)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	char *text = malloc((size + 2)/3*4 + 1);
+	char *out = text;
+
+	for (size_t i = 0; i < size; i += 3, out += 4) {
+		unsigned int bits = (unsigned int)data[i] << 16;
+		if (i + 1 < size) bits |= (unsigned int)data[i + 1] << 8;
+		if (i + 2 < size) bits |= data[i + 2];
+
+		out[0] = alphabet[(bits >> 18) & 63];
+		out[1] = alphabet[(bits >> 12) & 63];
+		out[2] = (i + 1 < size)? alphabet[(bits >> 6) & 63] : '=';
+		out[3] = (i + 2 < size)? alphabet[bits & 63] : '=';
+	}
+	*out = '\0';
+
+	return text;
+}
+
+// Known meshoptimizer encoded streams and their decoded data (index, sequence and filter vectors
+// from meshoptimizer tests, the vertex stream encodes the same 4 vertices as its vertex tests)
+static const unsigned int meshoptIndicesV0[] = { 0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9 };
+static const unsigned char meshoptIndexDataV0[] = {
+	0xe0, 0xf0, 0x10, 0xfe, 0xff, 0xf0, 0x0c, 0xff, 0x02, 0x02, 0x02, 0x00, 0x76, 0x87, 0x56, 0x67,
+	0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+};
+
+// NOTE: Version 1 restarts the next vertex (0 1 2 after 2 1 3) and encodes last +1/-1 indices
+static const unsigned int meshoptIndicesV1[] = { 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 5, 2, 1, 4 };
+static const unsigned char meshoptIndexDataV1[] = {
+	0xe1, 0xf0, 0x10, 0xfe, 0x1f, 0x3d, 0x00, 0x0a, 0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86,
+	0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+};
+
+static const unsigned int meshoptSequence[] = { 0, 1, 51, 2, 49, 1000 };
+static const unsigned char meshoptSequenceData[] = {
+	0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00, 0x00,
+};
+
+// Vertices: u16 position xyz, u8 octahedral normal uv, u16 texcoord uv (12 bytes)
+static const unsigned short meshoptVertices[] = {
+	0, 0, 0, 0, 0, 0,
+	300, 0, 0, 0, 500, 0,
+	0, 300, 0, 0, 0, 500,
+	300, 300, 0, 0, 500, 500,
+};
+static const unsigned char meshoptVertexData[] = {
+	0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c,
+	0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3f, 0x00,
+	0x00, 0x00, 0x17, 0x18, 0x17, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x00, 0x00, 0x00, 0x17,
+	0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const unsigned char meshoptOct8[] = { 0, 1, 127, 0, 0, 187, 127, 1, 255, 1, 127, 0, 14, 130, 127, 1 };
+static const unsigned char meshoptOct8Decoded[] = { 0, 1, 127, 0, 0, 159, 82, 1, 255, 1, 127, 0, 1, 130, 241, 1 };
+static const unsigned short meshoptOct12[] = { 0, 1, 2047, 0, 0, 1870, 2047, 1, 2017, 1, 2047, 0, 14, 1300, 2047, 1 };
+static const unsigned short meshoptOct12Decoded[] = { 0, 16, 32767, 0, 0, 32621, 3088, 1, 32764, 16, 471, 0, 307, 28541, 16093, 1 };
+static const unsigned short meshoptQuat12[] = { 0, 1, 0, 0x7fc, 0, 1870, 0, 0x7fd, 2017, 1, 0, 0x7fe, 14, 1300, 0, 0x7ff };
+static const unsigned short meshoptQuat12Decoded[] = { 32767, 0, 11, 0, 0, 25013, 0, 21166, 11, 0, 23504, 22830, 158, 14715, 0, 29277 };
+static const unsigned int meshoptExp[] = { 0, 0xff000003, 0x02fffff7, 0xfe7fffff };
+static const unsigned int meshoptExpDecoded[] = { 0, 0x3fc00000, 0xc2100000, 0x49fffffe };
+
+// Check decoded data against its expected value, returns 1 on mismatch
+static int Check(const char *name, bool decoded, const void *data, const void *expected, size_t size)
+{
+	int match = decoded && ((size == 0) || (memcmp(data, expected, size) == 0));
+	printf("%-28s %s\n", name, match? "OK" : "MISMATCH");
+
+	return !match;
+}
+
+// Decode the known meshoptimizer streams (u16 and u32 indices), returns the number of mismatches
+static int CheckMeshopt(void)
+{
+	int failed = 0;
+	unsigned int indices[16];
+	unsigned short indices16[16];
+	unsigned short expected16[16];
+	unsigned char buffer[64];
+
+	failed += Check("meshopt triangles v0", DecodeMeshoptTriangles(indices, 12, 4, meshoptIndexDataV0, sizeof(meshoptIndexDataV0)),
+		indices, meshoptIndicesV0, sizeof(meshoptIndicesV0));
+	failed += Check("meshopt triangles v1", DecodeMeshoptTriangles(indices, 15, 4, meshoptIndexDataV1, sizeof(meshoptIndexDataV1)),
+		indices, meshoptIndicesV1, sizeof(meshoptIndicesV1));
+	for (int i = 0; i < 15; i++) expected16[i] = (unsigned short)meshoptIndicesV1[i];
+	failed += Check("meshopt triangles v1 u16", DecodeMeshoptTriangles(indices16, 15, 2, meshoptIndexDataV1, sizeof(meshoptIndexDataV1)),
+		indices16, expected16, 15*sizeof(unsigned short));
+	failed += Check("meshopt indices", DecodeMeshoptIndices(indices, 6, 4, meshoptSequenceData, sizeof(meshoptSequenceData)),
+		indices, meshoptSequence, sizeof(meshoptSequence));
+	failed += Check("meshopt vertices", DecodeMeshoptVertices(buffer, 4, 12, meshoptVertexData, sizeof(meshoptVertexData)),
+		buffer, meshoptVertices, sizeof(meshoptVertices));
+
+	// Truncated streams must be rejected
+	failed += Check("meshopt truncated streams", !DecodeMeshoptTriangles(indices, 12, 4, meshoptIndexDataV0, sizeof(meshoptIndexDataV0) - 1) &&
+		!DecodeMeshoptIndices(indices, 6, 4, meshoptSequenceData, sizeof(meshoptSequenceData) - 1) &&
+		!DecodeMeshoptVertices(buffer, 4, 12, meshoptVertexData, sizeof(meshoptVertexData) - 1), NULL, NULL, 0);
+
+	memcpy(buffer, meshoptOct8, sizeof(meshoptOct8));
+	failed += Check("meshopt filter oct8", DecodeMeshoptFilterOct(buffer, 4, 4), buffer, meshoptOct8Decoded, sizeof(meshoptOct8Decoded));
+	memcpy(buffer, meshoptOct12, sizeof(meshoptOct12));
+	failed += Check("meshopt filter oct12", DecodeMeshoptFilterOct(buffer, 4, 8), buffer, meshoptOct12Decoded, sizeof(meshoptOct12Decoded));
+	memcpy(buffer, meshoptQuat12, sizeof(meshoptQuat12));
+	failed += Check("meshopt filter quat12", DecodeMeshoptFilterQuat((short *)buffer, 4, 8), buffer, meshoptQuat12Decoded, sizeof(meshoptQuat12Decoded));
+	memcpy(buffer, meshoptExp, sizeof(meshoptExp));
+	failed += Check("meshopt filter exp", DecodeMeshoptFilterExp((unsigned int *)buffer, 4, 4), buffer, meshoptExpDecoded, sizeof(meshoptExpDecoded));
+
+	// Malformed strides must be rejected without writing past count*stride bytes
+	memcpy(buffer, meshoptQuat12, sizeof(meshoptQuat12));
+	failed += Check("meshopt malformed strides", !DecodeMeshoptFilterQuat((short *)buffer, 4, 4) &&
+		!DecodeMeshoptFilterOct(buffer, 4, 2) && !DecodeMeshoptFilterOct(buffer, 4, 6) && !DecodeMeshoptFilterOct(buffer, 4, 16) &&
+		!DecodeMeshoptFilterExp((unsigned int *)buffer, 4, 6) &&
+		!DecodeMeshoptVertices(buffer, 4, 6, meshoptVertexData, sizeof(meshoptVertexData)), buffer, meshoptQuat12, sizeof(meshoptQuat12));
+
+	return failed;
+}
+
+static void Report(const char *name, double oldMs, double newMs, int match)
+{
+	printf("%-28s old %8.3f ms   new %8.3f ms   speedup %5.2fx   %s\n", name, oldMs/ITERATIONS, newMs/ITERATIONS,
+		oldMs/newMs, match? "OK" : "MISMATCH");
+}
+
+#define BENCH(name, oldCall, newCall, oldDst, newDst, dstSize) \
+    { \
+        oldCall; newCall; \
+        double t0 = GetTimeMs(); \
+        for (int it = 0; it < ITERATIONS; it++) oldCall; \
+        double t1 = GetTimeMs(); \
+        for (int it = 0; it < ITERATIONS; it++) newCall; \
+        double t2 = GetTimeMs(); \
+        Report(name, t1 - t0, t2 - t1, memcmp(oldDst, newDst, dstSize) == 0); \
+    }
+
+int main(void)
+{
+	// NOTE: Volatile so the compiler can't specialize the kernels for a constant count
+	volatile size_t vertexCount = VERTEX_COUNT;
+	const size_t count = vertexCount;
+
+	// Tightly packed and interleaved (pos + normal + uv, 32 bytes) float sources
+	float *packed3 = malloc(count*3*sizeof(float));
+	float *interleaved = malloc(count*8*sizeof(float));
+	for (size_t i = 0; i < count*3; i++) packed3[i] = (float)rand()/RAND_MAX;
+	for (size_t i = 0; i < count*8; i++) interleaved[i] = (float)rand()/RAND_MAX;
+
+	unsigned short *colors16 = malloc(count*4*sizeof(unsigned short));
+	float *colors32 = malloc(count*4*sizeof(float));
+	unsigned int *indices32 = malloc(count*3*sizeof(unsigned int));
+	for (size_t i = 0; i < count*4; i++) colors16[i] = (unsigned short)(rand() & 0xffff);
+	for (size_t i = 0; i < count*4; i++) colors32[i] = (float)rand()/RAND_MAX;
+	for (size_t i = 0; i < count*3; i++) indices32[i] = (unsigned int)(rand() % 65536);
+
+	float *oldVec = malloc(count*3*sizeof(float));
+	float *newVec = malloc(count*3*sizeof(float));
+	unsigned char *oldColors = malloc(count*4);
+	unsigned char *newColors = malloc(count*4);
+	unsigned short *oldIndices = malloc(count*3*sizeof(unsigned short));
+	unsigned short *newIndices = malloc(count*3*sizeof(unsigned short));
+
+	// Base64 buffer (16 bytes per element, plus one so the text ends with padding)
+	size_t base64Size = count*16 + 1;
+	unsigned char *base64Data = malloc(base64Size);
+	for (size_t i = 0; i < base64Size; i++) base64Data[i] = (unsigned char)(rand() & 0xff);
+	char *base64Text = EncodeBase64(base64Data, base64Size);
+	size_t base64Length = strlen(base64Text);
+	unsigned char *oldBytes = malloc(base64Size);
+	unsigned char *newBytes = malloc(base64Size);
+
+	printf("%d elements, average of %d iterations (after warm-up)\n", VERTEX_COUNT, ITERATIONS);
+#if defined(RGLTF_DECODE_SSE2)
+	printf("kernels: SSE2\n");
+#elif defined(RGLTF_DECODE_NEON)
+	printf("kernels: NEON\n");
+#else
+	printf("kernels: scalar\n");
+#endif
+
+	BENCH("vec3 float packed", OldCopyVec3(oldVec, packed3, 12, count), NewCopyVec3(newVec, packed3, 12, count), oldVec, newVec, count*12)
+	BENCH("vec3 float interleaved", OldCopyVec3(oldVec, interleaved, 32, count), NewCopyVec3(newVec, interleaved, 32, count), oldVec, newVec, count*12)
+	BENCH("color u16 -> u8", OldColorsU16(oldColors, colors16, 8, count), NewColorsU16(newColors, colors16, 8, count), oldColors, newColors, count*4)
+	BENCH("color float -> u8", OldColorsF32(oldColors, colors32, 16, count), NewColorsF32(newColors, colors32, 16, count), oldColors, newColors, count*4)
+	BENCH("indices u32 -> u16", OldIndicesU32(oldIndices, indices32, count*3), NewIndicesU32(newIndices, indices32, count*3), oldIndices, newIndices, count*3*sizeof(unsigned short))
+	BENCH("base64 -> bytes", OldBase64(oldBytes, base64Text, base64Size), NewBase64(newBytes, base64Text, base64Length), oldBytes, newBytes, base64Size)
+
+	free(packed3); free(interleaved); free(colors16); free(colors32); free(indices32);
+	free(oldVec); free(newVec); free(oldColors); free(newColors); free(oldIndices); free(newIndices);
+	free(base64Data); free(base64Text); free(oldBytes); free(newBytes);
+
+	return (CheckMeshopt() > 0)? 1 : 0;
+}
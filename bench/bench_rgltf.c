@@ -0,0 +1,345 @@
+/*
+ * rgltf
+ *
+ * Benchmark: model loading stages and scene drawing frame cost, results are printed as JSON lines
+ * (one object per result) so they can be compared between rgltf versions
+ *
+ * Usage: rgltf_bench [--iterations n] [--frames n] [--samples <glTF-Sample-Models directory>] [model files...]
+ *
+ * 		- load: every model is loaded iterations times, median stage times (GLTFLoadStats) and full load time
+ * 		are reported with the loading counters (bytes read, decoded images, uploaded vertex data)
+ * 		- draw: synthetic scenes with large node counts, deep hierarchies and high primitive counts are drawn
+ * 		frames times, median (and worst) DrawGLTFScene() and frame times are reported with the per frame
+ * 		draw counters (GLTFDrawStats)
+ * 		- Khronos sample models (glTF-Sample-Models 2.0/<name>/glTF/<name>.gltf) are loaded and drawn if found
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ */
+#include "raylib.h"
+#include "raymath.h"
+#include "rgltf.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 5
+#define DEFAULT_FRAMES 200
+#define WARMUP_FRAMES 10
+
+#define WIDE_SCENE_NODES 10000      // Sibling nodes of the wide scene
+#define DEEP_SCENE_NODES 1000       // Hierarchy depth of the deep scene
+#define SCENE_PRIMITIVE_COUNT 5000  // Primitives of the primitives scene
+#define SCENE_MATERIALS 8           // Materials used by the synthetic scenes meshes
+
+// Khronos sample models, from simple to heavy
+static const char *sampleModels[] = {
+	"Box", "BoxTextured", "Duck", "Avocado", "BoomBox", "DamagedHelmet", "FlightHelmet", "Sponza", "CesiumMan", "BrainStem", "Fox"
+};
+
+static double GetTimeMs(void)
+{
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+static int CompareDoubles(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+// Get median of samples (sorted in place)
+static double GetMedian(double *samples, int count)
+{
+	qsort(samples, count, sizeof(double), CompareDoubles);
+	return (count%2 == 1)? samples[count/2] : 0.5*(samples[count/2 - 1] + samples[count/2]);
+}
+
+static double GetMax(const double *samples, int count)
+{
+	double max = samples[0];
+	for (int i = 1; i < count; i++) if (samples[i] > max) max = samples[i];
+	return max;
+}
+
+//----------------------------------------------------------------------------------
+// Load benchmark
+//----------------------------------------------------------------------------------
+
+// Load a model iterations times, median stage times (loading statistics) are reported
+static void BenchLoad(const char *name, const char *fileName, int iterations)
+{
+	// NOTE: Stage times and full load time (ms)
+	double *samples = malloc(iterations*6*sizeof(double));
+	GLTFLoadStats stats = { 0 };
+	GLTFLoadOptions options = { 0 };
+	options.stats = &stats;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		double t0 = GetTimeMs();
+		GLTFModel model = LoadGLTFModelEx(fileName, &options);
+		double loadTime = GetTimeMs() - t0;
+		bool loaded = (model.meshCount > 0) && (stats.bytesRead > 0);
+		UnloadGLTFModel(model);
+
+		if (!loaded)
+		{
+			printf("{\"bench\":\"load\",\"model\":\"%s\",\"error\":\"failed to load %s\"}\n", name, fileName);
+			free(samples);
+			return;
+		}
+
+		const double stages[6] = { stats.parseTime*1000.0, stats.bufferTime*1000.0, stats.imageTime*1000.0, stats.meshTime*1000.0, stats.uploadTime*1000.0, loadTime };
+		for (int s = 0; s < 6; s++) samples[s*iterations + i] = stages[s];
+	}
+
+	double median[6];
+	for (int s = 0; s < 6; s++) median[s] = GetMedian(&samples[s*iterations], iterations);
+
+	printf("{\"bench\":\"load\",\"model\":\"%s\",\"iterations\":%d,\"parse_ms\":%.3f,\"buffers_ms\":%.3f,\"images_ms\":%.3f,"
+		"\"meshes_ms\":%.3f,\"upload_ms\":%.3f,\"load_ms\":%.3f,\"bytes_read\":%u,\"textures_decoded\":%d,\"duplicated_images\":%d,"
+		"\"vertex_bytes\":%u,\"index_bytes\":%u}\n", name, iterations, median[0], median[1], median[2], median[3], median[4], median[5],
+		stats.bytesRead, stats.texturesDecoded, stats.duplicatedImages, stats.vertexBytes, stats.indexBytes);
+
+	free(samples);
+}
+
+//----------------------------------------------------------------------------------
+// Draw benchmark
+//----------------------------------------------------------------------------------
+
+// Growable text buffer
+typedef struct TextBuffer {
+	char *text;
+	int length;
+	int capacity;
+} TextBuffer;
+
+static void AppendText(TextBuffer *buffer, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	if (buffer->length + length + 1 > buffer->capacity)
+	{
+		while (buffer->length + length + 1 > buffer->capacity) buffer->capacity = (buffer->capacity > 0)? buffer->capacity*2 : 4096;
+		buffer->text = realloc(buffer->text, buffer->capacity);
+	}
+
+	va_start(args, format);
+	vsnprintf(buffer->text + buffer->length, length + 1, format, args);
+	va_end(args);
+	buffer->length += length;
+}
+
+// Synthetic scene kinds
+typedef enum {
+	SCENE_WIDE = 0,         // Root node with WIDE_SCENE_NODES children, each one with a mesh
+	SCENE_DEEP,             // Chain of DEEP_SCENE_NODES nodes, each one with a mesh
+	SCENE_PRIMITIVES        // A single node with a mesh of SCENE_PRIMITIVE_COUNT primitives
+} SceneKind;
+
+// Generate synthetic scene glTF, meshes are quads with SCENE_MATERIALS different materials
+static char *GenSceneGLTF(SceneKind kind, int *size)
+{
+	// Quad positions (4 vec3) and indices (6 u16), base64 encoded
+	static const char *quadBuffer = "AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAgD8AAAAAAAABAAIAAAACAAMA";
+
+	TextBuffer gltf = { 0 };
+	AppendText(&gltf, "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+		"\"buffers\":[{\"byteLength\":60,\"uri\":\"data:application/octet-stream;base64,%s\"}],"
+		"\"bufferViews\":[{\"buffer\":0,\"byteLength\":48},{\"buffer\":0,\"byteOffset\":48,\"byteLength\":12}],"
+		"\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\",\"min\":[0,0,0],\"max\":[1,1,0]},"
+		"{\"bufferView\":1,\"componentType\":5123,\"count\":6,\"type\":\"SCALAR\"}],\"materials\":[", quadBuffer);
+
+	for (int i = 0; i < SCENE_MATERIALS; i++)
+	{
+		AppendText(&gltf, "%s{\"pbrMetallicRoughness\":{\"baseColorFactor\":[%.2f,%.2f,%.2f,1]}}", (i > 0)? "," : "",
+			(float)(i & 1), (float)((i >> 1) & 1), (float)((i >> 2) & 1));
+	}
+
+	// Meshes: one per material (a mesh with every primitive for the primitives scene)
+	AppendText(&gltf, "],\"meshes\":[");
+	int meshCount = (kind == SCENE_PRIMITIVES)? 1 : SCENE_MATERIALS;
+	int primitiveCount = (kind == SCENE_PRIMITIVES)? SCENE_PRIMITIVE_COUNT : 1;
+	for (int m = 0; m < meshCount; m++)
+	{
+		AppendText(&gltf, "%s{\"primitives\":[", (m > 0)? "," : "");
+		for (int p = 0; p < primitiveCount; p++) AppendText(&gltf, "%s{\"attributes\":{\"POSITION\":0},\"indices\":1,\"material\":%d}", (p > 0)? "," : "", (m + p)%SCENE_MATERIALS);
+		AppendText(&gltf, "]}");
+	}
+
+	AppendText(&gltf, "],\"nodes\":[");
+	switch (kind)
+	{
+		case SCENE_WIDE:
+		{
+			AppendText(&gltf, "{\"children\":[");
+			for (int i = 1; i <= WIDE_SCENE_NODES; i++) AppendText(&gltf, "%s%d", (i > 1)? "," : "", i);
+			AppendText(&gltf, "]}");
+			for (int i = 0; i < WIDE_SCENE_NODES; i++) AppendText(&gltf, ",{\"mesh\":%d,\"translation\":[%d,%d,0]}", i%SCENE_MATERIALS, i%100 - 50, i/100 - 50);
+		} break;
+		case SCENE_DEEP:
+		{
+			for (int i = 0; i < DEEP_SCENE_NODES; i++)
+			{
+				AppendText(&gltf, "%s{\"mesh\":%d,\"translation\":[0.05,0,0]", (i > 0)? "," : "", i%SCENE_MATERIALS);
+				AppendText(&gltf, (i < DEEP_SCENE_NODES - 1)? ",\"children\":[%d]}" : "}", i + 1);
+			}
+		} break;
+		default: AppendText(&gltf, "{\"mesh\":0}"); break;
+	}
+	AppendText(&gltf, "]}");
+
+	*size = gltf.length;
+	return gltf.text;
+}
+
+static void BenchDraw(const char *name, GLTFModel model, int frames)
+{
+	Camera camera = { 0 };
+	camera.position = (Vector3){ 0.0f, 0.0f, 120.0f };
+	camera.target = (Vector3){ 0.0f, 0.0f, 0.0f };
+	camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+	camera.fovy = 60.0f;
+	camera.projection = CAMERA_PERSPECTIVE;
+
+	double *samples = malloc(3*frames*sizeof(double));
+	double *update = samples, *draw = samples + frames, *frame = samples + 2*frames;
+	Transform rootTransform = (model.nodeCount > 0)? model.nodes[0].transform : (Transform){ 0 };
+	GLTFDrawStats stats = { 0 };
+
+	for (int f = -WARMUP_FRAMES; f < frames; f++)
+	{
+		double t0 = GetTimeMs();
+
+		// NOTE: Moving the root node makes every world transform dirty (worst case update)
+		if (model.nodeCount > 0)
+		{
+			rootTransform.translation.z = 0.001f*(float)(f & 1);
+			SetGLTFNodeTransform(&model, 0, rootTransform);
+			UpdateGLTFModelTransforms(&model);
+		}
+		double t1 = GetTimeMs();
+
+		// NOTE: Draw counters are only collected by the last warmup frame, timed frames don't count them
+		SetGLTFDrawStats((f == -1)? &stats : NULL);
+
+		BeginDrawing();
+		ClearBackground(BLACK);
+		BeginMode3D(camera);
+		double t2 = GetTimeMs();
+		DrawGLTFScene(model, model.scene, MatrixIdentity(), WHITE);
+		double t3 = GetTimeMs();
+		EndMode3D();
+		EndDrawing();
+		double t4 = GetTimeMs();
+
+		if (f < 0) continue;
+		update[f] = t1 - t0;
+		draw[f] = t3 - t2;
+		frame[f] = t4 - t0;
+	}
+
+	double drawMax = GetMax(draw, frames);
+	double frameMax = GetMax(frame, frames);
+	printf("{\"bench\":\"draw\",\"scene\":\"%s\",\"nodes\":%d,\"meshes\":%d,\"frames\":%d,\"update_ms\":%.4f,\"draw_ms\":%.4f,"
+		"\"draw_max_ms\":%.4f,\"frame_ms\":%.4f,\"frame_max_ms\":%.4f,\"nodes_visited\":%d,\"draw_calls\":%d,\"material_switches\":%d,"
+		"\"shader_switches\":%d}\n", name, model.nodeCount, model.meshCount, frames, GetMedian(update, frames), GetMedian(draw, frames),
+		drawMax, GetMedian(frame, frames), frameMax, stats.nodesVisited, stats.drawCalls, stats.materialSwitches, stats.shaderSwitches);
+
+	free(samples);
+}
+
+static void BenchSyntheticScene(const char *name, SceneKind kind, int frames)
+{
+	int size = 0;
+	char *gltf = GenSceneGLTF(kind, &size);
+
+	GLTFLoadStats stats = { 0 };
+	GLTFLoadOptions options = { 0 };
+	options.stats = &stats;
+
+	double t0 = GetTimeMs();
+	GLTFModel model = LoadGLTFModelFromMemory((const unsigned char *)gltf, size, NULL, &options);
+	double loadTime = GetTimeMs() - t0;
+	printf("{\"bench\":\"load\",\"model\":\"%s\",\"iterations\":1,\"parse_ms\":%.3f,\"buffers_ms\":%.3f,\"meshes_ms\":%.3f,"
+		"\"upload_ms\":%.3f,\"load_ms\":%.3f,\"bytes_read\":%u,\"vertex_bytes\":%u,\"index_bytes\":%u}\n", name, stats.parseTime*1000.0,
+		stats.bufferTime*1000.0, stats.meshTime*1000.0, stats.uploadTime*1000.0, loadTime, stats.bytesRead, stats.vertexBytes, stats.indexBytes);
+
+	BenchDraw(name, model, frames);
+
+	UnloadGLTFModel(model);
+	free(gltf);
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = DEFAULT_ITERATIONS;
+	int frames = DEFAULT_FRAMES;
+	const char *samplesPath = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--iterations") == 0) && (i + 1 < argc)) iterations = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "--frames") == 0) && (i + 1 < argc)) frames = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "--samples") == 0) && (i + 1 < argc)) samplesPath = argv[++i];
+	}
+	if (iterations < 1) iterations = 1;
+	if (frames < 1) frames = 1;
+
+	// NOTE: No vsync, frame times measure rendering work only
+	SetTraceLogLevel(LOG_WARNING);
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(1280, 720, "rgltf benchmark");
+
+	printf("{\"bench\":\"info\",\"raylib\":\"%s\",\"iterations\":%d,\"frames\":%d}\n", RAYLIB_VERSION, iterations, frames);
+
+	BenchSyntheticScene("wide", SCENE_WIDE, frames);
+	BenchSyntheticScene("deep", SCENE_DEEP, frames);
+	BenchSyntheticScene("primitives", SCENE_PRIMITIVES, frames);
+
+	for (int i = 0; (samplesPath != NULL) && (i < (int)(sizeof(sampleModels)/sizeof(sampleModels[0]))); i++)
+	{
+		const char *fileName = TextFormat("%s/2.0/%s/glTF/%s.gltf", samplesPath, sampleModels[i], sampleModels[i]);
+		if (!FileExists(fileName))
+		{
+			printf("{\"bench\":\"load\",\"model\":\"%s\",\"error\":\"not found\"}\n", sampleModels[i]);
+			continue;
+		}
+
+		BenchLoad(sampleModels[i], fileName, iterations);
+
+		GLTFModel model = LoadGLTFModel(fileName);
+		BenchDraw(sampleModels[i], model, frames);
+		UnloadGLTFModel(model);
+	}
+
+	// Model files given in the command line
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--iterations") == 0) || (strcmp(argv[i], "--frames") == 0) || (strcmp(argv[i], "--samples") == 0))
+		{
+			i++;
+			continue;
+		}
+
+		BenchLoad(GetFileName(argv[i]), argv[i], iterations);
+
+		GLTFModel model = LoadGLTFModel(argv[i]);
+		BenchDraw(GetFileName(argv[i]), model, frames);
+		UnloadGLTFModel(model);
+	}
+
+	UnloadGLTFDrawQueue();
+	CloseWindow();
+
+	return 0;
+}
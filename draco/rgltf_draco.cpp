@@ -0,0 +1,96 @@
+/*
+ * rgltf
+ *
+ * Reference KHR_draco_mesh_compression decoder for rgltf, backed by the Draco library
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ */
+#include "rgltf_draco.h"
+#include <draco/compression/decode.h>
+
+#include <memory>
+
+// Decode a Draco attribute into count elements of components values
+template <typename T>
+static bool DecodeDracoAttribute(const draco::Mesh &mesh, int id, int components, T *dst)
+{
+	const draco::PointAttribute *attribute = (id >= 0)? mesh.GetAttributeByUniqueId(id) : nullptr;
+	if (attribute == nullptr) return false;
+
+	for (draco::PointIndex i(0); i < mesh.num_points(); ++i)
+	{
+		if (!attribute->ConvertValue<T>(attribute->mapped_index(i), components, dst + i.value()*components)) return false;
+	}
+
+	return true;
+}
+
+// Decode a Draco color attribute into u8 colors (float colors are normalized)
+static bool DecodeDracoColors(const draco::Mesh &mesh, int id, unsigned char *dst)
+{
+	const draco::PointAttribute *attribute = mesh.GetAttributeByUniqueId(id);
+	if (attribute == nullptr) return false;
+
+	// NOTE: Missing alpha component is set to opaque
+	int components = attribute->num_components();
+	if (components > 4) components = 4;
+
+	for (draco::PointIndex i(0); i < mesh.num_points(); ++i)
+	{
+		unsigned char *color = dst + i.value()*4;
+		color[3] = 255;
+
+		if (attribute->data_type() == draco::DT_FLOAT32)
+		{
+			float value[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+			if (!attribute->ConvertValue<float>(attribute->mapped_index(i), components, value)) return false;
+
+			for (int c = 0; c < components; c++) color[c] = (value[c] > 0.0f)? ((value[c] < 1.0f)? (unsigned char)(value[c]*255.0f) : 255) : 0;
+		}
+		else if (!attribute->ConvertValue<unsigned char>(attribute->mapped_index(i), components, color)) return false;
+	}
+
+	return true;
+}
+
+bool DecodeGLTFDracoPrimitive(const GLTFDracoPrimitive *primitive, Mesh *mesh, void *userData)
+{
+	(void)userData;
+
+	draco::DecoderBuffer buffer;
+	buffer.Init((const char *)primitive->data, (size_t)primitive->dataSize);
+
+	draco::Decoder decoder;
+	auto result = decoder.DecodeMeshFromBuffer(&buffer);
+	if (!result.ok()) return false;
+
+	std::unique_ptr<draco::Mesh> decoded = std::move(result).value();
+
+	// NOTE: Arrays are allocated by rgltf from the glTF accessors, decoded data must match them
+	if ((int)decoded->num_points() != mesh->vertexCount) return false;
+
+	if (!DecodeDracoAttribute<float>(*decoded, primitive->positionId, 3, mesh->vertices)) return false;
+	if ((mesh->normals != nullptr) && !DecodeDracoAttribute<float>(*decoded, primitive->normalId, 3, mesh->normals)) return false;
+	if ((mesh->tangents != nullptr) && !DecodeDracoAttribute<float>(*decoded, primitive->tangentId, 4, mesh->tangents)) return false;
+	if ((mesh->texcoords != nullptr) && !DecodeDracoAttribute<float>(*decoded, primitive->texcoordId, 2, mesh->texcoords)) return false;
+	if ((mesh->colors != nullptr) && !DecodeDracoColors(*decoded, primitive->colorId, mesh->colors)) return false;
+
+	if ((mesh->indices != nullptr) || (primitive->indices32 != nullptr))
+	{
+		if ((int)decoded->num_faces() != mesh->triangleCount) return false;
+
+		for (draco::FaceIndex f(0); f < decoded->num_faces(); ++f)
+		{
+			const draco::Mesh::Face &face = decoded->face(f);
+
+			for (int k = 0; k < 3; k++)
+			{
+				if (mesh->indices != nullptr) mesh->indices[f.value()*3 + k] = (unsigned short)face[k].value();
+				else primitive->indices32[f.value()*3 + k] = face[k].value();
+			}
+		}
+	}
+
+	return true;
+}
@@ -23,11 +23,37 @@
 #include "config.h"
 #include "rgltf.h"
 #include "cgltf.h"
+#include "rgltf_decode.h"
+#if defined(RGLTF_SUPPORT_MESHOPT)
+    #include "rgltf_meshopt.h"
+#endif
 #include <raymath.h>
 #include <rlgl.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Model files (.gltf/.glb/.bin) are memory-mapped instead of read into allocated memory, mesh arrays freed
+// once uploaded are uploaded from the mapped pages when possible, define RGLTF_NO_MMAP to always load them with LoadFileData()
+#if !defined(RGLTF_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+    #define RGLTF_SUPPORT_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Images and mesh primitives are decoded by a pool of worker threads, define RGLTF_NO_THREADS to decode them on the calling thread
+#if !defined(RGLTF_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+    #define RGLTF_SUPPORT_THREADS
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
 #define TRACELOG(level, ...) TraceLog(level, __VA_ARGS__)
 
 static Matrix TransformToMatrix(Transform transform) {
@@ -41,768 +67,6528 @@ static Matrix TransformToMatrix(Transform transform) {
 	return MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
 }
 
-static Image LoadImageFromCgltfImage(cgltf_image *cgltfImage, const char *texPath)
+// Empty bounding box, any box merged into it replaces it
+static BoundingBox EmptyBoundingBox(void)
 {
-	Image image = { 0 };
-
-	if (cgltfImage->uri != NULL)     // Check if image data is provided as a uri (base64 or path)
-	{
-		if ((strlen(cgltfImage->uri) > 5) &&
-			(cgltfImage->uri[0] == 'd') &&
-			(cgltfImage->uri[1] == 'a') &&
-			(cgltfImage->uri[2] == 't') &&
-			(cgltfImage->uri[3] == 'a') &&
-			(cgltfImage->uri[4] == ':'))     // Check if image is provided as base64 text data
-		{
-			// Data URI Format: data:<mediatype>;base64,<data>
-
-			// Find the comma
-			int i = 0;
-			while ((cgltfImage->uri[i] != ',') && (cgltfImage->uri[i] != 0)) i++;
+	BoundingBox box = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+	return box;
+}
 
-			if (cgltfImage->uri[i] == 0) TRACELOG(LOG_WARNING, "IMAGE: glTF data URI is not a valid image");
-			else
-			{
-				int base64Size = (int)strlen(cgltfImage->uri + i + 1);
-				int outSize = 3*(base64Size/4);         // TODO: Consider padding (-numberOfPaddingCharacters)
-				void *data = NULL;
+static BoundingBox MergeBoundingBoxes(BoundingBox a, BoundingBox b)
+{
+	BoundingBox box = { Vector3Min(a.min, b.min), Vector3Max(a.max, b.max) };
+	return box;
+}
 
-				cgltf_options options = { 0 };
-				cgltf_result result = cgltf_load_buffer_base64(&options, outSize, cgltfImage->uri + i + 1, &data);
+// Transform a bounding box, the result contains the transformed box
+static BoundingBox TransformBoundingBox(BoundingBox box, Matrix mat)
+{
+	if (box.min.x > box.max.x) return box;      // Empty box
 
-				if (result == cgltf_result_success)
-				{
-					image = LoadImageFromMemory(".png", (unsigned char *)data, outSize);
-					cgltf_free((cgltf_data*)data);
-				}
-			}
-		}
-		else     // Check if image is provided as image path
-		{
-			image = LoadImage(TextFormat("%s/%s", texPath, cgltfImage->uri));
-		}
-	}
-	else if (cgltfImage->buffer_view->buffer->data != NULL)    // Check if image is provided as data buffer
-	{
-		unsigned char *data = RL_MALLOC(cgltfImage->buffer_view->size);
-		int offset = (int)cgltfImage->buffer_view->offset;
-		int stride = (int)cgltfImage->buffer_view->stride? (int)cgltfImage->buffer_view->stride : 1;
+	Vector3 center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+	Vector3 extent = Vector3Scale(Vector3Subtract(box.max, box.min), 0.5f);
 
-		// Copy buffer data to memory for loading
-		for (unsigned int i = 0; i < cgltfImage->buffer_view->size; i++)
-		{
-			data[i] = ((unsigned char *)cgltfImage->buffer_view->buffer->data)[offset];
-			offset += stride;
-		}
+	center = Vector3Transform(center, mat);
+	Vector3 newExtent = {
+		fabsf(mat.m0)*extent.x + fabsf(mat.m4)*extent.y + fabsf(mat.m8)*extent.z,
+		fabsf(mat.m1)*extent.x + fabsf(mat.m5)*extent.y + fabsf(mat.m9)*extent.z,
+		fabsf(mat.m2)*extent.x + fabsf(mat.m6)*extent.y + fabsf(mat.m10)*extent.z
+	};
 
-		// Check mime_type for image: (cgltfImage->mime_type == "image/png")
-		// NOTE: Detected that some models define mime_type as "image\\/png"
-		if ((strcmp(cgltfImage->mime_type, "image\\/png") == 0) ||
-			(strcmp(cgltfImage->mime_type, "image/png") == 0)) image = LoadImageFromMemory(".png", data, (int)cgltfImage->buffer_view->size);
-		else if ((strcmp(cgltfImage->mime_type, "image\\/jpeg") == 0) ||
-				 (strcmp(cgltfImage->mime_type, "image/jpeg") == 0)) image = LoadImageFromMemory(".jpg", data, (int)cgltfImage->buffer_view->size);
-		else TRACELOG(LOG_WARNING, "MODEL: glTF image data MIME type not recognized", TextFormat("%s/%s", texPath, cgltfImage->uri));
+	BoundingBox result = { Vector3Subtract(center, newExtent), Vector3Add(center, newExtent) };
+	return result;
+}
 
-		RL_FREE(data);
-	}
+// Memory arena block, allocations are taken sequentially from its data (placed after the header)
+typedef struct GLTFArenaBlock {
+	struct GLTFArenaBlock *next;    // Previous (full) block
+	size_t size;                    // Data size
+	size_t used;                    // Data used
+	size_t last;                    // Offset of the last allocation, it can be grown in place
+} GLTFArenaBlock;
 
-	return image;
-}
+// Memory arena, chain of zero initialized blocks released at once
+struct GLTFArena {
+	GLTFArenaBlock *block;          // Current block
+	size_t blockSize;               // Minimum data size of new blocks
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_t *lock;          // Arrays allocation lock, only set while the arena is shared by worker threads
+#endif
+};
 
-// Macro to simplify attributes loading code
-#define LOAD_ATTRIBUTE(accesor, numComp, dataType, dstPtr) \
-    { \
-        int n = 0; \
-        dataType *buffer = (dataType *)accesor->buffer_view->buffer->data + accesor->buffer_view->offset/sizeof(dataType) + accesor->offset/sizeof(dataType); \
-        for (unsigned int k = 0; k < accesor->count; k++) \
-        {\
-            for (int l = 0; l < numComp; l++) \
-            {\
-                dstPtr[numComp*k + l] = buffer[n + l];\
-            }\
-            n += (int)(accesor->stride/sizeof(dataType));\
-        }\
-    }
+#define GLTF_ARENA_ALIGNMENT    16
+#define GLTF_ARENA_BLOCK_SIZE   (256*1024)      // Minimum arena block size
+#define GLTF_ARENA_HEADER_SIZE  ((sizeof(GLTFArenaBlock) + GLTF_ARENA_ALIGNMENT - 1) & ~(size_t)(GLTF_ARENA_ALIGNMENT - 1))
 
-static GLTFModel LoadGLTFModelFile(const char *fileName)
+static GLTFArena *LoadGLTFArena(size_t blockSize)
 {
-	GLTFModel model = { 0 };
-	int *mesh_id_starts = NULL;
-	int *mesh_id_ends = NULL;
+	GLTFArena *arena = RL_CALLOC(1, sizeof(GLTFArena));
+	arena->blockSize = (blockSize > GLTF_ARENA_BLOCK_SIZE)? blockSize : GLTF_ARENA_BLOCK_SIZE;
 
-	// glTF file loading
-	unsigned int dataSize = 0;
-	unsigned char *fileData = LoadFileData(fileName, &dataSize);
-
-	if (fileData == NULL) return model;
+	return arena;
+}
 
-	// glTF data loading
-	cgltf_options options = { 0 };
-	cgltf_data *data = NULL;
-	cgltf_result result = cgltf_parse(&options, fileData, dataSize, &data);
+static void UnloadGLTFArena(GLTFArena *arena)
+{
+	if (arena == NULL) return;
 
-	if (result == cgltf_result_success)
+	while (arena->block != NULL)
 	{
-		if (data->file_type == cgltf_file_type_glb) TRACELOG(LOG_INFO, "MODEL: [%s] Model basic data (glb) loaded successfully", fileName);
-		else if (data->file_type == cgltf_file_type_gltf) TRACELOG(LOG_INFO, "MODEL: [%s] Model basic data (glTF) loaded successfully", fileName);
-		else TRACELOG(LOG_WARNING, "MODEL: [%s] Model format not recognized", fileName);
+		GLTFArenaBlock *next = arena->block->next;
+		RL_FREE(arena->block);
+		arena->block = next;
+	}
 
-		TRACELOG(LOG_INFO, "    > Meshes count: %i", data->meshes_count);
-		TRACELOG(LOG_INFO, "    > Materials count: %i (+1 default)", data->materials_count);
-		TRACELOG(LOG_DEBUG, "    > Buffers count: %i", data->buffers_count);
-		TRACELOG(LOG_DEBUG, "    > Images count: %i", data->images_count);
-		TRACELOG(LOG_DEBUG, "    > Textures count: %i", data->textures_count);
-		TRACELOG(LOG_DEBUG, "    > Nodes count: %i", data->nodes_count);
-		TRACELOG(LOG_DEBUG, "    > Scenes count: %i", data->scenes_count);
+	RL_FREE(arena);
+}
 
-		// Force reading data buffers (fills buffer_view->buffer->data)
-		// NOTE: If an uri is defined to base64 data or external path, it's automatically loaded -> TODO: Verify this assumption
-		result = cgltf_load_buffers(&options, data, fileName);
-		if (result != cgltf_result_success) TRACELOG(LOG_INFO, "MODEL: [%s] Failed to load mesh/material buffers", fileName);
+// Allocate zero initialized arena memory, a new block is added if the current one is full
+// NOTE: Empty allocations take some memory too, so every allocation is inside its block
+static void *AllocGLTFArena(GLTFArena *arena, size_t size)
+{
+	size = (size > 0)? (size + GLTF_ARENA_ALIGNMENT - 1) & ~(size_t)(GLTF_ARENA_ALIGNMENT - 1) : GLTF_ARENA_ALIGNMENT;
 
-        for (int i=0;i<data->nodes_count;i++) {
-            TRACELOG(LOG_DEBUG, "node mesh %d %s", data->nodes[i].mesh, data->nodes[i].name);
-        }
+	GLTFArenaBlock *block = arena->block;
+	if ((block == NULL) || (block->size - block->used < size))
+	{
+		size_t blockSize = (size > arena->blockSize)? size : arena->blockSize;
+		block = RL_CALLOC(1, GLTF_ARENA_HEADER_SIZE + blockSize);
+		if (block == NULL) return NULL;
 
-		mesh_id_starts = RL_CALLOC(data->meshes_count,sizeof(int));
-		mesh_id_ends = RL_CALLOC(data->meshes_count,sizeof(int));
+		block->size = blockSize;
+		block->next = arena->block;
+		arena->block = block;
+	}
 
-		int primitivesCount = 0;
-		// NOTE: We will load every primitive in the glTF as a separate raylib mesh
-		for (unsigned int i = 0; i < data->meshes_count; i++) primitivesCount += (int)data->meshes[i].primitives_count;
+	block->last = block->used;
+	block->used += size;
 
-		// Load our pModel data: meshes and materials
-		model.meshCount = primitivesCount;
-		model.meshes = RL_CALLOC(model.meshCount, sizeof(Mesh));
-		for (int i = 0; i < model.meshCount; i++) model.meshes[i].vboId = (unsigned int*)RL_CALLOC(MAX_MESH_VERTEX_BUFFERS, sizeof(unsigned int));
+	return (unsigned char *)block + GLTF_ARENA_HEADER_SIZE + block->last;
+}
 
-		// NOTE: We keep an extra slot for default material, in case some mesh requires it
-		model.materialCount = (int)data->materials_count + 1;
-		model.materials = RL_CALLOC(model.materialCount, sizeof(Material));
-		model.materials[0] = LoadMaterialDefault();     // Load default material (index: 0)
+// Check if memory is allocated from arena
+static bool IsGLTFArenaMemory(const GLTFArena *arena, const void *ptr)
+{
+	for (const GLTFArenaBlock *block = (arena != NULL)? arena->block : NULL; block != NULL; block = block->next)
+	{
+		const unsigned char *data = (const unsigned char *)block + GLTF_ARENA_HEADER_SIZE;
+		if (((const unsigned char *)ptr >= data) && ((const unsigned char *)ptr < data + block->size)) return true;
+	}
 
-		// Load mesh-material indices, by default all meshes are mapped to material index: 0
-		model.meshMaterial = RL_CALLOC(model.meshCount, sizeof(int));
+	return false;
+}
 
-		// Load materials data
-		//----------------------------------------------------------------------------------------------------
-		for (unsigned int i = 0, j = 1; i < data->materials_count; i++, j++)
-		{
-			model.materials[j] = LoadMaterialDefault();
-			const char *texPath = GetDirectoryPath(fileName);
+// Lock arena arrays allocation, if the arena is shared by worker threads
+static void LockGLTFArena(GLTFArena *arena)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	if ((arena != NULL) && (arena->lock != NULL)) pthread_mutex_lock(arena->lock);
+#else
+	(void)arena;
+#endif
+}
 
-			// Check glTF material flow: PBR metallic/roughness flow
-			// NOTE: Alternatively, materials can follow PBR specular/glossiness flow
-			if (data->materials[i].has_pbr_metallic_roughness)
-			{
-				// Load base color texture (albedo)
-				if (data->materials[i].pbr_metallic_roughness.base_color_texture.texture)
-				{
-					Image imAlbedo = LoadImageFromCgltfImage(data->materials[i].pbr_metallic_roughness.base_color_texture.texture->image, texPath);
-					if (imAlbedo.data != NULL)
-					{
-						model.materials[j].maps[MATERIAL_MAP_ALBEDO].texture = LoadTextureFromImage(imAlbedo);
-						UnloadImage(imAlbedo);
-					}
-				}
-				// Load base color factor (tint)
-				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.r = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[0]*255);
-				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.g = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[1]*255);
-				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.b = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[2]*255);
-				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.a = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[3]*255);
+static void UnlockGLTFArena(GLTFArena *arena)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	if ((arena != NULL) && (arena->lock != NULL)) pthread_mutex_unlock(arena->lock);
+#else
+	(void)arena;
+#endif
+}
 
-				// Load metallic/roughness texture
-				if (data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture)
-				{
-					Image imMetallicRoughness = LoadImageFromCgltfImage(data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture->image, texPath);
-					if (imMetallicRoughness.data != NULL)
-					{
-						model.materials[j].maps[MATERIAL_MAP_ROUGHNESS].texture = LoadTextureFromImage(imMetallicRoughness);
-						UnloadImage(imMetallicRoughness);
-					}
+// Allocate zero initialized pModel array, from arena if provided (otherwise with RL_CALLOC())
+static void *AllocGLTFArray(GLTFArena *arena, size_t count, size_t size)
+{
+	if (arena == NULL) return RL_CALLOC(count, size);
 
-					// Load metallic/roughness material properties
-					float roughness = data->materials[i].pbr_metallic_roughness.roughness_factor;
-					model.materials[j].maps[MATERIAL_MAP_ROUGHNESS].value = roughness;
+	LockGLTFArena(arena);
+	void *result = AllocGLTFArena(arena, count*size);
+	UnlockGLTFArena(arena);
 
-					float metallic = data->materials[i].pbr_metallic_roughness.metallic_factor;
-					model.materials[j].maps[MATERIAL_MAP_METALNESS].value = metallic;
-				}
+	return result;
+}
 
-				// Load normal texture
-				if (data->materials[i].normal_texture.texture)
-				{
-					Image imNormal = LoadImageFromCgltfImage(data->materials[i].normal_texture.texture->image, texPath);
-					if (imNormal.data != NULL)
-					{
-						model.materials[j].maps[MATERIAL_MAP_NORMAL].texture = LoadTextureFromImage(imNormal);
-						UnloadImage(imNormal);
-					}
-				}
+// Resize pModel array, arena arrays are grown in place if they are the last allocation (otherwise copied)
+// NOTE: Unlike RL_REALLOC(), new array elements are zero initialized in arena arrays
+static void *ReallocGLTFArray(GLTFArena *arena, void *ptr, size_t oldSize, size_t size)
+{
+	if (arena == NULL) return RL_REALLOC(ptr, size);
 
-				// Load ambient occlusion texture
-				if (data->materials[i].occlusion_texture.texture)
-				{
-					Image imOcclusion = LoadImageFromCgltfImage(data->materials[i].occlusion_texture.texture->image, texPath);
-					if (imOcclusion.data != NULL)
-					{
-						model.materials[j].maps[MATERIAL_MAP_OCCLUSION].texture = LoadTextureFromImage(imOcclusion);
-						UnloadImage(imOcclusion);
-					}
-				}
+	LockGLTFArena(arena);
+	if ((ptr != NULL) && !IsGLTFArenaMemory(arena, ptr))
+	{
+		UnlockGLTFArena(arena);
+		return RL_REALLOC(ptr, size);
+	}
 
-				// Load emissive texture
-				if (data->materials[i].emissive_texture.texture)
-				{
-					Image imEmissive = LoadImageFromCgltfImage(data->materials[i].emissive_texture.texture->image, texPath);
-					if (imEmissive.data != NULL)
-					{
-						model.materials[j].maps[MATERIAL_MAP_EMISSION].texture = LoadTextureFromImage(imEmissive);
-						UnloadImage(imEmissive);
-					}
+	GLTFArenaBlock *block = arena->block;
+	size_t alignedSize = (size + GLTF_ARENA_ALIGNMENT - 1) & ~(size_t)(GLTF_ARENA_ALIGNMENT - 1);
+	if ((ptr != NULL) && (ptr == (unsigned char *)block + GLTF_ARENA_HEADER_SIZE + block->last) && (block->size - block->last >= alignedSize))
+	{
+		if (block->last + alignedSize > block->used) block->used = block->last + alignedSize;
+		if (size > oldSize) memset((unsigned char *)ptr + oldSize, 0, size - oldSize);
+		UnlockGLTFArena(arena);
+		return ptr;
+	}
 
-					// Load emissive color factor
-					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.r = (unsigned char)(data->materials[i].emissive_factor[0]*255);
-					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.g = (unsigned char)(data->materials[i].emissive_factor[1]*255);
-					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.b = (unsigned char)(data->materials[i].emissive_factor[2]*255);
-					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.a = 255;
-				}
-			}
+	void *result = AllocGLTFArena(arena, size);
+	UnlockGLTFArena(arena);
+	if ((result != NULL) && (ptr != NULL)) memcpy(result, ptr, (oldSize < size)? oldSize : size);
 
-			// Other possible materials not supported by raylib pipeline:
-			// has_clearcoat, has_transmission, has_volume, has_ior, has specular, has_sheen
-		}
+	return result;
+}
 
-        TRACELOG(LOG_DEBUG,"%x",data->meshes);
+// Free pModel array, arena arrays are released with their arena
+static void FreeGLTFArray(GLTFArena *arena, void *ptr)
+{
+	if (ptr == NULL) return;
 
-		// Load meshes data
-		//----------------------------------------------------------------------------------------------------
-		for (unsigned int i = 0, meshIndex = 0; i < data->meshes_count; i++)
-		{
-			// NOTE: meshIndex accumulates primitives
-			mesh_id_starts[i]=meshIndex;
-			for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
-			{
-				// NOTE: We only support primitives defined by triangles
-				// Other alternatives: points, lines, line_strip, triangle_strip
-				if (data->meshes[i].primitives[p].type != cgltf_primitive_type_triangles) continue;
+	LockGLTFArena(arena);
+	bool arenaMemory = IsGLTFArenaMemory(arena, ptr);
+	UnlockGLTFArena(arena);
 
-				// NOTE: Attributes data could be provided in several data formats (8, 8u, 16u, 32...),
-				// Only some formats for each attribute type are supported, read info at the top of this function!
+	if (!arenaMemory) RL_FREE(ptr);
+}
 
-				for (unsigned int j = 0; j < data->meshes[i].primitives[p].attributes_count; j++)
-				{
-					// Check the different attributes for every pimitive
-					if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_position)      // POSITION
-					{
-						cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-						// WARNING: SPECS: POSITION accessor MUST have its min and max properties defined.
-
-						if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec3))
-						{
-							// Init raylib mesh vertices to copy glTF attribute data
-							model.meshes[meshIndex].vertexCount = (int)attribute->count;
-							model.meshes[meshIndex].vertices = RL_MALLOC(attribute->count*3*sizeof(float));
-
-							// Load 3 components of float data type into mesh.vertices
-							LOAD_ATTRIBUTE(attribute, 3, float, model.meshes[meshIndex].vertices)
-						}
-						else TRACELOG(LOG_WARNING, "MODEL: [%s] Vertices attribute data format not supported, use vec3 float", fileName);
-					}
-					else if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_normal)   // NORMAL
-					{
-						cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-						if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec3))
-						{
-							// Init raylib mesh normals to copy glTF attribute data
-							model.meshes[meshIndex].normals = RL_MALLOC(attribute->count*3*sizeof(float));
-
-							// Load 3 components of float data type into mesh.normals
-							LOAD_ATTRIBUTE(attribute, 3, float, model.meshes[meshIndex].normals)
-						}
-						else TRACELOG(LOG_WARNING, "MODEL: [%s] Normal attribute data format not supported, use vec3 float", fileName);
-					}
-					else if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_tangent)   // TANGENT
-					{
-						cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-						if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec4))
-						{
-							// Init raylib mesh tangent to copy glTF attribute data
-							model.meshes[meshIndex].tangents = RL_MALLOC(attribute->count*4*sizeof(float));
-
-							// Load 4 components of float data type into mesh.tangents
-							LOAD_ATTRIBUTE(attribute, 4, float, model.meshes[meshIndex].tangents)
-						}
-						else TRACELOG(LOG_WARNING, "MODEL: [%s] Tangent attribute data format not supported, use vec4 float", fileName);
-					}
-					else if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_texcoord) // TEXCOORD_0
-					{
-						// TODO: Support additional texture coordinates: TEXCOORD_1 -> mesh.texcoords2
-
-						cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-						if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec2))
-						{
-							// Init raylib mesh texcoords to copy glTF attribute data
-							model.meshes[meshIndex].texcoords = RL_MALLOC(attribute->count*2*sizeof(float));
-
-							// Load 3 components of float data type into mesh.texcoords
-							LOAD_ATTRIBUTE(attribute, 2, float, model.meshes[meshIndex].texcoords)
-						}
-						else TRACELOG(LOG_WARNING, "MODEL: [%s] Texcoords attribute data format not supported, use vec2 float", fileName);
-					}
-					else if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_color)    // COLOR_0
-					{
-						cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-						// WARNING: SPECS: All components of each COLOR_n accessor element MUST be clamped to [0.0, 1.0] range.
-
-						if ((attribute->component_type == cgltf_component_type_r_8u) && (attribute->type == cgltf_type_vec4))
-						{
-							// Init raylib mesh color to copy glTF attribute data
-							model.meshes[meshIndex].colors = RL_MALLOC(attribute->count*4*sizeof(unsigned char));
-
-							// Load 4 components of unsigned char data type into mesh.colors
-							LOAD_ATTRIBUTE(attribute, 4, unsigned char, model.meshes[meshIndex].colors)
-						}
-						else if ((attribute->component_type == cgltf_component_type_r_16u) && (attribute->type == cgltf_type_vec4))
-						{
-							// Init raylib mesh color to copy glTF attribute data
-							model.meshes[meshIndex].colors = RL_MALLOC(attribute->count*4*sizeof(unsigned char));
-
-							// Load data into a temp buffer to be converted to raylib data type
-							unsigned short *temp = RL_MALLOC(attribute->count*4*sizeof(unsigned short));
-							LOAD_ATTRIBUTE(attribute, 4, unsigned short, temp);
-
-							// Convert data to raylib color data type (4 bytes)
-							for (int c = 0; c < attribute->count*4; c++) model.meshes[meshIndex].colors[c] = (unsigned char)(((float)temp[c]/65535.0f)*255.0f);
-
-							RL_FREE(temp);
-						}
-						else if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec4))
-						{
-							// Init raylib mesh color to copy glTF attribute data
-							model.meshes[meshIndex].colors = RL_MALLOC(attribute->count*4*sizeof(unsigned char));
-
-							// Load data into a temp buffer to be converted to raylib data type
-							float *temp = RL_MALLOC(attribute->count*4*sizeof(float));
-							LOAD_ATTRIBUTE(attribute, 4, float, temp);
-
-							// Convert data to raylib color data type (4 bytes), we expect the color data normalized
-							for (int c = 0; c < attribute->count*4; c++) model.meshes[meshIndex].colors[c] = (unsigned char)(temp[c]*255.0f);
-
-							RL_FREE(temp);
-						}
-						else TRACELOG(LOG_WARNING, "MODEL: [%s] Color attribute data format not supported", fileName);
-					}
-
-					// NOTE: Attributes related to animations are processed separately
-				}
+// Sort model nodes topologically (depth-first preorder), so every node is placed before its children
+// and every node subtree is a contiguous range [orderStart, orderEnd) of model.sortedNodes
+// NOTE: Temporary stack is allocated from scratch arena (if any), sorted nodes from pModel arena
+static void SortGLTFNodes(GLTFModel *model, GLTFArena *scratch)
+{
+	int stackSize = model->nodeCount;
+	for (int i = 0; i < model->nodeCount; i++) stackSize += model->nodes[i].childrenCount;
 
-				// Load primitive indices data (if provided)
-				if (data->meshes[i].primitives[p].indices != NULL)
-				{
-					cgltf_accessor *attribute = data->meshes[i].primitives[p].indices;
+	int *stack = AllocGLTFArray(scratch, stackSize, sizeof(int));
+	int sortedCount = 0;
 
-					model.meshes[meshIndex].triangleCount = (int)attribute->count/3;
+	model->sortedNodes = AllocGLTFArray(model->arena, model->nodeCount, sizeof(int));
 
-					if (attribute->component_type == cgltf_component_type_r_16u)
-					{
-						// Init raylib mesh indices to copy glTF attribute data
-						model.meshes[meshIndex].indices = RL_MALLOC(attribute->count*sizeof(unsigned short));
+	for (int i = 0; i < model->nodeCount; i++) {
+		model->nodes[i].parent = -1;
+		model->nodes[i].orderStart = -1;
+		model->nodes[i].orderEnd = -1;
+	}
+	for (int i = 0; i < model->nodeCount; i++) {
+		for (int j = 0; j < model->nodes[i].childrenCount; j++) model->nodes[model->nodes[i].children[j]].parent = i;
+	}
 
-						// Load unsigned short data type into mesh.indices
-						LOAD_ATTRIBUTE(attribute, 1, unsigned short, model.meshes[meshIndex].indices)
-					}
-					else if (attribute->component_type == cgltf_component_type_r_32u)
-					{
-						// Init raylib mesh indices to copy glTF attribute data
-						model.meshes[meshIndex].indices = RL_MALLOC(attribute->count*sizeof(unsigned short));
+	for (int i = 0; i < model->nodeCount; i++) {
+		if (model->nodes[i].parent != -1) continue;
 
-						// Load data into a temp buffer to be converted to raylib data type
-						unsigned int *temp = RL_MALLOC(attribute->count*sizeof(unsigned int));
-						LOAD_ATTRIBUTE(attribute, 1, unsigned int, temp);
+		int top = 0;
+		stack[top++] = i;
+		while (top > 0) {
+			int node_id = stack[--top];
+			if (model->nodes[node_id].orderStart != -1) continue;   // Invalid glTF: node with several parents
 
-						// Convert data to raylib indices data type (unsigned short)
-						for (int d = 0; d < attribute->count; d++) model.meshes[meshIndex].indices[d] = (unsigned short)temp[d];
+			model->nodes[node_id].orderStart = sortedCount;
+			model->sortedNodes[sortedCount++] = node_id;
 
-						TRACELOG(LOG_WARNING, "MODEL: [%s] Indices data converted from u32 to u16, possible loss of data", fileName);
+			// Push children reversed, so they are visited in the order they are declared
+			for (int j = model->nodes[node_id].childrenCount - 1; j >= 0; j--) stack[top++] = model->nodes[node_id].children[j];
+		}
+	}
 
-						RL_FREE(temp);
-					}
-					else TRACELOG(LOG_WARNING, "MODEL: [%s] Indices data format not supported, use u16", fileName);
-				}
-				else model.meshes[meshIndex].triangleCount = model.meshes[meshIndex].vertexCount/3;    // Unindexed mesh
+	// Invalid glTF: nodes not reachable from a root node (hierarchy cycles) are treated as roots
+	if (sortedCount < model->nodeCount) TRACELOG(LOG_WARNING, "MODEL: %i glTF nodes are not reachable from a root node", model->nodeCount - sortedCount);
+	for (int i = 0; i < model->nodeCount; i++) {
+		if (model->nodes[i].orderStart != -1) continue;
+		model->nodes[i].parent = -1;
+		model->nodes[i].orderStart = sortedCount;
+		model->sortedNodes[sortedCount++] = i;
+	}
 
-				// Assign to the primitive mesh the corresponding material index
-				// NOTE: If no material defined, mesh uses the already assigned default material (index: 0)
-				for (int m = 0; m < data->materials_count; m++)
-				{
-					// The primitive actually keeps the pointer to the corresponding material,
-					// raylib instead assigns to the mesh the by its index, as loaded in pModel.materials array
-					// To get the index, we check if material pointers match and we assign the corresponding index,
-					// skipping index 0, the default material
-					if (&data->materials[m] == data->meshes[i].primitives[p].material)
-					{
-						model.meshMaterial[meshIndex] = m + 1;
-						break;
-					}
-				}
-//				if (pModel.meshMaterial[meshIndex]<0 || pModel.meshMaterial[meshIndex]>=pModel.materialCount)
-//					pModel.meshMaterial[meshIndex] = 0;
+	// Children are placed after their parents, so walk backwards to propagate subtree ends upwards
+	for (int k = sortedCount - 1; k >= 0; k--) {
+		GLTFNode *node = &model->nodes[model->sortedNodes[k]];
+		if (node->orderEnd < k + 1) node->orderEnd = k + 1;
+		if (node->parent >= 0 && model->nodes[node->parent].orderEnd < node->orderEnd) model->nodes[node->parent].orderEnd = node->orderEnd;
+	}
 
-				meshIndex++;       // Move to next mesh
-			}
-			mesh_id_ends[i]=meshIndex;
-		}
-        TRACELOG(LOG_DEBUG,"%x", data->meshes);
+	FreeGLTFArray(scratch, stack);
+}
 
-		// Load node data
-		model.nodeCount = data->nodes_count;
-		model.nodes = RL_CALLOC(data->nodes_count, sizeof(GLTFModel));
-        TRACELOG(LOG_DEBUG,"Loading nodes %d", model.nodeCount);
-		memset(model.nodes,0,data->nodes_count * sizeof(GLTFModel));
-        TRACELOG(LOG_DEBUG,"-----------", model.nodeCount);
-		for (unsigned int i = 0; i < data->nodes_count; i++) {
-            if (data->nodes[i].mesh == NULL) {
-                model.nodes[i].meshStart = -1;
-                model.nodes[i].meshEnd = -1;
-            } else {
-                int mesh_id = (data->nodes[i].mesh - data->meshes);
-                TRACELOG(LOG_DEBUG, "Mesh: %x %x %d %d", data->nodes[i].mesh, data->meshes, mesh_id,
-                         data->meshes_count);
-                model.nodes[i].meshStart = mesh_id_starts[mesh_id];
-                model.nodes[i].meshEnd = mesh_id_ends[mesh_id];
-            }
+// Get the object of a JSON member in [json, end), i.e: "attributes":{"TRANSLATION":0}, returns its opening brace
+// and sets objectEnd after its closing brace (NULL: not found)
+// NOTE: Nested objects and strings are skipped, braces inside strings don't count
+static const char *GetGLTFJsonObject(const char *json, const char *end, const char *name, const char **objectEnd)
+{
+	char quotedName[64];
+	int nameLength = snprintf(quotedName, sizeof(quotedName), "\"%s\"", name);
 
-            model.nodes[i].childrenCount = data->nodes[i].children_count;
-            model.nodes[i].children = RL_CALLOC(model.nodes[i].childrenCount,sizeof(int));
-            for (unsigned  int j = 0; j < data->nodes[i].children_count; j++)
-                model.nodes[i].children[j]=data->nodes[i].children[j]-data->nodes;
-            Matrix matScale;
-			Matrix matRotation;
-			Matrix matTranslation;
+	const char *key = json;
+	while ((key + nameLength <= end) && (strncmp(key, quotedName, nameLength) != 0)) key++;
+	if (key + nameLength > end) return NULL;
 
-			if (data->nodes[i].has_translation) {
-				model.nodes[i].transform.translation.x = data->nodes[i].translation[0];
-				model.nodes[i].transform.translation.y = data->nodes[i].translation[1];
-				model.nodes[i].transform.translation.z = data->nodes[i].translation[2];
-				matTranslation = MatrixTranslate(model.nodes[i].transform.translation.x,
-												 model.nodes[i].transform.translation.y,
-												 model.nodes[i].transform.translation.z);
-			} else
-				matTranslation = MatrixIdentity();
-			if (data->nodes[i].has_rotation) {
-				model.nodes[i].transform.rotation.x = data->nodes[i].rotation[0];
-				model.nodes[i].transform.rotation.y = data->nodes[i].rotation[1];
-				model.nodes[i].transform.rotation.z = data->nodes[i].rotation[2];
-				model.nodes[i].transform.rotation.w = data->nodes[i].rotation[3];
-				matRotation = QuaternionToMatrix(model.nodes[i].transform.rotation);
-			} else
-				matRotation = MatrixIdentity();
+	const char *object = key + nameLength;
+	while ((object < end) && (*object != '{')) {
+		if ((*object != ':') && (*object != ' ') && (*object != '\t') && (*object != '\r') && (*object != '\n')) return NULL;
+		object++;
+	}
 
-			if (data->nodes[i].has_scale) {
-				model.nodes[i].transform.scale.x = data->nodes[i].scale[0];
-				model.nodes[i].transform.scale.y = data->nodes[i].scale[1];
-				model.nodes[i].transform.scale.z = data->nodes[i].scale[2];
-				matScale = MatrixScale(model.nodes[i].transform.scale.x,
-									   model.nodes[i].transform.scale.y,
-									   model.nodes[i].transform.scale.z);
-			} else {
-				model.nodes[i].transform.scale.x = 1;
-				model.nodes[i].transform.scale.y = 1;
-				model.nodes[i].transform.scale.z = 1;
-				matScale = MatrixIdentity();
-			}
-			model.nodes[i].transformMatrix = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+	int depth = 0;
+	bool string = false;
+	for (const char *c = object; c < end; c++) {
+		if (string) {
+			if (*c == '\\') c++;
+			else if (*c == '"') string = false;
 		}
-        TRACELOG(LOG_DEBUG,"Loading scene");
-
-		// Load scene data
-		if (data->scenes_count > 0) {
-			model.scene = (data->scene - data->scenes);
-			model.sceneCount = data->scenes_count;
-			model.scenes = RL_CALLOC(data->scenes_count, sizeof(GLTFScene));
-			memset(model.scenes, 0, sizeof(GLTFScene) * data->scenes_count);
-			for (unsigned int i = 0; i < data->scenes_count; i++) {
-				model.scenes[i].nodeCount = data->scenes[i].nodes_count;
-				model.scenes[i].nodes = RL_CALLOC(data->scenes[i].nodes_count, sizeof(int));
-				for (unsigned int j = 0; j < data->scenes[i].nodes_count; j++) {
-					model.scenes[i].nodes[j] = (data->scenes[i].nodes[j] - data->nodes);
-				}
-			}
+		else if (*c == '"') string = true;
+		else if (*c == '{') depth++;
+		else if ((*c == '}') && (--depth == 0)) {
+			*objectEnd = c + 1;
+			return object;
 		}
-
-/*
-        // TODO: Load glTF meshes animation data
-        // REF: https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#skins
-        // REF: https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#skinned-mesh-attributes
-        //----------------------------------------------------------------------------------------------------
-        for (unsigned int i = 0, meshIndex = 0; i < data->meshes_count; i++)
-        {
-            for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
-            {
-                // NOTE: We only support primitives defined by triangles
-                if (data->meshes[i].primitives[p].type != cgltf_primitive_type_triangles) continue;
-
-                for (unsigned int j = 0; j < data->meshes[i].primitives[p].attributes_count; j++)
-                {
-                    // NOTE: JOINTS_1 + WEIGHT_1 will be used for +4 joints influencing a vertex -> Not supported by raylib
-
-                    if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_joints)        // JOINTS_n (vec4: 4 bones max per vertex / u8, u16)
-                    {
-                        cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-                        if ((attribute->component_type == cgltf_component_type_r_8u) && (attribute->type == cgltf_type_vec4))
-                        {
-                            // Init raylib mesh bone ids to copy glTF attribute data
-                            pModel.meshes[meshIndex].boneIds = RL_CALLOC(pModel.meshes[meshIndex].vertexCount*4, sizeof(unsigned char));
-
-                            // Load 4 components of unsigned char data type into mesh.boneIds
-                            LOAD_ATTRIBUTE(attribute, 4, unsigned char, pModel.meshes[meshIndex].boneIds)
-                        }
-                        else TRACELOG(LOG_WARNING, "MODEL: [%s] Joint attribute data format not supported, use vec4 u8", fileName);
-                    }
-                    else if (data->meshes[i].primitives[p].attributes[j].type == cgltf_attribute_type_weights)  // WEIGHTS_n (vec4 / u8, u16, f32)
-                    {
-                        cgltf_accessor *attribute = data->meshes[i].primitives[p].attributes[j].data;
-
-                        if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec4))
-                        {
-                            // Init raylib mesh bone weight to copy glTF attribute data
-                            pModel.meshes[meshIndex].boneWeights = RL_CALLOC(pModel.meshes[meshIndex].vertexCount*4, sizeof(float));
-
-                            // Load 4 components of float data type into mesh.boneWeights
-                            LOAD_ATTRIBUTE(attribute, 4, float, pModel.meshes[meshIndex].boneWeights)
-                        }
-                        else TRACELOG(LOG_WARNING, "MODEL: [%s] Joint weight attribute data format not supported, use vec4 float", fileName);
-                    }
-                }
-
-                meshIndex++;       // Move to next mesh
-            }
-        }
-*/
-		RL_FREE(mesh_id_starts);
-		RL_FREE(mesh_id_ends);
-		// Free all cgltf loaded data
-		cgltf_free(data);
 	}
-	else TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to load glTF data", fileName);
+	return NULL;
+}
 
-	// WARNING: cgltf requires the file pointer available while reading data
-	UnloadFileData(fileData);
+// Get the accessor of an attribute in the EXT_mesh_gpu_instancing node extension data
+// NOTE: cgltf keeps the extension as raw JSON, i.e: {"attributes":{"TRANSLATION":0,"ROTATION":1}}, attributes are
+// only looked up in the "attributes" object
+static cgltf_accessor *GetInstancingAttribute(const cgltf_data *data, const char *json, const char *name)
+{
+	const char *end = NULL;
+	const char *attributes = GetGLTFJsonObject(json, json + strlen(json), "attributes", &end);
+	if (attributes == NULL) return NULL;
 
+	char quotedName[64];
+	int nameLength = snprintf(quotedName, sizeof(quotedName), "\"%s\"", name);
 
-	return model;
+	const char *key = attributes;
+	while ((key + nameLength <= end) && (strncmp(key, quotedName, nameLength) != 0)) key++;
+	if (key + nameLength > end) return NULL;
 
+	const char *value = key + nameLength;
+	while ((value < end) && ((*value == ' ') || (*value == '\t') || (*value == '\r') || (*value == '\n'))) value++;
+	if ((value >= end) || (*value != ':')) return NULL;
+
+	char *next = NULL;
+	long index = strtol(value + 1, &next, 10);
+	if ((next == value + 1) || (next > end)) return NULL;
+	if (index < 0 || index >= (long)data->accessors_count) return NULL;
+
+	return &data->accessors[index];
 }
 
-// Draw a pModel (with texture if set)
-void DrawGLTFModel(GLTFModel model, Vector3 position, float scale, Color tint)
+// Check an EXT_mesh_gpu_instancing accessor type, rotations can be stored as normalized integers
+static bool IsGLTFInstancingAccessorValid(const cgltf_accessor *accessor, cgltf_type type, bool normalized)
 {
-	Vector3 vScale = { scale, scale, scale };
-	Vector3 rotationAxis = { 0.0f, 1.0f, 0.0f };
+	if (accessor == NULL) return true;
+	if (accessor->type != type) return false;
+	if (accessor->component_type == cgltf_component_type_r_32f) return true;
 
-	DrawGLTFModelEx(model, position, rotationAxis, 0.0f, vScale, tint);
+	return normalized && accessor->normalized && ((accessor->component_type == cgltf_component_type_r_8) || (accessor->component_type == cgltf_component_type_r_16));
 }
 
-// Draw a pModel with extended parameters
-void DrawGLTFModelEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+// Load EXT_mesh_gpu_instancing instance transforms of a node
+// NOTE: Extension is skipped if its accessors don't have the same count or the expected types
+static void LoadGLTFNodeInstances(GLTFNode *node, const cgltf_data *data, const cgltf_node *cgltfNode, const char *fileName, GLTFArena *arena)
 {
-	// Calculate transformation matrix from function parameters
-	// Get transform matrix (rotation -> scale -> translation)
-	Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+	for (unsigned int i = 0; i < cgltfNode->extensions_count; i++) {
+		if (strcmp(cgltfNode->extensions[i].name, "EXT_mesh_gpu_instancing") != 0 || cgltfNode->extensions[i].data == NULL) continue;
+
+		cgltf_accessor *translation = GetInstancingAttribute(data, cgltfNode->extensions[i].data, "TRANSLATION");
+		cgltf_accessor *rotation = GetInstancingAttribute(data, cgltfNode->extensions[i].data, "ROTATION");
+		cgltf_accessor *scale = GetInstancingAttribute(data, cgltfNode->extensions[i].data, "SCALE");
+
+		cgltf_size count = 0;
+		if (translation != NULL) count = translation->count;
+		else if (rotation != NULL) count = rotation->count;
+		else if (scale != NULL) count = scale->count;
+		if (count == 0) return;
+
+		// NOTE: cgltf_accessor_read_float() doesn't check the element index, every accessor is read up to count
+		if (((rotation != NULL) && (rotation->count != count)) || ((scale != NULL) && (scale->count != count)) ||
+			!IsGLTFInstancingAccessorValid(translation, cgltf_type_vec3, false) || !IsGLTFInstancingAccessorValid(rotation, cgltf_type_vec4, true) ||
+			!IsGLTFInstancingAccessorValid(scale, cgltf_type_vec3, false) || (count > INT_MAX))
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] Node EXT_mesh_gpu_instancing attributes not valid, instancing skipped", fileName);
+			return;
+		}
+
+		node->instanceCount = (int)count;
+		node->instanceTransforms = AllocGLTFArray(arena, count, sizeof(Matrix));
+
+		for (int k = 0; k < node->instanceCount; k++) {
+			Transform transform = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } };
+			// NOTE: Accessors are read through cgltf, rotations can be stored as normalized integers
+			if (translation != NULL) cgltf_accessor_read_float(translation, k, &transform.translation.x, 3);
+			if (rotation != NULL) cgltf_accessor_read_float(rotation, k, &transform.rotation.x, 4);
+			if (scale != NULL) cgltf_accessor_read_float(scale, k, &transform.scale.x, 3);
+			node->instanceTransforms[k] = TransformToMatrix(transform);
+		}
+		return;
+	}
+}
+
+#define GLTF_MAX_LOD_LEVELS     8       // Maximum number of MSFT_lod lower levels of a node or material
+
+// Read the numbers array of a JSON member in [json, end), i.e: "ids":[2,3] or "MSFT_screencoverage":[0.5,0.2,0.01]
+// NOTE: cgltf keeps extensions as raw JSON strings and extras as offsets into the glTF JSON (not null-terminated in .glb)
+static int GetGLTFJsonNumbers(const char *json, const char *end, const char *name, float *values, int maxCount)
+{
+	char quotedName[64];
+	int nameLength = snprintf(quotedName, sizeof(quotedName), "\"%s\"", name);
+
+	const char *key = json;
+	while ((key + nameLength <= end) && (strncmp(key, quotedName, nameLength) != 0)) key++;
+	if (key + nameLength > end) return 0;
+
+	const char *value = key + nameLength;
+	while ((value < end) && (*value != '[')) {
+		if ((*value != ':') && (*value != ' ') && (*value != '\t') && (*value != '\r') && (*value != '\n')) return 0;
+		value++;
+	}
+
+	int count = 0;
+	while ((value < end) && (count < maxCount)) {
+		char *next = NULL;
+		float number = strtof(value + 1, &next);
+		if ((next == value + 1) || (next > end)) break;
+		values[count++] = number;
+
+		value = next;
+		while ((value < end) && ((*value == ' ') || (*value == '\t') || (*value == '\r') || (*value == '\n'))) value++;
+		if ((value >= end) || (*value != ',')) break;
+	}
+	return count;
+}
+
+// Get MSFT_lod lower levels ids of a node or material, returns the number of levels
+static int GetGLTFLodIds(const cgltf_extension *extensions, cgltf_size extensionCount, float *ids)
+{
+	for (unsigned int i = 0; i < extensionCount; i++) {
+		if (strcmp(extensions[i].name, "MSFT_lod") != 0 || extensions[i].data == NULL) continue;
+		return GetGLTFJsonNumbers(extensions[i].data, extensions[i].data + strlen(extensions[i].data), "ids", ids, GLTF_MAX_LOD_LEVELS);
+	}
+	return 0;
+}
+
+// Load MSFT_lod lower levels of every material, glTF material ids are converted to pModel material ids (+1)
+static void LoadGLTFMaterialLods(GLTFModel *model, const cgltf_data *data, GLTFArena *arena)
+{
+	float ids[GLTF_MAX_LOD_LEVELS];
+	int lodCount = 0;
+	for (unsigned int i = 0; i < data->materials_count; i++) lodCount += GetGLTFLodIds(data->materials[i].extensions, data->materials[i].extensions_count, ids);
+	if (lodCount == 0) return;
+
+	model->materialLodStart = AllocGLTFArray(arena, model->materialCount + 1, sizeof(int));
+	model->materialLods = AllocGLTFArray(arena, lodCount, sizeof(int));
+
+	int count = 0;
+	model->materialLodStart[0] = 0;     // Default material has no levels of detail
+	for (unsigned int i = 0; i < data->materials_count; i++) {
+		model->materialLodStart[i + 1] = count;
+		int levels = GetGLTFLodIds(data->materials[i].extensions, data->materials[i].extensions_count, ids);
+		for (int k = 0; k < levels; k++) {
+			int lod = (int)ids[k];
+			model->materialLods[count++] = ((lod >= 0) && (lod < (int)data->materials_count))? lod + 1 : (int)i + 1;
+		}
+	}
+	model->materialLodStart[model->materialCount] = count;
+}
+
+// Load MSFT_lod levels of a node: node alternatives, or the node itself drawn with its materials lower levels
+// NOTE: Levels screen coverages are read from the node extras (MSFT_screencoverage), missing ones are a quarter
+// of the previous level coverage (0.2 for level 0) and the last level is always drawn
+static void LoadGLTFNodeLods(GLTFNode *node, const GLTFModel *model, const cgltf_data *data, const cgltf_node *cgltfNode, GLTFArena *arena)
+{
+	float ids[GLTF_MAX_LOD_LEVELS];
+	int nodeLevels = GetGLTFLodIds(cgltfNode->extensions, cgltfNode->extensions_count, ids);
+
+	int lodCount = nodeLevels;
+	for (int j = node->meshStart; (model->materialLodStart != NULL) && (j < node->meshEnd); j++) {
+		int m = model->meshMaterial[j];
+		int levels = model->materialLodStart[m + 1] - model->materialLodStart[m];
+		if (levels > lodCount) lodCount = levels;
+	}
+	if (lodCount == 0) return;
+
+	node->lodCount = lodCount;
+	node->lodNodes = AllocGLTFArray(arena, lodCount, sizeof(int));
+	node->lodCoverage = AllocGLTFArray(arena, lodCount + 1, sizeof(float));
+
+	int self = (int)(cgltfNode - data->nodes);
+	for (int i = 0; i < lodCount; i++) {
+		int lod = (i < nodeLevels)? (int)ids[i] : -1;
+		node->lodNodes[i] = ((lod >= 0) && (lod < (int)data->nodes_count) && (lod != self))? lod : -1;
+	}
+
+	float coverage[GLTF_MAX_LOD_LEVELS + 1];
+	int coverageCount = 0;
+	const cgltf_extras *extras = &cgltfNode->extras;
+	if ((data->json != NULL) && (extras->end_offset > extras->start_offset) && (extras->end_offset <= data->json_size))
+		coverageCount = GetGLTFJsonNumbers(data->json + extras->start_offset, data->json + extras->end_offset, "MSFT_screencoverage", coverage, lodCount + 1);
+
+	for (int i = 0; i <= lodCount; i++) {
+		if (i < coverageCount) node->lodCoverage[i] = coverage[i];
+		else if (i == lodCount) node->lodCoverage[i] = 0.0f;
+		else node->lodCoverage[i] = (i == 0)? 0.2f : node->lodCoverage[i - 1]/4.0f;
+	}
+}
+
+// cgltf memory callbacks, so cgltf allocations can be released with RL_FREE()
+static void *AllocGLTFMemory(void *user, cgltf_size size)
+{
+	(void)user;
+	return RL_MALLOC(size);
+}
+
+static void FreeGLTFMemory(void *user, void *ptr)
+{
+	(void)user;
+	RL_FREE(ptr);
+}
+
+#define GLTF_HASH_SEED              0xcbf29ce484222325ULL   // FNV-1a 64-bit offset basis
+#define GLTF_HASH_PRIME             0x100000001b3ULL        // FNV-1a 64-bit prime
+
+// Hash data (FNV-1a, 8 bytes at a time with an extra mix), continuing from a previous hash
+static uint64_t GetGLTFHash(const unsigned char *data, size_t size, uint64_t hash)
+{
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word = 0;
+		memcpy(&word, data + i, 8);
+		hash = (hash ^ word)*GLTF_HASH_PRIME;
+		hash ^= hash >> 29;
+	}
+	for (; i < size; i++) hash = (hash ^ data[i])*GLTF_HASH_PRIME;
+
+	return hash;
+}
+
+// Asset cache resource types
+typedef enum {
+	GLTF_ASSET_TEXTURE = 0,
+	GLTF_ASSET_MATERIAL,
+	GLTF_ASSET_SHADER
+} GLTFAssetType;
+
+// Asset cache resource, shared by its users until the last one releases it
+typedef struct GLTFAsset {
+	int type;                   // Resource type (GLTFAssetType)
+	uint64_t key;               // Texture image uri or content hash, material content hash, shader files hash
+	int refCount;               // Number of users (models, LoadGLTFAssetShader() calls)
+	Texture2D texture;
+	Material material;          // Material maps are owned by the cache
+	Shader shader;
+} GLTFAsset;
+
+struct GLTFAssetCache {
+	GLTFAsset *assets;
+	int assetCount;
+	int assetCapacity;
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_t lock;       // Textures are acquired by asynchronous loading threads too
+#endif
+};
+
+static void LockGLTFAssetCache(GLTFAssetCache *cache)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_lock(&cache->lock);
+#else
+	(void)cache;
+#endif
+}
+
+static void UnlockGLTFAssetCache(GLTFAssetCache *cache)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_unlock(&cache->lock);
+#else
+	(void)cache;
+#endif
+}
+
+// Get asset cache key of some data, continuing from a seed (0 is never returned, it means no key)
+static uint64_t GetGLTFAssetKey(const void *data, size_t size, uint64_t seed)
+{
+	uint64_t key = GetGLTFHash((const unsigned char *)data, size, seed);
+
+	return (key != 0)? key : 1;
+}
+
+// Acquire cached asset of asset->type and asset->key (copied to asset), returns false if not cached
+static bool AcquireGLTFAsset(GLTFAssetCache *cache, GLTFAsset *asset)
+{
+	bool found = false;
+
+	LockGLTFAssetCache(cache);
+	for (int i = 0; i < cache->assetCount; i++)
+	{
+		if ((cache->assets[i].type == asset->type) && (cache->assets[i].key == asset->key))
+		{
+			cache->assets[i].refCount++;
+			*asset = cache->assets[i];
+			found = true;
+			break;
+		}
+	}
+	UnlockGLTFAssetCache(cache);
+
+	return found;
+}
+
+// Add asset to cache, used by its first user
+static void AddGLTFAsset(GLTFAssetCache *cache, GLTFAsset asset)
+{
+	asset.refCount = 1;
+
+	LockGLTFAssetCache(cache);
+	if (cache->assetCount == cache->assetCapacity)
+	{
+		cache->assetCapacity = (cache->assetCapacity > 0)? cache->assetCapacity*2 : 64;
+		cache->assets = RL_REALLOC(cache->assets, cache->assetCapacity*sizeof(GLTFAsset));
+	}
+	cache->assets[cache->assetCount++] = asset;
+	UnlockGLTFAssetCache(cache);
+}
+
+// Unload asset GPU resource (or material maps)
+static void UnloadGLTFAsset(GLTFAsset asset)
+{
+	if (asset.type == GLTF_ASSET_TEXTURE) UnloadTexture(asset.texture);
+	else if (asset.type == GLTF_ASSET_MATERIAL) RL_FREE(asset.material.maps);
+	else if (asset.type == GLTF_ASSET_SHADER) UnloadShader(asset.shader);
+}
+
+// Release cached asset of a texture or shader id (or material maps), it's unloaded by its last user
+// NOTE: Returns false if the resource is not cached, the caller is responsible for unloading it
+static bool ReleaseGLTFAsset(GLTFAssetCache *cache, int type, unsigned int id, const MaterialMap *maps)
+{
+	GLTFAsset released = { 0 };
+	bool found = false;
+	bool unload = false;
+
+	LockGLTFAssetCache(cache);
+	for (int i = 0; i < cache->assetCount; i++)
+	{
+		const GLTFAsset *asset = &cache->assets[i];
+		if (asset->type != type) continue;
+
+		if (((type == GLTF_ASSET_TEXTURE) && (asset->texture.id == id)) ||
+			((type == GLTF_ASSET_SHADER) && (asset->shader.id == id)) ||
+			((type == GLTF_ASSET_MATERIAL) && (asset->material.maps == maps)))
+		{
+			found = true;
+			if (--cache->assets[i].refCount == 0)
+			{
+				released = cache->assets[i];
+				cache->assets[i] = cache->assets[--cache->assetCount];
+				unload = true;
+			}
+			break;
+		}
+	}
+	UnlockGLTFAssetCache(cache);
+
+	// NOTE: GPU resources are unloaded out of the lock, by the calling (GL) thread
+	if (unload) UnloadGLTFAsset(released);
+
+	return found;
+}
+
+// Image to be decoded (by a worker thread)
+typedef struct GLTFImageJob {
+	bool requested;             // Image used by some material (encoded data already requested)
+	bool loaded;                // Encoded data loaded and decoded (or failed to), image is empty on failure
+	const unsigned char *fileData;  // Encoded image data (NULL if no image)
+	int fileSize;               // Encoded image data size
+	const char *fileType;       // Encoded image file type (extension)
+	bool loadedFile;            // Encoded data loaded through cgltf file callbacks (otherwise allocated with RL_MALLOC())
+	bool bufferData;            // Encoded data points into a glTF buffer, owned by cgltf data (not released)
+	bool transcode;             // Encoded data is a KTX2 (KHR_texture_basisu) image to be transcoded
+	Image image;                // Decoded image
+	uint64_t key;               // Asset cache key: image file path or encoded data hash (0: not shared)
+	Texture2D texture;          // Texture shared from the asset cache, the image is not decoded
+} GLTFImageJob;
+
+typedef struct GLTFImageQueue {
+	GLTFImageJob *jobs;
+	int jobCount;
+	int nextJob;                // Next job to be taken by a worker
+	const GLTFLoadOptions *options;     // Load options (KTX2 images transcoding callback)
+	int textureFormat;          // Pixel format of transcoded images
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_t lock;
+#endif
+} GLTFImageQueue;
+
+// Get path of an external resource: uri relative to the directory of gltfPath (as cgltf does for buffers)
+// NOTE: Returned path must be freed with RL_FREE(), it doesn't use shared buffers so it can be called from any thread
+static char *GetGLTFResourcePath(const char *gltfPath, const char *uri)
+{
+	const char *slash = strrchr(gltfPath, '/');
+	const char *backslash = strrchr(gltfPath, '\\');
+	if ((slash == NULL) || ((backslash != NULL) && (backslash > slash))) slash = backslash;
+
+	size_t dirLength = (slash != NULL)? (size_t)(slash - gltfPath + 1) : 0;
+	size_t uriLength = strlen(uri);
+	char *path = RL_MALLOC(dirLength + uriLength + 1);
+
+	memcpy(path, gltfPath, dirLength);
+	memcpy(path + dirLength, uri, uriLength + 1);
+	cgltf_decode_uri(path + dirLength);
+
+	return path;
+}
+
+// Get base64 data of a data uri (data:<mediatype>;base64,<data>), NULL if uri is not base64 data
+static const char *GetGLTFDataUriPayload(const char *uri)
+{
+	const char *comma = strchr(uri, ',');
+	if ((comma == NULL) || (comma - uri < 7) || (strncmp(comma - 7, ";base64", 7) != 0)) return NULL;
+
+	return comma + 1;
+}
+
+// Decode base64 data uri buffers, sized by the buffer byteLength so the text doesn't need to be measured
+// NOTE: Decoded buffers are released by cgltf_free() and skipped by cgltf_load_buffers()
+static bool LoadGLTFBase64Buffers(const cgltf_options *options, cgltf_data *data, const char *fileName)
+{
+	for (unsigned int i = 0; i < data->buffers_count; i++)
+	{
+		cgltf_buffer *buffer = &data->buffers[i];
+		if ((buffer->data != NULL) || (buffer->uri == NULL) || (strncmp(buffer->uri, "data:", 5) != 0)) continue;
+
+		const char *base64 = GetGLTFDataUriPayload(buffer->uri);
+		unsigned char *bufferData = ((base64 != NULL) && (buffer->size > 0))? options->memory.alloc(options->memory.user_data, buffer->size) : NULL;
+
+		if ((bufferData == NULL) || !DecodeBase64(bufferData, buffer->size, base64))
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] glTF buffer %i data URI is not valid base64 data", fileName, i);
+			if (bufferData != NULL) options->memory.free(options->memory.user_data, bufferData);
+			return false;
+		}
+
+		buffer->data = bufferData;
+		buffer->data_free_method = cgltf_data_free_method_memory_free;
+	}
+
+	return true;
+}
+
+// Load encoded image data from glTF image (data uri, buffer view or external file)
+// NOTE: External files are loaded through cgltf file callbacks, relative to the directory of gltfPath
+static void LoadGLTFImageJob(GLTFImageJob *job, const cgltf_data *cgltfData, const cgltf_image *cgltfImage, const char *gltfPath)
+{
+	if (cgltfImage->uri != NULL)     // Check if image data is provided as a uri (base64 or path)
+	{
+		if (strncmp(cgltfImage->uri, "data:", 5) == 0)     // Check if image is provided as base64 text data
+		{
+			const char *base64 = GetGLTFDataUriPayload(cgltfImage->uri);
+			size_t base64Size = (base64 != NULL)? strlen(base64) : 0;
+			size_t outSize = (base64 != NULL)? GetBase64DecodedSize(base64, base64Size) : 0;
+			unsigned char *data = (outSize > 0)? RL_MALLOC(outSize) : NULL;
+
+			if ((data != NULL) && DecodeBase64(data, outSize, base64))
+			{
+				// NOTE: Data uri media type is checked like buffer view images mime_type, PNG if not recognized
+				const char *mediaType = cgltfImage->uri + 5;
+				job->fileData = data;
+				job->fileSize = (int)outSize;
+				if (strncmp(mediaType, "image/jpeg", 10) == 0) job->fileType = ".jpg";
+				else if (strncmp(mediaType, "image/ktx2", 10) == 0) job->fileType = ".ktx2";
+				else job->fileType = ".png";
+				job->transcode = (strcmp(job->fileType, ".ktx2") == 0);
+			}
+			else
+			{
+				TRACELOG(LOG_WARNING, "IMAGE: glTF data URI is not a valid image");
+				RL_FREE(data);
+			}
+		}
+		else     // Check if image is provided as image path
+		{
+			char *path = GetGLTFResourcePath(gltfPath, cgltfImage->uri);
+
+			cgltf_size fileSize = 0;
+			void *fileData = NULL;
+
+			if (cgltfData->file.read(&cgltfData->memory, &cgltfData->file, path, &fileSize, &fileData) == cgltf_result_success)
+			{
+				job->fileData = (unsigned char *)fileData;
+				job->fileSize = (int)fileSize;
+				job->fileType = GetFileExtension(cgltfImage->uri);
+				job->loadedFile = true;
+				job->transcode = (job->fileType != NULL) && ((strcmp(job->fileType, ".ktx2") == 0) || (strcmp(job->fileType, ".KTX2") == 0));
+			}
+
+			RL_FREE(path);
+		}
+	}
+	else if ((cgltfImage->buffer_view != NULL) && ((cgltfImage->buffer_view->data != NULL) || (cgltfImage->buffer_view->buffer->data != NULL)))    // Check if image is provided as data buffer
+	{
+		// NOTE: Image is decoded in place from buffer data, it stays valid until cgltf_free()
+		// Image buffer views are tightly packed (byteStride only applies to vertex attributes)
+		const cgltf_buffer_view *view = cgltfImage->buffer_view;
+		const unsigned char *data = (view->data != NULL)? (const unsigned char *)view->data : (const unsigned char *)view->buffer->data + view->offset;
+
+		// Check mime_type for image: (cgltfImage->mime_type == "image/png")
+		// NOTE: Detected that some models define mime_type as "image\\/png"
+		const char *mimeType = (cgltfImage->mime_type != NULL)? cgltfImage->mime_type : "";
+		const char *fileType = NULL;
+		if ((strcmp(mimeType, "image\\/png") == 0) ||
+			(strcmp(mimeType, "image/png") == 0)) fileType = ".png";
+		else if ((strcmp(mimeType, "image\\/jpeg") == 0) ||
+				 (strcmp(mimeType, "image/jpeg") == 0)) fileType = ".jpg";
+		else if ((strcmp(mimeType, "image\\/ktx2") == 0) ||
+				 (strcmp(mimeType, "image/ktx2") == 0)) fileType = ".ktx2";
+		else TRACELOG(LOG_WARNING, "MODEL: glTF image data MIME type not recognized: %s", mimeType);
+
+		if (fileType != NULL)
+		{
+			job->fileData = data;
+			job->fileSize = (int)view->size;
+			job->fileType = fileType;
+			job->bufferData = true;
+			job->transcode = (strcmp(fileType, ".ktx2") == 0);
+		}
+	}
+}
+
+// Get image of a material texture, KHR_texture_basisu (KTX2) image is used if it can be transcoded
+// NOTE: Otherwise the texture image is the fallback (PNG/JPEG) image, if any, also used if the KTX2 image failed
+static const cgltf_image *GetGLTFTextureImage(const GLTFImageJob *jobs, const cgltf_data *cgltfData, const cgltf_texture *texture, bool transcode)
+{
+	if (texture == NULL) return NULL;
+	if (transcode && texture->has_basisu && (texture->basisu_image != NULL))
+	{
+		const GLTFImageJob *job = &jobs[texture->basisu_image - cgltfData->images];
+		bool failed = job->loaded && (job->image.data == NULL) && (job->texture.id == 0);
+		if (!failed || (texture->image == NULL)) return texture->basisu_image;
+	}
+
+	return texture->image;
+}
+
+// Request the image of a material texture, every requested image is loaded once (LoadGLTFImageJob())
+// NOTE: Returns 1 if the image was already requested by another texture (0 otherwise), to count shared images
+static int RequestGLTFImage(GLTFImageJob *jobs, const cgltf_data *cgltfData, const cgltf_texture *texture, bool transcode)
+{
+	const cgltf_image *image = GetGLTFTextureImage(jobs, cgltfData, texture, transcode);
+
+	if ((image == NULL) && (texture != NULL) && texture->has_basisu) TRACELOG(LOG_WARNING, "MODEL: KHR_texture_basisu image requires a transcoder (GLTFLoadOptions.transcodeImage)");
+	if (image == NULL) return 0;
+
+	GLTFImageJob *job = &jobs[image - cgltfData->images];
+	if (job->requested) return 1;
+
+	job->requested = true;
+
+	return 0;
+}
+
+// Request the images of every material texture, returns the number of images shared by several textures
+static int RequestGLTFMaterialImages(GLTFImageJob *jobs, const cgltf_data *cgltfData, bool transcode)
+{
+	int duplicatedImages = 0;
+	for (unsigned int i = 0; i < cgltfData->materials_count; i++)
+	{
+		const cgltf_material *material = &cgltfData->materials[i];
+		if (!material->has_pbr_metallic_roughness) continue;
+
+		duplicatedImages += RequestGLTFImage(jobs, cgltfData, material->pbr_metallic_roughness.base_color_texture.texture, transcode);
+		duplicatedImages += RequestGLTFImage(jobs, cgltfData, material->pbr_metallic_roughness.metallic_roughness_texture.texture, transcode);
+		duplicatedImages += RequestGLTFImage(jobs, cgltfData, material->normal_texture.texture, transcode);
+		duplicatedImages += RequestGLTFImage(jobs, cgltfData, material->occlusion_texture.texture, transcode);
+		duplicatedImages += RequestGLTFImage(jobs, cgltfData, material->emissive_texture.texture, transcode);
+	}
+
+	return duplicatedImages;
+}
+
+// Get image index of a material texture (-1 if no image)
+static int GetGLTFImageIndex(const GLTFImageJob *jobs, const cgltf_data *cgltfData, const cgltf_texture *texture, bool transcode)
+{
+	const cgltf_image *image = GetGLTFTextureImage(jobs, cgltfData, texture, transcode);
+	if (image == NULL) return -1;
+
+	return (int)(image - cgltfData->images);
+}
+
+// Get best compressed pixel format supported by the GPU for transcoded images (uncompressed RGBA if none)
+// NOTE: It only reads the extensions supported by rlgl, it can be called from any thread once the window is initialized
+static int GetGLTFTranscodeFormat(void)
+{
+	const int formats[] = { PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA, PIXELFORMAT_COMPRESSED_DXT5_RGBA, PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA };
+
+	for (int i = 0; i < (int)(sizeof(formats)/sizeof(formats[0])); i++)
+	{
+		int glInternalFormat = -1, glFormat = -1, glType = -1;
+		rlGetGlTextureFormats(formats[i], &glInternalFormat, &glFormat, &glType);
+		if ((glInternalFormat != -1) && (glInternalFormat != 0)) return formats[i];
+	}
+
+	return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+}
+
+// Release encoded image data
+static void UnloadGLTFImageJob(GLTFImageJob *job, const cgltf_data *cgltfData)
+{
+	if (job->fileData == NULL) return;
+
+	if (job->loadedFile) cgltfData->file.release(&cgltfData->memory, &cgltfData->file, (void *)job->fileData);
+	else if (!job->bufferData) RL_FREE((void *)job->fileData);
+
+	job->fileData = NULL;
+}
+
+// Load encoded image data, unless its texture is already in the asset cache (shared instead of decoded again)
+// NOTE: Image files are keyed by path (checked before reading them), embedded images by their encoded data
+static void LoadGLTFAssetImageJob(GLTFImageJob *job, const cgltf_data *cgltfData, const cgltf_image *cgltfImage, const char *gltfPath, GLTFAssetCache *cache, uint64_t seed)
+{
+	GLTFAsset asset = { 0 };
+	asset.type = GLTF_ASSET_TEXTURE;
+
+	bool file = (cgltfImage->uri != NULL) && (strncmp(cgltfImage->uri, "data:", 5) != 0);
+	if (file)
+	{
+		char *path = GetGLTFResourcePath(gltfPath, cgltfImage->uri);
+		job->key = asset.key = GetGLTFAssetKey(path, strlen(path), seed);
+		RL_FREE(path);
+
+		if (AcquireGLTFAsset(cache, &asset))
+		{
+			job->texture = asset.texture;
+			return;
+		}
+	}
+
+	LoadGLTFImageJob(job, cgltfData, cgltfImage, gltfPath);
+
+	if (!file && (job->fileData != NULL))
+	{
+		job->key = asset.key = GetGLTFAssetKey(job->fileData, job->fileSize, seed);
+
+		if (AcquireGLTFAsset(cache, &asset))
+		{
+			job->texture = asset.texture;
+			UnloadGLTFImageJob(job, cgltfData);
+		}
+	}
+}
+
+// Run worker on threadCount threads (0: one per CPU core, never more than jobCount), the calling thread is one of them
+// NOTE: Workers take jobs from a shared queue, so they run until all jobs are done even if some threads fail to start
+static void RunGLTFWorkers(void *(*worker)(void *), void *queue, int threadCount, int jobCount)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	if (threadCount <= 0) threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (threadCount > jobCount) threadCount = jobCount;
+
+	if (threadCount > 1)
+	{
+		pthread_t *threads = RL_MALLOC((threadCount - 1)*sizeof(pthread_t));
+		int started = 0;
+
+		for (; started < threadCount - 1; started++)
+		{
+			if (pthread_create(&threads[started], NULL, worker, queue) != 0) break;
+		}
+
+		worker(queue);
+
+		for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+		RL_FREE(threads);
+		return;
+	}
+#else
+	(void)threadCount;
+	(void)jobCount;
+#endif
+	worker(queue);
+}
+
+// Image decoding worker, takes jobs from the queue until it's empty
+static void *DecodeGLTFImagesWorker(void *arg)
+{
+	GLTFImageQueue *queue = (GLTFImageQueue *)arg;
+
+	while (true)
+	{
+#if defined(RGLTF_SUPPORT_THREADS)
+		pthread_mutex_lock(&queue->lock);
+#endif
+		int index = queue->nextJob++;
+#if defined(RGLTF_SUPPORT_THREADS)
+		pthread_mutex_unlock(&queue->lock);
+#endif
+		if (index >= queue->jobCount) break;
+
+		GLTFImageJob *job = &queue->jobs[index];
+		if (job->loaded || (job->fileData == NULL)) continue;
+
+		if (job->transcode)
+		{
+			const GLTFLoadOptions *options = queue->options;
+			if ((options != NULL) && (options->transcodeImage != NULL)) job->image = options->transcodeImage(job->fileData, job->fileSize, queue->textureFormat, options->userData);
+			if (job->image.data == NULL) TRACELOG(LOG_WARNING, "IMAGE: Failed to transcode KTX2 image, texture fallback image is used (if any)");
+		}
+		else job->image = LoadImageFromMemory(job->fileType, job->fileData, job->fileSize);
+	}
+
+	return NULL;
+}
+
+// Decode images with options->imageThreads threads (0: one per CPU core), the calling thread is one of them
+// NOTE: Only image decoding (or transcoding) is done by the workers, GPU upload is done later on the calling (GL) thread
+static void DecodeGLTFImages(GLTFImageJob *jobs, int jobCount, const GLTFLoadOptions *options)
+{
+	GLTFImageQueue queue = { 0 };
+	queue.jobs = jobs;
+	queue.jobCount = jobCount;
+	queue.options = options;
+
+	int threadCount = (options != NULL)? options->imageThreads : 0;
+
+	for (int i = 0; i < jobCount; i++)
+	{
+		if (jobs[i].transcode && !jobs[i].loaded && (jobs[i].fileData != NULL))
+		{
+			queue.textureFormat = ((options != NULL) && (options->textureFormat != 0))? options->textureFormat : GetGLTFTranscodeFormat();
+			break;
+		}
+	}
+
+	int imageCount = 0;
+	for (int i = 0; i < jobCount; i++) if (!jobs[i].loaded && (jobs[i].fileData != NULL)) imageCount++;
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_init(&queue.lock, NULL);
+#endif
+	RunGLTFWorkers(DecodeGLTFImagesWorker, &queue, threadCount, imageCount);
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_destroy(&queue.lock);
+#endif
+
+	for (int i = 0; i < jobCount; i++) jobs[i].loaded |= jobs[i].requested;
+}
+
+// Get pointer to buffer view data (NULL if its buffer is not loaded)
+static const unsigned char *GetGLTFBufferViewData(const cgltf_buffer_view *view)
+{
+	// NOTE: Decoded (EXT_meshopt_compression) and dense (sparse accessors) buffer views data is kept in view->data
+	if (view->data != NULL) return (const unsigned char *)view->data;
+	if (view->buffer->data == NULL) return NULL;
+
+	return (const unsigned char *)view->buffer->data + view->offset;
+}
+
+// Get pointer to the first element of accessor data
+static const unsigned char *GetAccessorData(const cgltf_accessor *accessor)
+{
+	return GetGLTFBufferViewData(accessor->buffer_view) + accessor->offset;
+}
+
+// Load accessor elements of elementSize bytes into dst
+static void LoadAccessorData(const cgltf_accessor *accessor, void *dst, size_t elementSize)
+{
+	DecodeCopy(dst, GetAccessorData(accessor), accessor->stride, accessor->count, elementSize);
+}
+
+#if defined(RGLTF_SUPPORT_MESHOPT)
+// Check an EXT_meshopt_compression buffer view stride against its mode and filter (same checks as cgltf_validate())
+// NOTE: Filters decode count*stride bytes in place, a wrong stride would write past the decoded data
+static bool CheckGLTFMeshoptStride(const cgltf_meshopt_compression *compression)
+{
+	cgltf_size stride = compression->stride;
+
+	if ((compression->mode == cgltf_meshopt_compression_mode_attributes) && (stride%4 != 0)) return false;
+
+	switch (compression->filter)
+	{
+		case cgltf_meshopt_compression_filter_octahedral: return (stride == 4) || (stride == 8);
+		case cgltf_meshopt_compression_filter_quaternion: return (stride == 8);
+		case cgltf_meshopt_compression_filter_exponential: return (stride%4 == 0);
+		default: return true;
+	}
+}
+#endif
+
+// Decode EXT_meshopt_compression buffer views, decoded data is kept in buffer_view->data (released by cgltf_free())
+// NOTE: Define RGLTF_SUPPORT_MESHOPT to decode them, otherwise the uncompressed fallback buffers are required
+static bool DecodeGLTFMeshoptBuffers(cgltf_data *data, const char *fileName)
+{
+	for (cgltf_size i = 0; i < data->buffer_views_count; i++)
+	{
+		cgltf_buffer_view *view = &data->buffer_views[i];
+		if (!view->has_meshopt_compression || (view->data != NULL)) continue;
+
+#if defined(RGLTF_SUPPORT_MESHOPT)
+		const cgltf_meshopt_compression *compression = &view->meshopt_compression;
+
+		if ((compression->buffer->data == NULL) || (compression->offset + compression->size > compression->buffer->size))
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] EXT_meshopt_compression buffer view %i data not available", fileName, (int)i);
+			return false;
+		}
+
+		if (!CheckGLTFMeshoptStride(compression))
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] EXT_meshopt_compression buffer view %i stride %i not valid for its mode and filter", fileName, (int)i, (int)compression->stride);
+			return false;
+		}
+
+		const unsigned char *src = (const unsigned char *)compression->buffer->data + compression->offset;
+		cgltf_size size = compression->count*compression->stride;
+		unsigned char *decoded = RL_CALLOC((view->size > size)? view->size : size, 1);
+		bool success = false;
+
+		switch (compression->mode)
+		{
+			case cgltf_meshopt_compression_mode_attributes: success = DecodeMeshoptVertices(decoded, compression->count, compression->stride, src, compression->size); break;
+			case cgltf_meshopt_compression_mode_triangles: success = DecodeMeshoptTriangles(decoded, compression->count, compression->stride, src, compression->size); break;
+			case cgltf_meshopt_compression_mode_indices: success = DecodeMeshoptIndices(decoded, compression->count, compression->stride, src, compression->size); break;
+			default: break;
+		}
+
+		if (!success)
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to decode EXT_meshopt_compression buffer view %i", fileName, (int)i);
+			RL_FREE(decoded);
+			return false;
+		}
+
+		switch (compression->filter)
+		{
+			case cgltf_meshopt_compression_filter_octahedral: DecodeMeshoptFilterOct(decoded, compression->count, compression->stride); break;
+			case cgltf_meshopt_compression_filter_quaternion: DecodeMeshoptFilterQuat((short *)decoded, compression->count, compression->stride); break;
+			case cgltf_meshopt_compression_filter_exponential: DecodeMeshoptFilterExp((unsigned int *)decoded, compression->count, compression->stride); break;
+			default: break;
+		}
+
+		view->data = decoded;
+#else
+		if (view->buffer->data == NULL)
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] EXT_meshopt_compression not supported (define RGLTF_SUPPORT_MESHOPT) and no fallback buffer", fileName);
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+// Get size in bytes of an accessor component type (0: not valid)
+static int GetGLTFComponentSize(cgltf_component_type type)
+{
+	switch (type)
+	{
+		case cgltf_component_type_r_8:
+		case cgltf_component_type_r_8u: return 1;
+		case cgltf_component_type_r_16:
+		case cgltf_component_type_r_16u: return 2;
+		case cgltf_component_type_r_32u:
+		case cgltf_component_type_r_32f: return 4;
+		default: return 0;
+	}
+}
+
+// Replace sparse accessors by dense accessors, so their data can be read from their buffer view like any accessor
+// NOTE: Dense data is the accessor buffer view data (zeros without buffer view) with the sparse elements replaced,
+// it's kept in the returned buffer views (viewCount), released with UnloadGLTFSparseAccessors() after cgltf_free()
+static cgltf_buffer_view *LoadGLTFSparseAccessors(cgltf_data *data, int *viewCount, const char *fileName)
+{
+	*viewCount = 0;
+	for (cgltf_size i = 0; i < data->accessors_count; i++) if (data->accessors[i].is_sparse) (*viewCount)++;
+	if (*viewCount == 0) return NULL;
+
+	cgltf_buffer_view *views = RL_CALLOC(*viewCount, sizeof(cgltf_buffer_view));
+	for (cgltf_size i = 0, v = 0; i < data->accessors_count; i++)
+	{
+		cgltf_accessor *accessor = &data->accessors[i];
+		if (!accessor->is_sparse) continue;
+
+		const cgltf_accessor_sparse *sparse = &accessor->sparse;
+		size_t elementSize = cgltf_num_components(accessor->type)*GetGLTFComponentSize(accessor->component_type);
+		unsigned char *dense = RL_CALLOC(accessor->count + 1, elementSize);
+		if ((accessor->buffer_view != NULL) && (GetGLTFBufferViewData(accessor->buffer_view) != NULL)) LoadAccessorData(accessor, dense, elementSize);
+
+		const unsigned char *indices = (sparse->indices_buffer_view != NULL)? GetGLTFBufferViewData(sparse->indices_buffer_view) : NULL;
+		const unsigned char *values = (sparse->values_buffer_view != NULL)? GetGLTFBufferViewData(sparse->values_buffer_view) : NULL;
+		int indexSize = GetGLTFComponentSize(sparse->indices_component_type);
+
+		// NOTE: Sparse indices and values must fit in their buffer views, they're not checked by cgltf
+		bool fits = (indices != NULL) && (values != NULL) && (indexSize > 0) &&
+			(sparse->indices_byte_offset + sparse->count*indexSize <= sparse->indices_buffer_view->size) &&
+			(sparse->values_byte_offset + sparse->count*elementSize <= sparse->values_buffer_view->size);
+
+		if (fits)
+		{
+			indices += sparse->indices_byte_offset;
+			values += sparse->values_byte_offset;
+
+			for (cgltf_size k = 0; k < sparse->count; k++)
+			{
+				// NOTE: Sparse indices are u8, u16 or u32, read as little-endian unsigned integers
+				unsigned int index = 0;
+				for (int b = 0; b < indexSize; b++) index |= (unsigned int)indices[k*indexSize + b] << (8*b);
+				if (index < accessor->count) memcpy(dense + index*elementSize, values + k*elementSize, elementSize);
+			}
+		}
+		else TRACELOG(LOG_WARNING, "MODEL: [%s] Sparse accessor %i data not available or out of its buffer views, sparse values skipped", fileName, (int)i);
+
+		views[v].data = dense;
+		views[v].size = accessor->count*elementSize;
+		views[v].stride = elementSize;
+
+		accessor->buffer_view = &views[v++];
+		accessor->offset = 0;
+		accessor->stride = elementSize;
+		accessor->is_sparse = false;
+	}
+
+	return views;
+}
+
+// Release dense buffer views of sparse accessors
+static void UnloadGLTFSparseAccessors(cgltf_buffer_view *views, int viewCount)
+{
+	for (int i = 0; i < viewCount; i++) RL_FREE(views[i].data);
+	RL_FREE(views);
+}
+
+// Check accessor component type is float or one of the integer types allowed by KHR_mesh_quantization
+static bool IsGLTFAttributeFormatSupported(const cgltf_accessor *accessor, bool allowUnsigned, bool allowUnnormalized)
+{
+	switch (accessor->component_type)
+	{
+		case cgltf_component_type_r_32f: return true;
+		case cgltf_component_type_r_8:
+		case cgltf_component_type_r_16: return allowUnnormalized || accessor->normalized;
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_r_16u: return allowUnsigned && (allowUnnormalized || accessor->normalized);
+		default: return false;
+	}
+}
+
+// Load accessor data as floats (components per element), quantized data is converted to float
+static void LoadAccessorFloats(const cgltf_accessor *accessor, float *dst, int components)
+{
+	if (accessor->component_type == cgltf_component_type_r_32f) LoadAccessorData(accessor, dst, components*sizeof(float));
+	else cgltf_accessor_unpack_floats(accessor, dst, accessor->count*components);
+}
+
+// Mesh vertex buffers (and default shader attribute locations) used by UploadMesh()
+#define GLTF_VERTEX_BUFFER_POSITION     0
+#define GLTF_VERTEX_BUFFER_TEXCOORD     1
+#define GLTF_VERTEX_BUFFER_NORMAL       2
+#define GLTF_VERTEX_BUFFER_COLOR        3
+#define GLTF_VERTEX_BUFFER_TANGENT      4
+#define GLTF_VERTEX_BUFFER_TEXCOORD2    5
+#define GLTF_VERTEX_BUFFER_INDICES      6
+#define GLTF_VERTEX_BUFFERS             6       // Number of vertex attributes buffers
+
+// Skinning vertex attributes (shader locations), only uploaded interleaved so they don't need vertex buffers
+#define GLTF_VERTEX_ATTRIBUTE_JOINTS    GLTF_SHADER_ATTRIB_LOCATION_JOINTS
+#define GLTF_VERTEX_ATTRIBUTE_WEIGHTS   GLTF_SHADER_ATTRIB_LOCATION_WEIGHTS
+
+// Morph targets vertex attribute (shader location): first delta and deltas count (vec2 float), only uploaded interleaved
+#define GLTF_VERTEX_ATTRIBUTE_MORPH     GLTF_SHADER_ATTRIB_LOCATION_MORPH
+#define GLTF_VERTEX_ATTRIBUTES          9       // Number of vertex attributes
+
+// Vertex attribute data types not defined by rlgl
+#if !defined(RL_BYTE)
+    #define RL_BYTE                     0x1400      // GL_BYTE
+#endif
+#if !defined(RL_SHORT)
+    #define RL_SHORT                    0x1402      // GL_SHORT
+#endif
+#if !defined(RL_UNSIGNED_SHORT)
+    #define RL_UNSIGNED_SHORT           0x1403      // GL_UNSIGNED_SHORT
+#endif
+
+// Vertex attribute kept in its glTF compact (quantized) format to be uploaded to GPU
+typedef struct GLTFVertexAttribute {
+	unsigned char *data;        // Attribute data, elementSize bytes per vertex (NULL: mesh float data is uploaded)
+	int elementSize;            // Element size in bytes (padded to 4 bytes)
+	int components;             // Number of components
+	int type;                   // Components data type (RL_BYTE, RL_UNSIGNED_BYTE, RL_SHORT, RL_UNSIGNED_SHORT)
+	bool normalized;            // Integer data is normalized
+} GLTFVertexAttribute;
+
+// Load quantized accessor data in its compact format, elements are padded to 4 bytes for GPU alignment
+// NOTE: Float accessors are only kept if requested (no mesh float data is uploaded for them)
+static GLTFVertexAttribute LoadGLTFVertexAttribute(const cgltf_accessor *accessor, bool floats, GLTFArena *arena)
+{
+	GLTFVertexAttribute attribute = { 0 };
+
+	if ((accessor->component_type == cgltf_component_type_r_32f) && !floats) return attribute;
+
+	int componentSize = 1;
+	switch (accessor->component_type)
+	{
+		case cgltf_component_type_r_8: attribute.type = RL_BYTE; break;
+		case cgltf_component_type_r_8u: attribute.type = RL_UNSIGNED_BYTE; break;
+		case cgltf_component_type_r_16: attribute.type = RL_SHORT; componentSize = 2; break;
+		case cgltf_component_type_r_16u: attribute.type = RL_UNSIGNED_SHORT; componentSize = 2; break;
+		case cgltf_component_type_r_32f: attribute.type = RL_FLOAT; componentSize = 4; break;
+		default: return attribute;
+	}
+
+	int size = (int)cgltf_num_components(accessor->type)*componentSize;
+	attribute.components = (int)cgltf_num_components(accessor->type);
+	attribute.elementSize = (size + 3) & ~3;
+	attribute.normalized = accessor->normalized;
+	attribute.data = AllocGLTFArray(arena, accessor->count, attribute.elementSize);
+
+	// NOTE: glTF aligns vertex attributes elements to 4 bytes, padded elements can be copied as they are
+	if (accessor->stride >= (cgltf_size)attribute.elementSize) LoadAccessorData(accessor, attribute.data, attribute.elementSize);
+	else
+	{
+		const unsigned char *src = GetAccessorData(accessor);
+		for (cgltf_size i = 0; i < accessor->count; i++) memcpy(attribute.data + i*attribute.elementSize, src + i*accessor->stride, size);
+	}
+
+	return attribute;
+}
+
+// Sub-mesh of a primitive with too many vertices for u16 indices
+typedef struct GLTFSubMesh {
+	int vertexCount;            // Number of sub-mesh vertices
+	int triangleCount;          // Number of sub-mesh triangles
+	unsigned int *vertexMap;    // Primitive vertex index of every sub-mesh vertex
+	unsigned short *indices;    // Sub-mesh triangle indices
+} GLTFSubMesh;
+
+// Split u32 indexed triangles in sub-meshes using at most 65536 vertices each, so they can use u16 indices
+// NOTE: Triangles order is kept, returned array (and its sub-meshes arrays) is allocated from scratch arena (if any)
+// Sub-meshes indices arrays are grown as triangles are added, the sub-meshes triangle counts are not known in advance
+static GLTFSubMesh *SplitGLTFIndices(const unsigned int *indices, int indexCount, int vertexCount, int *subMeshCount, GLTFArena *scratch)
+{
+	const int maxVertices = 65536;
+	int count = 0;
+	int capacity = 4;
+	int indexCapacity = 0;          // Allocated indices of the current sub-mesh
+	GLTFSubMesh *subMeshes = AllocGLTFArray(scratch, capacity, sizeof(GLTFSubMesh));
+	GLTFSubMesh *current = NULL;
+
+	// NOTE: Vertices are added to the current sub-mesh if their stamp is the current sub-mesh number
+	int *stamps = AllocGLTFArray(scratch, vertexCount, sizeof(int));
+	unsigned short *localIndices = AllocGLTFArray(scratch, vertexCount, sizeof(unsigned short));
+
+	for (int t = 0; t + 2 < indexCount; t += 3)
+	{
+		const unsigned int *triangle = &indices[t];
+
+		if ((triangle[0] >= (unsigned int)vertexCount) || (triangle[1] >= (unsigned int)vertexCount) || (triangle[2] >= (unsigned int)vertexCount)) continue;
+
+		int newVertices = 0;
+		for (int k = 0; k < 3; k++) if (stamps[triangle[k]] != count) newVertices++;
+
+		if ((current == NULL) || (current->vertexCount + newVertices > maxVertices))
+		{
+			if (count == capacity)
+			{
+				subMeshes = ReallocGLTFArray(scratch, subMeshes, capacity*sizeof(GLTFSubMesh), 2*capacity*sizeof(GLTFSubMesh));
+				capacity *= 2;
+			}
+
+			current = &subMeshes[count++];
+			current->vertexCount = 0;
+			current->triangleCount = 0;
+			current->vertexMap = AllocGLTFArray(scratch, maxVertices, sizeof(unsigned int));
+
+			indexCapacity = (indexCount - t < 3*1024)? indexCount - t : 3*1024;
+			current->indices = AllocGLTFArray(scratch, indexCapacity, sizeof(unsigned short));
+		}
+
+		if (current->triangleCount*3 + 3 > indexCapacity)
+		{
+			// NOTE: Sub-mesh can't use more indices than the ones left
+			int newCapacity = 2*indexCapacity;
+			if (newCapacity > current->triangleCount*3 + indexCount - t) newCapacity = current->triangleCount*3 + indexCount - t;
+
+			current->indices = ReallocGLTFArray(scratch, current->indices, indexCapacity*sizeof(unsigned short), newCapacity*sizeof(unsigned short));
+			indexCapacity = newCapacity;
+		}
+
+		for (int k = 0; k < 3; k++)
+		{
+			unsigned int vertex = triangle[k];
+
+			if (stamps[vertex] != count)
+			{
+				stamps[vertex] = count;
+				localIndices[vertex] = (unsigned short)current->vertexCount;
+				current->vertexMap[current->vertexCount++] = vertex;
+			}
+
+			current->indices[current->triangleCount*3 + k] = localIndices[vertex];
+		}
+
+		current->triangleCount++;
+	}
+
+	FreeGLTFArray(scratch, stamps);
+	FreeGLTFArray(scratch, localIndices);
+
+	*subMeshCount = count;
+
+	return subMeshes;
+}
+
+// Copy the vertices in vertexMap from src vertex array to dst
+static void GatherGLTFVertices(void *dst, const void *src, const unsigned int *vertexMap, int count, size_t vertexSize)
+{
+	for (int i = 0; i < count; i++) memcpy((unsigned char *)dst + i*vertexSize, (const unsigned char *)src + vertexMap[i]*vertexSize, vertexSize);
+}
+
+// Get sub-mesh of a mesh, copying the vertex attributes it uses (vaoId and vboId not set)
+// NOTE: Arrays freed once uploaded (freeMeshData flags) are allocated from scratch arena, the others from arena
+static Mesh GetGLTFSubMesh(const Mesh *mesh, const GLTFSubMesh *subMesh, GLTFArena *arena, GLTFArena *scratch, unsigned int freeMeshData)
+{
+	Mesh result = { 0 };
+	int count = subMesh->vertexCount;
+
+	result.vertexCount = count;
+	result.triangleCount = subMesh->triangleCount;
+	result.indices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_INDICES)? scratch : arena, subMesh->triangleCount*3, sizeof(unsigned short));
+	memcpy(result.indices, subMesh->indices, subMesh->triangleCount*3*sizeof(unsigned short));
+
+#define GATHER_VERTICES(field, components, type, flag) \
+	if (mesh->field != NULL) \
+	{ \
+		result.field = AllocGLTFArray((freeMeshData & flag)? scratch : arena, count*components, sizeof(type)); \
+		GatherGLTFVertices(result.field, mesh->field, subMesh->vertexMap, count, components*sizeof(type)); \
+	}
+
+	GATHER_VERTICES(vertices, 3, float, GLTF_MESH_DATA_VERTICES)
+	GATHER_VERTICES(texcoords, 2, float, GLTF_MESH_DATA_TEXCOORDS)
+	GATHER_VERTICES(texcoords2, 2, float, GLTF_MESH_DATA_TEXCOORDS)
+	GATHER_VERTICES(normals, 3, float, GLTF_MESH_DATA_NORMALS)
+	GATHER_VERTICES(tangents, 4, float, GLTF_MESH_DATA_TANGENTS)
+	GATHER_VERTICES(colors, 4, unsigned char, GLTF_MESH_DATA_COLORS)
+	GATHER_VERTICES(boneIds, 4, unsigned char, 0)
+	GATHER_VERTICES(boneWeights, 4, float, 0)
+
+#undef GATHER_VERTICES
+
+	return result;
+}
+
+// Free mesh vertex data arrays (CPU only), arrays allocated from arena are kept until it's released
+static void UnloadGLTFMeshData(Mesh mesh, GLTFArena *arena)
+{
+	FreeGLTFArray(arena, mesh.vertices);
+	FreeGLTFArray(arena, mesh.texcoords);
+	FreeGLTFArray(arena, mesh.texcoords2);
+	FreeGLTFArray(arena, mesh.normals);
+	FreeGLTFArray(arena, mesh.tangents);
+	FreeGLTFArray(arena, mesh.colors);
+	FreeGLTFArray(arena, mesh.indices);
+	FreeGLTFArray(arena, mesh.animVertices);
+	FreeGLTFArray(arena, mesh.animNormals);
+	FreeGLTFArray(arena, mesh.boneIds);
+	FreeGLTFArray(arena, mesh.boneWeights);
+}
+
+// Get number of morph targets of a mesh (the most targets used by one of its primitives)
+static int GetGLTFMeshTargetCount(const cgltf_mesh *mesh)
+{
+	int count = 0;
+	for (unsigned int p = 0; p < mesh->primitives_count; p++)
+	{
+		if ((int)mesh->primitives[p].targets_count > count) count = (int)mesh->primitives[p].targets_count;
+	}
+
+	return count;
+}
+
+// Load node mesh morph target weights: node weights, mesh default weights or zeros
+// NOTE: Weights are padded with zeros to a multiple of 4, they are uploaded to shaders as vec4 arrays
+static void LoadGLTFNodeWeights(GLTFNode *node, const cgltf_node *cgltfNode, GLTFArena *arena)
+{
+	const cgltf_mesh *mesh = cgltfNode->mesh;
+	int targetCount = (mesh != NULL)? GetGLTFMeshTargetCount(mesh) : 0;
+	if (targetCount > GLTF_MAX_MORPH_TARGETS) targetCount = GLTF_MAX_MORPH_TARGETS;
+	if (targetCount == 0) return;
+
+	const cgltf_float *weights = (cgltfNode->weights_count > 0)? cgltfNode->weights : mesh->weights;
+	int weightCount = (int)((cgltfNode->weights_count > 0)? cgltfNode->weights_count : mesh->weights_count);
+
+	node->weightCount = targetCount;
+	node->weights = AllocGLTFArray(arena, (targetCount + 3) & ~3, sizeof(float));
+	for (int t = 0; (t < targetCount) && (t < weightCount); t++) node->weights[t] = weights[t];
+}
+
+// Load primitive morph targets, only the deltas of the vertices actually moved by every target are kept
+// NOTE: Position and normal deltas are supported (tangent deltas are ignored), sparse accessors are dense
+// at this point so their zero deltas are skipped like any unmoved vertex, deltas are sorted by vertex
+static void LoadGLTFMorphTargets(GLTFMorphTargets *morph, const cgltf_primitive *primitive, int vertexCount, const char *fileName, GLTFArena *arena, GLTFArena *scratch)
+{
+	int targetCount = (int)primitive->targets_count;
+	if (targetCount > GLTF_MAX_MORPH_TARGETS)
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] Primitive has %i morph targets, only first %i are supported", fileName, targetCount, GLTF_MAX_MORPH_TARGETS);
+		targetCount = GLTF_MAX_MORPH_TARGETS;
+	}
+	if ((targetCount == 0) || (vertexCount == 0)) return;
+
+	float *positions = AllocGLTFArray(scratch, vertexCount*3, sizeof(float));
+	float *normals = AllocGLTFArray(scratch, vertexCount*3, sizeof(float));
+	int *cursors = AllocGLTFArray(scratch, vertexCount + 1, sizeof(int));
+
+	// Morph targets deltas (8 floats each: position delta, target, normal delta, 0), in target order
+	int deltaCount = 0;
+	int capacity = 256;
+	float *deltas = AllocGLTFArray(scratch, capacity*8, sizeof(float));
+	int *deltaVertices = AllocGLTFArray(scratch, capacity, sizeof(int));
+
+	for (int t = 0; t < targetCount; t++)
+	{
+		const cgltf_morph_target *target = &primitive->targets[t];
+		bool hasPositions = false;
+		bool hasNormals = false;
+
+		for (unsigned int a = 0; a < target->attributes_count; a++)
+		{
+			const cgltf_accessor *accessor = target->attributes[a].data;
+			cgltf_attribute_type type = target->attributes[a].type;
+			if ((type != cgltf_attribute_type_position) && (type != cgltf_attribute_type_normal)) continue;
+
+			// NOTE: Morph target deltas could be quantized (KHR_mesh_quantization), normalized or not
+			if ((accessor->type == cgltf_type_vec3) && ((int)accessor->count == vertexCount) && IsGLTFAttributeFormatSupported(accessor, false, true))
+			{
+				LoadAccessorFloats(accessor, (type == cgltf_attribute_type_position)? positions : normals, 3);
+				if (type == cgltf_attribute_type_position) hasPositions = true;
+				else hasNormals = true;
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Morph target attribute data format not supported, use vec3 float or quantized", fileName);
+		}
+
+		if (!hasPositions) memset(positions, 0, vertexCount*3*sizeof(float));
+		if (!hasNormals) memset(normals, 0, vertexCount*3*sizeof(float));
+
+		for (int v = 0; v < vertexCount; v++)
+		{
+			const float *p = &positions[v*3];
+			const float *n = &normals[v*3];
+			if ((p[0] == 0.0f) && (p[1] == 0.0f) && (p[2] == 0.0f) && (n[0] == 0.0f) && (n[1] == 0.0f) && (n[2] == 0.0f)) continue;
+
+			if (deltaCount == capacity)
+			{
+				deltas = ReallocGLTFArray(scratch, deltas, capacity*8*sizeof(float), 2*capacity*8*sizeof(float));
+				deltaVertices = ReallocGLTFArray(scratch, deltaVertices, capacity*sizeof(int), 2*capacity*sizeof(int));
+				capacity *= 2;
+			}
+
+			float *delta = &deltas[deltaCount*8];
+			delta[0] = p[0]; delta[1] = p[1]; delta[2] = p[2]; delta[3] = (float)t;
+			delta[4] = n[0]; delta[5] = n[1]; delta[6] = n[2]; delta[7] = 0.0f;
+			deltaVertices[deltaCount++] = v;
+			cursors[v]++;
+		}
+	}
+
+	if (deltaCount > 0)
+	{
+		// Sort deltas by vertex (counting sort, kept in target order), vertexDeltas[v] is the first delta of vertex v
+		morph->targetCount = targetCount;
+		morph->deltaCount = deltaCount;
+		morph->vertexDeltas = AllocGLTFArray(arena, vertexCount + 1, sizeof(int));
+		morph->deltas = AllocGLTFArray(arena, deltaCount*8, sizeof(float));
+
+		for (int v = 0; v < vertexCount; v++)
+		{
+			morph->vertexDeltas[v + 1] = morph->vertexDeltas[v] + cursors[v];
+			cursors[v] = morph->vertexDeltas[v];
+		}
+		for (int d = 0; d < deltaCount; d++) memcpy(&morph->deltas[(cursors[deltaVertices[d]]++)*8], &deltas[d*8], 8*sizeof(float));
+	}
+
+	FreeGLTFArray(scratch, deltaVertices);
+	FreeGLTFArray(scratch, deltas);
+	FreeGLTFArray(scratch, cursors);
+	FreeGLTFArray(scratch, normals);
+	FreeGLTFArray(scratch, positions);
+}
+
+// Get morph targets of a sub-mesh, copying the deltas of the vertices it uses
+static GLTFMorphTargets GetGLTFSubMeshMorphTargets(const GLTFMorphTargets *morph, const GLTFSubMesh *subMesh, GLTFArena *arena)
+{
+	GLTFMorphTargets result = { 0 };
+	if (morph->deltaCount == 0) return result;
+
+	result.vertexDeltas = AllocGLTFArray(arena, subMesh->vertexCount + 1, sizeof(int));
+	for (int v = 0; v < subMesh->vertexCount; v++)
+	{
+		unsigned int vertex = subMesh->vertexMap[v];
+		result.vertexDeltas[v + 1] = result.vertexDeltas[v] + (morph->vertexDeltas[vertex + 1] - morph->vertexDeltas[vertex]);
+	}
+
+	result.deltaCount = result.vertexDeltas[subMesh->vertexCount];
+	if (result.deltaCount == 0)
+	{
+		FreeGLTFArray(arena, result.vertexDeltas);
+		return (GLTFMorphTargets){ 0 };
+	}
+
+	result.targetCount = morph->targetCount;
+	result.deltas = AllocGLTFArray(arena, result.deltaCount*8, sizeof(float));
+	for (int v = 0; v < subMesh->vertexCount; v++)
+	{
+		unsigned int vertex = subMesh->vertexMap[v];
+		int count = morph->vertexDeltas[vertex + 1] - morph->vertexDeltas[vertex];
+		memcpy(&result.deltas[result.vertexDeltas[v]*8], &morph->deltas[morph->vertexDeltas[vertex]*8], count*8*sizeof(float));
+	}
+
+	return result;
+}
+
+// Get mesh bounds grown by its morph targets deltas, every target weight in [0, 1] range is bounded
+// NOTE: Each target moves the bounds by the range of its deltas, so bounds are valid for any weights combination
+static BoundingBox GetGLTFMorphBounds(BoundingBox bounds, const GLTFMorphTargets *morph)
+{
+	Vector3 targetMin[GLTF_MAX_MORPH_TARGETS] = { 0 };
+	Vector3 targetMax[GLTF_MAX_MORPH_TARGETS] = { 0 };
+
+	for (int d = 0; d < morph->deltaCount; d++)
+	{
+		const float *delta = &morph->deltas[d*8];
+		int target = (int)delta[3];
+		targetMin[target] = Vector3Min(targetMin[target], (Vector3){ delta[0], delta[1], delta[2] });
+		targetMax[target] = Vector3Max(targetMax[target], (Vector3){ delta[0], delta[1], delta[2] });
+	}
+
+	for (int t = 0; t < morph->targetCount; t++)
+	{
+		bounds.min = Vector3Add(bounds.min, targetMin[t]);
+		bounds.max = Vector3Add(bounds.max, targetMax[t]);
+	}
+
+	return bounds;
+}
+
+// Get morph targets vertex attribute: first delta and deltas count of every vertex (as floats, exact up to 2^24)
+static GLTFVertexAttribute GetGLTFMorphAttribute(const GLTFMorphTargets *morph, int vertexCount, GLTFArena *arena)
+{
+	GLTFVertexAttribute attribute = { 0 };
+	attribute.elementSize = 2*sizeof(float);
+	attribute.components = 2;
+	attribute.type = RL_FLOAT;
+	attribute.data = AllocGLTFArray(arena, vertexCount, attribute.elementSize);
+
+	float *ranges = (float *)attribute.data;
+	for (int v = 0; v < vertexCount; v++)
+	{
+		ranges[v*2] = (float)morph->vertexDeltas[v];
+		ranges[v*2 + 1] = (float)(morph->vertexDeltas[v + 1] - morph->vertexDeltas[v]);
+	}
+
+	return attribute;
+}
+
+// Free morph targets arrays, arrays allocated from arena are kept until it's released
+static void UnloadGLTFMorphTargets(GLTFMorphTargets morph, GLTFArena *arena)
+{
+	FreeGLTFArray(arena, morph.vertexDeltas);
+	FreeGLTFArray(arena, morph.deltas);
+}
+
+// Load KHR_draco_mesh_compression primitive, decoded by the user callback into the mesh arrays
+// NOTE: Primitive accessors have no data, they only define the arrays to allocate
+// NOTE: Arrays of primitives to be split are allocated from scratch arena, only the split meshes are kept
+// NOTE: primitiveId (primitive number in file order) is only used for logging
+static void LoadGLTFDracoPrimitive(Mesh *mesh, BoundingBox *bounds, unsigned int **indices32, const cgltf_data *data, const cgltf_primitive *primitive, int primitiveId, const GLTFLoadOptions *options, const char *fileName, GLTFArena *arena, GLTFArena *scratch)
+{
+	const cgltf_draco_mesh_compression *draco = &primitive->draco_mesh_compression;
+
+	if ((options == NULL) || (options->decodeDraco == NULL))
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] KHR_draco_mesh_compression not supported, provide a decoder (GLTFLoadOptions.decodeDraco)", fileName);
+		return;
+	}
+
+	if (draco->buffer_view->buffer->data == NULL)
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] Draco primitive %i compressed data buffer not loaded", fileName, primitiveId);
+		return;
+	}
+
+	GLTFDracoPrimitive compressed = { 0 };
+	compressed.data = (const unsigned char *)draco->buffer_view->buffer->data + draco->buffer_view->offset;
+	compressed.dataSize = (int)draco->buffer_view->size;
+	compressed.positionId = compressed.normalId = compressed.tangentId = compressed.texcoordId = compressed.colorId = -1;
+
+	// NOTE: cgltf stores Draco attribute ids as accessor pointers
+	for (unsigned int i = 0; i < draco->attributes_count; i++)
+	{
+		int id = (int)(draco->attributes[i].data - data->accessors);
+
+		switch (draco->attributes[i].type)
+		{
+			case cgltf_attribute_type_position: compressed.positionId = id; break;
+			case cgltf_attribute_type_normal: compressed.normalId = id; break;
+			case cgltf_attribute_type_tangent: compressed.tangentId = id; break;
+			case cgltf_attribute_type_texcoord: if (draco->attributes[i].index == 0) compressed.texcoordId = id; break;
+			case cgltf_attribute_type_color: if (draco->attributes[i].index == 0) compressed.colorId = id; break;
+			default: break;
+		}
+	}
+
+	const cgltf_accessor *position = NULL;
+	for (unsigned int i = 0; i < primitive->attributes_count; i++) if (primitive->attributes[i].type == cgltf_attribute_type_position) position = primitive->attributes[i].data;
+
+	if ((position == NULL) || (compressed.positionId < 0))
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] Draco primitive has no POSITION attribute", fileName);
+		return;
+	}
+
+	int count = (int)position->count;
+	GLTFArena *meshArena = ((primitive->indices != NULL) && (count > 65536))? scratch : arena;
+	unsigned int freeMeshData = options->freeMeshData;
+	mesh->vertexCount = count;
+	mesh->vertices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_VERTICES)? scratch : meshArena, count*3, sizeof(float));
+	if (compressed.normalId >= 0) mesh->normals = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_NORMALS)? scratch : meshArena, count*3, sizeof(float));
+	if (compressed.tangentId >= 0) mesh->tangents = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_TANGENTS)? scratch : meshArena, count*4, sizeof(float));
+	if (compressed.texcoordId >= 0) mesh->texcoords = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_TEXCOORDS)? scratch : meshArena, count*2, sizeof(float));
+	if (compressed.colorId >= 0) mesh->colors = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_COLORS)? scratch : meshArena, count*4, sizeof(unsigned char));
+
+	if (primitive->indices != NULL)
+	{
+		mesh->triangleCount = (int)primitive->indices->count/3;
+
+		// NOTE: Primitives with more than 65536 vertices are decoded with u32 indices to be split
+		if (count <= 65536) mesh->indices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_INDICES)? scratch : meshArena, mesh->triangleCount*3, sizeof(unsigned short));
+		else compressed.indices32 = AllocGLTFArray(scratch, primitive->indices->count, sizeof(unsigned int));
+	}
+	else mesh->triangleCount = count/3;
+
+	if (!options->decodeDraco(&compressed, mesh, options->userData))
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to decode Draco primitive", fileName);
+
+		// NOTE: Arena arrays (pModel or scratch arena) are released with their arena
+		unsigned int *vboId = mesh->vboId;
+		if (scratch == NULL) UnloadGLTFMeshData(*mesh, NULL);
+		*mesh = (Mesh){ 0 };
+		mesh->vboId = vboId;
+		FreeGLTFArray(scratch, compressed.indices32);
+		return;
+	}
+
+	*indices32 = compressed.indices32;
+
+	if (position->has_min && position->has_max)
+	{
+		bounds->min = (Vector3){ position->min[0], position->min[1], position->min[2] };
+		bounds->max = (Vector3){ position->max[0], position->max[1], position->max[2] };
+	}
+	else *bounds = GetMeshBoundingBox(*mesh);
+}
+
+// Files loaded through cgltf file callbacks, needed to release them
+typedef struct GLTFFileData {
+	void *data;
+	size_t size;
+	bool mapped;            // Memory-mapped file or loaded with LoadFileData()
+} GLTFFileData;
+
+typedef struct GLTFFileList {
+	const GLTFLoadOptions *options;   // Load options (external resources resolver)
+	int count;
+	int capacity;
+	GLTFFileData *files;
+	bool keepMapped;                  // Memory-mapped files are not released by cgltf_free(), mesh arrays point to them
+} GLTFFileList;
+
+// Memory-map a file (read-only), NULL if not possible
+static void *MapGLTFFile(const char *path, size_t *size)
+{
+	void *data = NULL;
+#if defined(RGLTF_SUPPORT_MMAP)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return NULL;
+
+	struct stat st;
+	if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+	{
+		data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) data = NULL;
+		else *size = (size_t)st.st_size;
+	}
+
+	// NOTE: The mapping stays valid once the file is closed
+	close(fd);
+#else
+	(void)path;
+	(void)size;
+#endif
+	return data;
+}
+
+// cgltf file read callback: load the file with the user resolver if provided,
+// otherwise memory-map the file, falling back to LoadFileData()
+static cgltf_result ReadGLTFFile(const struct cgltf_memory_options *memoryOptions, const struct cgltf_file_options *fileOptions, const char *path, cgltf_size *size, void **data)
+{
+	(void)memoryOptions;
+	GLTFFileList *list = (GLTFFileList *)fileOptions->user_data;
+	GLTFFileData file = { 0 };
+
+	if ((list->options != NULL) && (list->options->resolveUri != NULL))
+	{
+		int dataSize = 0;
+		file.data = list->options->resolveUri(path, &dataSize, list->options->userData);
+		file.size = (size_t)dataSize;
+
+		if (file.data == NULL) TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to resolve external resource", path);
+	}
+	else
+	{
+		file.data = MapGLTFFile(path, &file.size);
+		file.mapped = (file.data != NULL);
+
+		if (!file.mapped)
+		{
+			unsigned int dataSize = 0;
+			file.data = LoadFileData(path, &dataSize);
+			file.size = dataSize;
+		}
+	}
+
+	if (file.data == NULL) return cgltf_result_file_not_found;
+	if ((list->options != NULL) && (list->options->stats != NULL)) list->options->stats->bytesRead += (unsigned int)file.size;
+
+	if (list->count == list->capacity)
+	{
+		list->capacity = (list->capacity == 0)? 8 : list->capacity*2;
+		list->files = RL_REALLOC(list->files, list->capacity*sizeof(GLTFFileData));
+	}
+	list->files[list->count++] = file;
+
+	*size = file.size;
+	*data = file.data;
+
+	return cgltf_result_success;
+}
+
+// cgltf file release callback
+static void ReleaseGLTFFile(const struct cgltf_memory_options *memoryOptions, const struct cgltf_file_options *fileOptions, void *data)
+{
+	(void)memoryOptions;
+	GLTFFileList *list = (GLTFFileList *)fileOptions->user_data;
+
+	if (data == NULL) return;
+
+	for (int i = 0; i < list->count; i++)
+	{
+		if (list->files[i].data != data) continue;
+		if (list->keepMapped && list->files[i].mapped) break;
+
+#if defined(RGLTF_SUPPORT_MMAP)
+		if (list->files[i].mapped) munmap(data, list->files[i].size);
+		else
+#endif
+		UnloadFileData(data);
+
+		list->files[i] = list->files[--list->count];
+		break;
+	}
+}
+
+// Check if size bytes of memory are in a memory-mapped file of the list
+static bool IsGLTFMappedMemory(const GLTFFileList *list, const void *ptr, size_t size)
+{
+	for (int i = 0; (list != NULL) && (ptr != NULL) && (i < list->count); i++)
+	{
+		const unsigned char *data = (const unsigned char *)list->files[i].data;
+		if (!list->files[i].mapped || ((const unsigned char *)ptr < data)) continue;
+		if ((size_t)((const unsigned char *)ptr - data) + size <= list->files[i].size) return true;
+	}
+
+	return false;
+}
+
+// Release memory-mapped files kept for the mesh arrays pointing to them (GLTFFileList.keepMapped)
+static void UnloadGLTFMappedFiles(GLTFFileList *list)
+{
+#if defined(RGLTF_SUPPORT_MMAP)
+	for (int i = 0; i < list->count; i++)
+	{
+		if (list->files[i].mapped) munmap(list->files[i].data, list->files[i].size);
+	}
+#endif
+	RL_FREE(list->files);
+	*list = (GLTFFileList){ 0 };
+}
+
+// Get accessor data in place, if it's tightly packed GPU-ready data of a memory-mapped file (NULL otherwise)
+// NOTE: Mesh arrays freed once uploaded point to it instead of copying it, they are uploaded from the mapped pages
+static void *GetGLTFMappedAccessorData(const GLTFFileList *list, const cgltf_accessor *accessor, cgltf_component_type componentType, int components, size_t componentSize)
+{
+	if ((list == NULL) || (accessor->component_type != componentType) || (accessor->stride != components*componentSize)) return NULL;
+
+	const unsigned char *data = GetAccessorData(accessor);
+	if (((uintptr_t)data%componentSize != 0) || !IsGLTFMappedMemory(list, data, accessor->count*accessor->stride)) return NULL;
+
+	return (void *)data;
+}
+
+// Model data loaded on the CPU, waiting to be uploaded to the GPU
+typedef struct GLTFModelUpload {
+	GLTFModel model;            // Loaded pModel (textures and meshes not uploaded yet)
+	int imageCount;             // Number of images (one per pModel texture)
+	Image *images;              // Decoded images, unloaded once uploaded to pModel.textures
+	uint64_t *imageKeys;        // Asset cache key of every image (NULL: keyed by decoded data, 0: not shared)
+	int *materialImages;        // Image index of every material map (material*MAX_MATERIAL_MAPS + map index, -1: none)
+	GLTFVertexAttribute *meshAttributes;    // Compact vertex attributes of every mesh (mesh*GLTF_VERTEX_ATTRIBUTES + vertex buffer)
+	int uploadedTextures;       // Number of images already uploaded
+	int uploadedMeshes;         // Number of meshes already uploaded
+	GLTFArena *scratch;         // Memory arena of loading temporary data, released with the upload data (NULL: no arena)
+	unsigned int freeMeshData;  // Mesh CPU arrays freed once uploaded (GLTFMeshDataFlags)
+	GLTFFileList mappedFiles;   // Memory-mapped files mesh arrays freed once uploaded point to, released with the upload data
+	int vertexLayout;           // Mesh vertex buffers layout on GPU (GLTFVertexLayout)
+	GLTFLoadStats *stats;       // Loading statistics, upload counters and time are accumulated (NULL: not collected)
+} GLTFModelUpload;
+
+// Get vertex count of a primitive (POSITION accessor count)
+static int GetGLTFPrimitiveVertexCount(const cgltf_primitive *primitive)
+{
+	for (unsigned int i = 0; i < primitive->attributes_count; i++)
+	{
+		if (primitive->attributes[i].type == cgltf_attribute_type_position) return (int)primitive->attributes[i].data->count;
+	}
+
+	return 0;
+}
+
+// Mesh primitive decoding job, every primitive is decoded into its own mesh slot
+typedef struct GLTFPrimitiveJob {
+	const cgltf_primitive *primitive;
+	int slot;                   // Mesh slot the primitive is decoded into (model meshes and upload attributes)
+	bool draco;                 // KHR_draco_mesh_compression primitive, decoded on the calling thread
+	bool split;                 // Primitive with too many vertices for u16 indices, split in several meshes
+	bool mapped;                // Some mesh array points to a memory-mapped file (not copied)
+	unsigned int *indices32;    // u32 indices of primitive to be split
+	GLTFSubMesh *subMeshes;     // Meshes of split primitive
+	int subMeshCount;
+	int meshIndex;              // First model mesh of the loaded primitive (slot moved after previous split primitives)
+	int meshCount;              // Model meshes of the loaded primitive
+} GLTFPrimitiveJob;
+
+// Mesh primitives decoding queue, shared by the workers
+typedef struct GLTFPrimitiveQueue {
+	GLTFPrimitiveJob *jobs;
+	int jobCount;
+	int nextJob;                // Next job to be taken by a worker
+	Mesh *meshes;               // Model meshes, one slot per job
+	BoundingBox *meshBounds;
+	GLTFVertexAttribute *meshAttributes;    // Upload vertex attributes, GLTF_VERTEX_ATTRIBUTES per slot
+	GLTFMorphTargets *meshMorphs;           // Model meshes morph targets (NULL: no primitive has morph targets)
+	GLTFArena *arena;           // Model arena (NULL: RL_CALLOC() arrays)
+	GLTFArena *scratch;         // Scratch arena (NULL: RL_CALLOC() arrays)
+	unsigned int freeMeshData;  // Mesh CPU arrays freed once uploaded to GPU (allocated from scratch)
+	const GLTFFileList *mappedFiles;        // Memory-mapped files, GPU-ready data of mesh arrays freed once uploaded is used in place
+	bool keepQuantized;         // Keep quantized vertex attributes to upload them as they are
+	const char *fileName;
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_t lock;
+#endif
+} GLTFPrimitiveQueue;
+
+// Load mesh primitive vertex attributes and indices into its mesh slot
+// NOTE: Attributes data could be provided in several data formats (8, 8u, 16u, 32...),
+// Only some formats for each attribute type are supported, read info at the top of LoadGLTFModelData()
+static void LoadGLTFPrimitive(const GLTFPrimitiveQueue *queue, GLTFPrimitiveJob *job)
+{
+	const cgltf_primitive *primitive = job->primitive;
+	Mesh *mesh = &queue->meshes[job->slot];
+	BoundingBox *bounds = &queue->meshBounds[job->slot];
+	GLTFVertexAttribute *attributes = &queue->meshAttributes[job->slot*GLTF_VERTEX_ATTRIBUTES];
+	GLTFArena *scratch = queue->scratch;
+	unsigned int freeMeshData = queue->freeMeshData;
+	bool keepQuantized = queue->keepQuantized;
+	const char *fileName = queue->fileName;
+
+	// NOTE: Arrays of primitives to be split are allocated from scratch arena, only the split meshes are kept
+	GLTFArena *meshArena = job->split? scratch : queue->arena;
+	const GLTFFileList *mappedFiles = job->split? NULL : queue->mappedFiles;
+
+	for (unsigned int j = 0; j < primitive->attributes_count; j++)
+	{
+		// Check the different attributes for every pimitive
+		if (primitive->attributes[j].type == cgltf_attribute_type_position)      // POSITION
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			// WARNING: SPECS: POSITION accessor MUST have its min and max properties defined.
+
+			if ((attribute->type == cgltf_type_vec3) && IsGLTFAttributeFormatSupported(attribute, true, true))
+			{
+				// Init raylib mesh vertices to copy glTF attribute data
+				mesh->vertexCount = (int)attribute->count;
+				mesh->vertices = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_VERTICES)? mappedFiles : NULL, attribute, cgltf_component_type_r_32f, 3, sizeof(float));
+				job->mapped |= (mesh->vertices != NULL);
+
+				if (mesh->vertices == NULL)
+				{
+					mesh->vertices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_VERTICES)? scratch : meshArena, attribute->count*3, sizeof(float));
+
+					// Load 3 components of float data type into mesh.vertices
+					LoadAccessorFloats(attribute, mesh->vertices, 3);
+				}
+				if (keepQuantized) attributes[GLTF_VERTEX_BUFFER_POSITION] = LoadGLTFVertexAttribute(attribute, false, scratch);
+
+				// NOTE: Quantized positions min/max are not dequantized, bounds are computed
+				if (attribute->has_min && attribute->has_max && (attribute->component_type == cgltf_component_type_r_32f)) {
+					bounds->min = (Vector3){ attribute->min[0], attribute->min[1], attribute->min[2] };
+					bounds->max = (Vector3){ attribute->max[0], attribute->max[1], attribute->max[2] };
+				} else {
+					if (!attribute->has_min || !attribute->has_max) TRACELOG(LOG_WARNING, "MODEL: [%s] POSITION accessor has no min/max, computing mesh bounds", fileName);
+					*bounds = GetMeshBoundingBox(*mesh);
+				}
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Vertices attribute data format not supported, use vec3 float or quantized", fileName);
+		}
+		else if (primitive->attributes[j].type == cgltf_attribute_type_normal)   // NORMAL
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			if ((attribute->type == cgltf_type_vec3) && IsGLTFAttributeFormatSupported(attribute, false, false))
+			{
+				// Init raylib mesh normals to copy glTF attribute data
+				mesh->normals = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_NORMALS)? mappedFiles : NULL, attribute, cgltf_component_type_r_32f, 3, sizeof(float));
+				job->mapped |= (mesh->normals != NULL);
+
+				if (mesh->normals == NULL)
+				{
+					mesh->normals = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_NORMALS)? scratch : meshArena, attribute->count*3, sizeof(float));
+
+					// Load 3 components of float data type into mesh.normals
+					LoadAccessorFloats(attribute, mesh->normals, 3);
+				}
+				if (keepQuantized) attributes[GLTF_VERTEX_BUFFER_NORMAL] = LoadGLTFVertexAttribute(attribute, false, scratch);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Normal attribute data format not supported, use vec3 float or normalized i8/i16", fileName);
+		}
+		else if (primitive->attributes[j].type == cgltf_attribute_type_tangent)   // TANGENT
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			if ((attribute->type == cgltf_type_vec4) && IsGLTFAttributeFormatSupported(attribute, false, false))
+			{
+				// Init raylib mesh tangent to copy glTF attribute data
+				mesh->tangents = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_TANGENTS)? mappedFiles : NULL, attribute, cgltf_component_type_r_32f, 4, sizeof(float));
+				job->mapped |= (mesh->tangents != NULL);
+
+				if (mesh->tangents == NULL)
+				{
+					mesh->tangents = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_TANGENTS)? scratch : meshArena, attribute->count*4, sizeof(float));
+
+					// Load 4 components of float data type into mesh.tangents
+					LoadAccessorFloats(attribute, mesh->tangents, 4);
+				}
+				if (keepQuantized) attributes[GLTF_VERTEX_BUFFER_TANGENT] = LoadGLTFVertexAttribute(attribute, false, scratch);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Tangent attribute data format not supported, use vec4 float or normalized i8/i16", fileName);
+		}
+		else if (primitive->attributes[j].type == cgltf_attribute_type_texcoord) // TEXCOORD_0
+		{
+			// TODO: Support additional texture coordinates: TEXCOORD_1 -> mesh.texcoords2
+
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			if ((attribute->type == cgltf_type_vec2) && IsGLTFAttributeFormatSupported(attribute, true, true))
+			{
+				// Init raylib mesh texcoords to copy glTF attribute data
+				mesh->texcoords = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_TEXCOORDS)? mappedFiles : NULL, attribute, cgltf_component_type_r_32f, 2, sizeof(float));
+				job->mapped |= (mesh->texcoords != NULL);
+
+				if (mesh->texcoords == NULL)
+				{
+					mesh->texcoords = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_TEXCOORDS)? scratch : meshArena, attribute->count*2, sizeof(float));
+
+					// Load 2 components of float data type into mesh.texcoords
+					LoadAccessorFloats(attribute, mesh->texcoords, 2);
+				}
+				if (keepQuantized) attributes[GLTF_VERTEX_BUFFER_TEXCOORD] = LoadGLTFVertexAttribute(attribute, false, scratch);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Texcoords attribute data format not supported, use vec2 float or quantized", fileName);
+		}
+		else if (primitive->attributes[j].type == cgltf_attribute_type_color)    // COLOR_0
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			// WARNING: SPECS: All components of each COLOR_n accessor element MUST be clamped to [0.0, 1.0] range.
+
+			if ((attribute->component_type == cgltf_component_type_r_8u) && (attribute->type == cgltf_type_vec4))
+			{
+				// Init raylib mesh color to copy glTF attribute data
+				mesh->colors = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_COLORS)? mappedFiles : NULL, attribute, cgltf_component_type_r_8u, 4, sizeof(unsigned char));
+				job->mapped |= (mesh->colors != NULL);
+
+				if (mesh->colors == NULL)
+				{
+					mesh->colors = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_COLORS)? scratch : meshArena, attribute->count*4, sizeof(unsigned char));
+
+					// Load 4 components of unsigned char data type into mesh.colors
+					LoadAccessorData(attribute, mesh->colors, 4*sizeof(unsigned char));
+				}
+			}
+			else if ((attribute->component_type == cgltf_component_type_r_16u) && (attribute->type == cgltf_type_vec4))
+			{
+				// Init raylib mesh color to copy glTF attribute data
+				mesh->colors = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_COLORS)? scratch : meshArena, attribute->count*4, sizeof(unsigned char));
+
+				// Convert data to raylib color data type (4 bytes)
+				DecodeColorsU16(mesh->colors, GetAccessorData(attribute), attribute->stride, attribute->count);
+			}
+			else if ((attribute->component_type == cgltf_component_type_r_32f) && (attribute->type == cgltf_type_vec4))
+			{
+				// Init raylib mesh color to copy glTF attribute data
+				mesh->colors = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_COLORS)? scratch : meshArena, attribute->count*4, sizeof(unsigned char));
+
+				// Convert data to raylib color data type (4 bytes), we expect the color data normalized
+				DecodeColorsF32(mesh->colors, GetAccessorData(attribute), attribute->stride, attribute->count);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Color attribute data format not supported", fileName);
+		}
+
+		else if ((primitive->attributes[j].type == cgltf_attribute_type_joints) && (primitive->attributes[j].index == 0))     // JOINTS_0
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			// NOTE: Joint indices are uploaded to GPU as they are (u8, u16), there is no mesh CPU copy
+			// JOINTS_1 + WEIGHTS_1 would be used for +4 joints influencing a vertex -> Not supported
+			if ((attribute->type == cgltf_type_vec4) && ((attribute->component_type == cgltf_component_type_r_8u) || (attribute->component_type == cgltf_component_type_r_16u)))
+			{
+				attributes[GLTF_VERTEX_ATTRIBUTE_JOINTS] = LoadGLTFVertexAttribute(attribute, false, scratch);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Joints attribute data format not supported, use vec4 u8/u16", fileName);
+		}
+		else if ((primitive->attributes[j].type == cgltf_attribute_type_weights) && (primitive->attributes[j].index == 0))   // WEIGHTS_0
+		{
+			cgltf_accessor *attribute = primitive->attributes[j].data;
+
+			// NOTE: Weights are uploaded to GPU as they are (normalized u8, u16 or float), there is no mesh CPU copy
+			if ((attribute->type == cgltf_type_vec4) && ((attribute->component_type == cgltf_component_type_r_32f) || attribute->normalized))
+			{
+				attributes[GLTF_VERTEX_ATTRIBUTE_WEIGHTS] = LoadGLTFVertexAttribute(attribute, true, scratch);
+			}
+			else TRACELOG(LOG_WARNING, "MODEL: [%s] Weights attribute data format not supported, use vec4 float or normalized u8/u16", fileName);
+		}
+	}
+
+	// NOTE: Skinned vertices need both joints and weights
+	GLTFVertexAttribute *skinAttributes = &attributes[GLTF_VERTEX_ATTRIBUTE_JOINTS];
+	if ((skinAttributes[0].data == NULL) != (skinAttributes[1].data == NULL))
+	{
+		for (int a = 0; a < 2; a++)
+		{
+			FreeGLTFArray(scratch, skinAttributes[a].data);
+			skinAttributes[a] = (GLTFVertexAttribute){ 0 };
+		}
+	}
+
+	// Load primitive indices data (if provided)
+	if (primitive->indices != NULL)
+	{
+		cgltf_accessor *attribute = primitive->indices;
+
+		mesh->triangleCount = (int)attribute->count/3;
+
+		if (attribute->component_type == cgltf_component_type_r_16u)
+		{
+			// Init raylib mesh indices to copy glTF attribute data
+			mesh->indices = GetGLTFMappedAccessorData((freeMeshData & GLTF_MESH_DATA_INDICES)? mappedFiles : NULL, attribute, cgltf_component_type_r_16u, 1, sizeof(unsigned short));
+			job->mapped |= (mesh->indices != NULL);
+
+			if (mesh->indices == NULL)
+			{
+				mesh->indices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_INDICES)? scratch : meshArena, attribute->count, sizeof(unsigned short));
+
+				// Load unsigned short data type into mesh.indices
+				LoadAccessorData(attribute, mesh->indices, sizeof(unsigned short));
+			}
+		}
+		else if (attribute->component_type == cgltf_component_type_r_32u)
+		{
+			// NOTE: raylib meshes use u16 indices, if all the vertices can be indexed with
+			// u16 indices are converted, otherwise the primitive is split in several meshes
+			if (!job->split)
+			{
+				// Init raylib mesh indices to copy glTF attribute data
+				mesh->indices = AllocGLTFArray((freeMeshData & GLTF_MESH_DATA_INDICES)? scratch : meshArena, attribute->count, sizeof(unsigned short));
+
+				// Convert data to raylib indices data type (unsigned short)
+				DecodeIndicesU32(mesh->indices, GetAccessorData(attribute), attribute->count);
+			}
+			else
+			{
+				job->indices32 = AllocGLTFArray(scratch, attribute->count, sizeof(unsigned int));
+				LoadAccessorData(attribute, job->indices32, sizeof(unsigned int));
+			}
+		}
+		else TRACELOG(LOG_WARNING, "MODEL: [%s] Indices data format not supported, use u16", fileName);
+	}
+	else mesh->triangleCount = mesh->vertexCount/3;    // Unindexed mesh
+
+	// Load primitive morph targets, mesh bounds are grown so they contain the mesh for any targets weights
+	if ((queue->meshMorphs != NULL) && (primitive->targets_count > 0))
+	{
+		LoadGLTFMorphTargets(&queue->meshMorphs[job->slot], primitive, mesh->vertexCount, fileName, meshArena, scratch);
+		*bounds = GetGLTFMorphBounds(*bounds, &queue->meshMorphs[job->slot]);
+	}
+
+	// NOTE: Split primitive meshes are computed here too, they are extracted once every mesh slot is known
+	if (job->indices32 != NULL) job->subMeshes = SplitGLTFIndices(job->indices32, (int)primitive->indices->count, mesh->vertexCount, &job->subMeshCount, scratch);
+}
+
+// Mesh primitives decoding worker, takes jobs from the queue until it's empty
+// NOTE: Draco primitives are skipped, the user decoder callback is only called from the calling thread
+static void *LoadGLTFPrimitivesWorker(void *arg)
+{
+	GLTFPrimitiveQueue *queue = (GLTFPrimitiveQueue *)arg;
+
+	while (true)
+	{
+#if defined(RGLTF_SUPPORT_THREADS)
+		pthread_mutex_lock(&queue->lock);
+#endif
+		int index = queue->nextJob++;
+#if defined(RGLTF_SUPPORT_THREADS)
+		pthread_mutex_unlock(&queue->lock);
+#endif
+		if (index >= queue->jobCount) break;
+
+		if (!queue->jobs[index].draco) LoadGLTFPrimitive(queue, &queue->jobs[index]);
+	}
+
+	return NULL;
+}
+
+// Get raylib matrix from glTF matrix elements (column-major)
+static Matrix GetGLTFMatrix(const float *m)
+{
+	Matrix result = {
+		m[0], m[4], m[8], m[12],
+		m[1], m[5], m[9], m[13],
+		m[2], m[6], m[10], m[14],
+		m[3], m[7], m[11], m[15]
+	};
+
+	return result;
+}
+
+// Load skin joints and inverse bind matrices (identity matrices if not provided)
+// NOTE: Joint matrices are computed with the pModel world transforms (UpdateGLTFModelTransforms())
+static void LoadGLTFSkin(GLTFSkin *skin, const cgltf_data *data, const cgltf_skin *gltfSkin, const char *fileName, GLTFArena *arena, GLTFArena *scratch)
+{
+	skin->jointCount = (int)gltfSkin->joints_count;
+	skin->joints = AllocGLTFArray(arena, skin->jointCount, sizeof(int));
+	skin->inverseBindMatrices = AllocGLTFArray(arena, skin->jointCount, sizeof(Matrix));
+	skin->jointMatrices = AllocGLTFArray(arena, skin->jointCount*12, sizeof(float));
+
+	const cgltf_accessor *accessor = gltfSkin->inverse_bind_matrices;
+	float *matrices = NULL;
+	if ((accessor != NULL) && (accessor->type == cgltf_type_mat4) && (accessor->component_type == cgltf_component_type_r_32f) && (accessor->count >= gltfSkin->joints_count))
+	{
+		matrices = AllocGLTFArray(scratch, accessor->count*16, sizeof(float));
+		LoadAccessorFloats(accessor, matrices, 16);
+	}
+	else if (accessor != NULL) TRACELOG(LOG_WARNING, "MODEL: [%s] Skin inverse bind matrices format not supported, use mat4 float", fileName);
+
+	for (int j = 0; j < skin->jointCount; j++)
+	{
+		skin->joints[j] = (int)(gltfSkin->joints[j] - data->nodes);
+		skin->inverseBindMatrices[j] = (matrices != NULL)? GetGLTFMatrix(&matrices[j*16]) : MatrixIdentity();
+	}
+
+	FreeGLTFArray(scratch, matrices);
+}
+
+// Get animation channel values components (3, 4 or morph targets count floats per key), 0 if the channel is not supported
+// NOTE: Keyframe times must be float scalars, weights channels values are scalars (one per target and key)
+static int GetGLTFAnimationChannelComponents(const cgltf_animation_channel *channel)
+{
+	const cgltf_animation_sampler *sampler = channel->sampler;
+	if ((channel->target_node == NULL) || (sampler == NULL) || (sampler->input == NULL) || (sampler->output == NULL)) return 0;
+	if ((sampler->input->count == 0) || (sampler->input->type != cgltf_type_scalar) || (sampler->input->component_type != cgltf_component_type_r_32f)) return 0;
+
+	int components = 0;
+	cgltf_type type = cgltf_type_vec3;
+	switch (channel->target_path)
+	{
+		case cgltf_animation_path_type_translation:
+		case cgltf_animation_path_type_scale: components = 3; break;
+		case cgltf_animation_path_type_rotation: components = 4; type = cgltf_type_vec4; break;
+		case cgltf_animation_path_type_weights:
+		{
+			components = (channel->target_node->mesh != NULL)? GetGLTFMeshTargetCount(channel->target_node->mesh) : 0;
+			type = cgltf_type_scalar;
+			if (components == 0) return 0;
+		} break;
+		default: return 0;
+	}
+
+	cgltf_size valueCount = sampler->input->count*((sampler->interpolation == cgltf_interpolation_type_cubic_spline)? 3 : 1);
+	if (type == cgltf_type_scalar) valueCount *= components;
+	if ((sampler->output->type != type) || (sampler->output->count != valueCount) || !IsGLTFAttributeFormatSupported(sampler->output, false, false)) return 0;
+
+	return components;
+}
+
+// Load animation channels as keyframe tracks
+// NOTE: Keyframe times and values of all tracks are stored in two contiguous arrays, so sampling many
+// tracks walks memory linearly, unsupported channels are skipped
+static void LoadGLTFAnimation(GLTFAnimation *animation, const cgltf_data *data, const cgltf_animation *gltfAnimation, const char *fileName, GLTFArena *arena, GLTFArena *scratch)
+{
+	if (gltfAnimation->name != NULL) strncpy(animation->name, gltfAnimation->name, sizeof(animation->name) - 1);
+
+	// Count supported channels keyframe times and values
+	size_t timeCount = 0, valueCount = 0;
+	for (unsigned int c = 0; c < gltfAnimation->channels_count; c++)
+	{
+		const cgltf_animation_channel *channel = &gltfAnimation->channels[c];
+		if (GetGLTFAnimationChannelComponents(channel) == 0)
+		{
+			// NOTE: Weights channels of nodes without morph targets have nothing to animate, they are skipped silently
+			bool targets = (channel->target_node != NULL) && (channel->target_node->mesh != NULL) && (GetGLTFMeshTargetCount(channel->target_node->mesh) > 0);
+			if ((channel->target_path != cgltf_animation_path_type_weights) || targets) TRACELOG(LOG_WARNING, "MODEL: [%s] Animation channel format not supported, channel skipped", fileName);
+			continue;
+		}
+
+		// NOTE: Output accessor floats count, weights channels values are scalars
+		animation->trackCount++;
+		timeCount += channel->sampler->input->count;
+		valueCount += channel->sampler->output->count*cgltf_num_components(channel->sampler->output->type);
+	}
+
+	if (animation->trackCount == 0) return;
+
+	animation->tracks = AllocGLTFArray(arena, animation->trackCount, sizeof(GLTFAnimationTrack));
+	float *times = AllocGLTFArray(arena, timeCount, sizeof(float));
+	float *values = AllocGLTFArray(arena, valueCount, sizeof(float));
+	bool *animated = AllocGLTFArray(scratch, data->nodes_count, sizeof(bool));
+
+	int t = 0;
+	for (unsigned int c = 0; c < gltfAnimation->channels_count; c++)
+	{
+		const cgltf_animation_channel *channel = &gltfAnimation->channels[c];
+		int components = GetGLTFAnimationChannelComponents(channel);
+		if (components == 0) continue;
+
+		GLTFAnimationTrack *track = &animation->tracks[t++];
+		track->node = (int)(channel->target_node - data->nodes);
+		switch (channel->target_path)
+		{
+			case cgltf_animation_path_type_translation: track->path = GLTF_ANIMATION_TRANSLATION; break;
+			case cgltf_animation_path_type_rotation: track->path = GLTF_ANIMATION_ROTATION; break;
+			case cgltf_animation_path_type_scale: track->path = GLTF_ANIMATION_SCALE; break;
+			default: track->path = GLTF_ANIMATION_WEIGHTS; break;
+		}
+		switch (channel->sampler->interpolation)
+		{
+			case cgltf_interpolation_type_step: track->interpolation = GLTF_INTERPOLATION_STEP; break;
+			case cgltf_interpolation_type_cubic_spline: track->interpolation = GLTF_INTERPOLATION_CUBICSPLINE; break;
+			default: track->interpolation = GLTF_INTERPOLATION_LINEAR; break;
+		}
+		track->components = components;
+		track->keyCount = (int)channel->sampler->input->count;
+		track->times = times;
+		track->values = values;
+		int outputComponents = (int)cgltf_num_components(channel->sampler->output->type);
+		LoadAccessorFloats(channel->sampler->input, track->times, 1);
+		LoadAccessorFloats(channel->sampler->output, track->values, outputComponents);
+		times += channel->sampler->input->count;
+		values += channel->sampler->output->count*outputComponents;
+
+		if (track->times[track->keyCount - 1] > animation->duration) animation->duration = track->times[track->keyCount - 1];
+
+		// NOTE: Weights tracks don't animate the node transform, their weights are set to the node meshes
+		if (track->path == GLTF_ANIMATION_WEIGHTS)
+		{
+			animation->weightCount += components;
+			continue;
+		}
+		if (!animated[track->node]) animation->nodeCount++;
+		animated[track->node] = true;
+	}
+
+	animation->nodes = AllocGLTFArray(arena, animation->nodeCount, sizeof(int));
+	for (int i = 0, n = 0; i < (int)data->nodes_count; i++)
+	{
+		if (animated[i]) animation->nodes[n++] = i;
+	}
+
+	FreeGLTFArray(scratch, animated);
+}
+
+// Get pModel arena size estimate (nodes, scenes, meshes and their vertex data), so it usually takes a single block
+// NOTE: Every allocation is accounted with its worst case alignment padding
+static size_t GetGLTFArenaSize(const cgltf_data *data)
+{
+	size_t size = (data->materials_count + 1)*sizeof(Material) + (data->images_count + 1)*sizeof(Texture2D);
+	size += data->nodes_count*(sizeof(GLTFNode) + sizeof(int) + sizeof(Matrix) + GLTF_ARENA_ALIGNMENT);
+
+	// NOTE: Nodes and materials with extensions are accounted with the maximum number of MSFT_lod levels
+	bool materialExtensions = false;
+	for (unsigned int i = 0; i < data->materials_count; i++)
+	{
+		if (data->materials[i].extensions_count == 0) continue;
+		size += GLTF_MAX_LOD_LEVELS*sizeof(int);
+		materialExtensions = true;
+	}
+	if (materialExtensions) size += (data->materials_count + 2)*sizeof(int) + 2*GLTF_ARENA_ALIGNMENT;
+
+	for (unsigned int i = 0; i < data->nodes_count; i++)
+	{
+		size += data->nodes[i].children_count*sizeof(int);
+		if ((data->nodes[i].extensions_count > 0) || (materialExtensions && (data->nodes[i].mesh != NULL))) size += GLTF_MAX_LOD_LEVELS*sizeof(int) + (GLTF_MAX_LOD_LEVELS + 1)*sizeof(float) + 2*GLTF_ARENA_ALIGNMENT;
+	}
+	for (unsigned int i = 0; i < data->scenes_count; i++) size += sizeof(GLTFScene) + data->scenes[i].nodes_count*sizeof(int) + GLTF_ARENA_ALIGNMENT;
+	for (unsigned int i = 0; i < data->skins_count; i++) size += sizeof(GLTFSkin) + data->skins[i].joints_count*(sizeof(int) + sizeof(Matrix) + 12*sizeof(float)) + 3*GLTF_ARENA_ALIGNMENT;
+	for (unsigned int i = 0; i < data->animations_count; i++)
+	{
+		size += sizeof(GLTFAnimation) + 4*GLTF_ARENA_ALIGNMENT;
+		for (unsigned int c = 0; c < data->animations[i].channels_count; c++)
+		{
+			const cgltf_animation_sampler *sampler = data->animations[i].channels[c].sampler;
+			size += sizeof(GLTFAnimationTrack) + sizeof(int);
+			if ((sampler != NULL) && (sampler->input != NULL) && (sampler->output != NULL)) size += (sampler->input->count + sampler->output->count*4)*sizeof(float);
+		}
+	}
+
+	for (unsigned int i = 0; i < data->meshes_count; i++)
+	{
+		for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
+		{
+			const cgltf_primitive *primitive = &data->meshes[i].primitives[p];
+			size_t vertexCount = (size_t)GetGLTFPrimitiveVertexCount(primitive);
+
+			size += sizeof(Mesh) + MAX_MESH_VERTEX_BUFFERS*sizeof(unsigned int) + sizeof(int) + sizeof(BoundingBox) + 8*GLTF_ARENA_ALIGNMENT;
+			if (primitive->indices != NULL) size += primitive->indices->count*sizeof(unsigned short);
+
+			for (unsigned int j = 0; j < primitive->attributes_count; j++)
+			{
+				switch (primitive->attributes[j].type)
+				{
+					case cgltf_attribute_type_position:
+					case cgltf_attribute_type_normal: size += vertexCount*3*sizeof(float); break;
+					case cgltf_attribute_type_tangent: size += vertexCount*4*sizeof(float); break;
+					case cgltf_attribute_type_texcoord: size += vertexCount*2*sizeof(float); break;
+					case cgltf_attribute_type_color: size += vertexCount*4*sizeof(unsigned char); break;
+					default: break;
+				}
+			}
+		}
+	}
+
+	return size;
+}
+
+// Add time elapsed since stageStart to a loading stage time, stageStart is moved to current time
+static void AddGLTFStageTime(double *stageTime, double *stageStart)
+{
+	double time = GetTime();
+	*stageTime += time - *stageStart;
+	*stageStart = time;
+}
+
+// Load glTF model data from file (fileData is NULL) or from memory
+// NOTE: fileName is only used for logging when loading from memory, external uris are relative to basePath
+// NOTE: No GPU resources are loaded and no shared (static) buffers are used, so it can run on any thread
+static GLTFModelUpload LoadGLTFModelData(const unsigned char *fileData, int dataSize, const char *fileName, const char *basePath, const GLTFLoadOptions *loadOptions)
+{
+	GLTFModelUpload upload = { 0 };
+	GLTFModel model = { 0 };
+	int *mesh_id_starts = NULL;
+	int *mesh_id_ends = NULL;
+
+	// NOTE: Stages are only timed when statistics are requested
+	GLTFLoadStats *stats = (loadOptions != NULL)? loadOptions->stats : NULL;
+	double stageStart = 0.0;
+	if (stats != NULL)
+	{
+		*stats = (GLTFLoadStats){ 0 };
+		stats->bytesRead = (fileData != NULL)? (unsigned int)dataSize : 0;
+		stageStart = GetTime();
+	}
+	upload.stats = stats;
+
+	// glTF data loading
+	// NOTE: The glTF file and external buffers are memory-mapped, glb binary chunk is used in place
+	// so only the pages actually read are resident, they are released with cgltf_free(), unless
+	// some mesh array freed once uploaded points to them (released with the upload data)
+	GLTFFileList files = { 0 };
+	files.options = loadOptions;
+	cgltf_options options = { 0 };
+	options.memory.alloc = AllocGLTFMemory;
+	options.memory.free = FreeGLTFMemory;
+	options.file.read = ReadGLTFFile;
+	options.file.release = ReleaseGLTFFile;
+	options.file.user_data = &files;
+
+	cgltf_data *data = NULL;
+	cgltf_result result = (fileData != NULL)? cgltf_parse(&options, fileData, dataSize, &data) : cgltf_parse_file(&options, fileName, &data);
+	if (stats != NULL) AddGLTFStageTime(&stats->parseTime, &stageStart);
+
+	if (result == cgltf_result_success)
+	{
+		if (data->file_type == cgltf_file_type_glb) TRACELOG(LOG_INFO, "MODEL: [%s] Model basic data (glb) loaded successfully", fileName);
+		else if (data->file_type == cgltf_file_type_gltf) TRACELOG(LOG_INFO, "MODEL: [%s] Model basic data (glTF) loaded successfully", fileName);
+		else TRACELOG(LOG_WARNING, "MODEL: [%s] Model format not recognized", fileName);
+
+		TRACELOG(LOG_INFO, "    > Meshes count: %i", data->meshes_count);
+		TRACELOG(LOG_INFO, "    > Materials count: %i (+1 default)", data->materials_count);
+		TRACELOG(LOG_DEBUG, "    > Buffers count: %i", data->buffers_count);
+		TRACELOG(LOG_DEBUG, "    > Images count: %i", data->images_count);
+		TRACELOG(LOG_DEBUG, "    > Textures count: %i", data->textures_count);
+		TRACELOG(LOG_DEBUG, "    > Nodes count: %i", data->nodes_count);
+		TRACELOG(LOG_DEBUG, "    > Scenes count: %i", data->scenes_count);
+
+		// Force reading data buffers (fills buffer_view->buffer->data)
+		// NOTE: Base64 data uris are decoded by rgltf, external paths are loaded by cgltf
+		// NOTE: cgltf resolves buffer uris relative to the directory of the given path
+		char *basePathDir = NULL;
+		if ((fileData != NULL) && (basePath != NULL))
+		{
+			basePathDir = RL_MALLOC(strlen(basePath) + 2);
+			sprintf(basePathDir, "%s/", basePath);
+		}
+
+		const char *gltfPath = (fileData == NULL)? fileName : ((basePathDir != NULL)? basePathDir : "");
+		result = LoadGLTFBase64Buffers(&options, data, fileName)? cgltf_load_buffers(&options, data, gltfPath) : cgltf_result_invalid_gltf;
+
+		// Decode compressed buffer views before reading any accessor
+		if ((result == cgltf_result_success) && !DecodeGLTFMeshoptBuffers(data, fileName)) result = cgltf_result_invalid_gltf;
+
+		// Sparse accessors are replaced by dense accessors, so every accessor is read the same way
+		int sparseViewCount = 0;
+		cgltf_buffer_view *sparseViews = (result == cgltf_result_success)? LoadGLTFSparseAccessors(data, &sparseViewCount, fileName) : NULL;
+		if (stats != NULL) AddGLTFStageTime(&stats->bufferTime, &stageStart);
+
+		if (result != cgltf_result_success)
+		{
+			// NOTE: Accessors can't be read without their buffers data
+			TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to load mesh/material buffers", fileName);
+			cgltf_free(data);
+			RL_FREE(files.files);
+			RL_FREE(basePathDir);
+			return upload;
+		}
+
+        for (int i=0;i<data->nodes_count;i++) {
+            TRACELOG(LOG_DEBUG, "node mesh %d %s", data->nodes[i].mesh, data->nodes[i].name);
+        }
+
+		// NOTE: With arenas, pModel arrays are allocated from pModel arena and loading temporary data from scratch arena,
+		// otherwise both are NULL and every array is allocated with RL_MALLOC()
+		GLTFArena *arena = ((loadOptions != NULL) && loadOptions->arena)? LoadGLTFArena(GetGLTFArenaSize(data)) : NULL;
+		GLTFArena *scratch = ((loadOptions != NULL) && loadOptions->arena)? LoadGLTFArena(0) : NULL;
+		model.arena = arena;
+		upload.scratch = scratch;
+
+		// NOTE: Mesh arrays freed once uploaded are loading temporary data too (allocated from scratch arena)
+		unsigned int freeMeshData = (loadOptions != NULL)? loadOptions->freeMeshData : 0;
+		upload.freeMeshData = freeMeshData;
+		upload.vertexLayout = (loadOptions != NULL)? loadOptions->vertexLayout : GLTF_VERTEX_LAYOUT_SEPARATE;
+
+		mesh_id_starts = AllocGLTFArray(scratch, data->meshes_count, sizeof(int));
+		mesh_id_ends = AllocGLTFArray(scratch, data->meshes_count, sizeof(int));
+
+		int primitivesCount = 0;
+		// NOTE: We will load every primitive in the glTF as a separate raylib mesh
+		for (unsigned int i = 0; i < data->meshes_count; i++) primitivesCount += (int)data->meshes[i].primitives_count;
+
+		// Load our pModel data: meshes and materials
+		model.meshCount = primitivesCount;
+		model.meshes = AllocGLTFArray(arena, model.meshCount, sizeof(Mesh));
+
+		// NOTE: We keep an extra slot for default material, in case some mesh requires it
+		model.materialCount = (int)data->materials_count + 1;
+		model.materials = AllocGLTFArray(arena, model.materialCount, sizeof(Material));
+		model.materials[0] = LoadMaterialDefault();     // Load default material (index: 0)
+
+		// Load mesh-material indices, by default all meshes are mapped to material index: 0
+		model.meshMaterial = AllocGLTFArray(arena, model.meshCount, sizeof(int));
+
+		model.meshBounds = AllocGLTFArray(arena, model.meshCount, sizeof(BoundingBox));
+		for (int i = 0; i < model.meshCount; i++) model.meshBounds[i] = EmptyBoundingBox();
+
+		// NOTE: Quantized vertex attributes (KHR_mesh_quantization) are uploaded to GPU as they are, unless dequantized
+		bool keepQuantized = (loadOptions == NULL) || !loadOptions->dequantize;
+		upload.meshAttributes = AllocGLTFArray(scratch, model.meshCount*GLTF_VERTEX_ATTRIBUTES + 1, sizeof(GLTFVertexAttribute));
+
+		// Load materials images, decoded in parallel, every image is decoded and uploaded once
+		//----------------------------------------------------------------------------------------------------
+		GLTFImageJob *imageJobs = AllocGLTFArray(scratch, data->images_count + 1, sizeof(GLTFImageJob));
+		bool transcode = (loadOptions != NULL) && (loadOptions->transcodeImage != NULL);
+
+		// NOTE: Images encoded data loading and decoding is the images stage, the rest of the conversion is the meshes stage
+		if (stats != NULL) AddGLTFStageTime(&stats->meshTime, &stageStart);
+
+		int duplicatedImages = RequestGLTFMaterialImages(imageJobs, data, transcode);
+
+		// NOTE: Images already in the asset cache are not loaded, their textures are shared
+		// Transcoded images depend on the transcoding pixel format, it's part of their keys
+		GLTFAssetCache *assetCache = (loadOptions != NULL)? loadOptions->assetCache : NULL;
+		int keyFormat = transcode? loadOptions->textureFormat : -1;
+		uint64_t keySeed = GetGLTFHash((const unsigned char *)&keyFormat, sizeof(int), GLTF_HASH_SEED);
+
+		// NOTE: KTX2 images failing to be transcoded are replaced by their textures fallback images (second pass)
+		for (int pass = 0; pass < (transcode? 2 : 1); pass++)
+		{
+			if (pass > 0) RequestGLTFMaterialImages(imageJobs, data, transcode);
+
+			bool requested = false;
+			for (unsigned int i = 0; i < data->images_count; i++)
+			{
+				if (!imageJobs[i].requested || imageJobs[i].loaded) continue;
+
+				if (assetCache != NULL) LoadGLTFAssetImageJob(&imageJobs[i], data, &data->images[i], gltfPath, assetCache, keySeed);
+				else LoadGLTFImageJob(&imageJobs[i], data, &data->images[i], gltfPath);
+				requested = true;
+			}
+
+			if (requested) DecodeGLTFImages(imageJobs, (int)data->images_count, loadOptions);
+		}
+
+		// Keep decoded images to be uploaded to GPU, textures are shared by the materials using them
+		model.textureCount = (int)data->images_count;
+		model.textures = AllocGLTFArray(arena, model.textureCount + 1, sizeof(Texture2D));
+		model.assetCache = assetCache;
+		upload.imageCount = model.textureCount;
+		upload.images = AllocGLTFArray(scratch, upload.imageCount + 1, sizeof(Image));
+		if (assetCache != NULL) upload.imageKeys = AllocGLTFArray(scratch, upload.imageCount + 1, sizeof(uint64_t));
+
+		for (int i = 0; i < upload.imageCount; i++)
+		{
+			UnloadGLTFImageJob(&imageJobs[i], data);
+			upload.images[i] = imageJobs[i].image;
+			model.textures[i] = imageJobs[i].texture;
+			if (upload.imageKeys != NULL) upload.imageKeys[i] = imageJobs[i].key;
+		}
+
+		if (stats != NULL)
+		{
+			for (int i = 0; i < upload.imageCount; i++) if (upload.images[i].data != NULL) stats->texturesDecoded++;
+			for (int i = 0; i < upload.imageCount; i++) if (model.textures[i].id != 0) stats->sharedTextures++;
+			stats->duplicatedImages = duplicatedImages;
+			AddGLTFStageTime(&stats->imageTime, &stageStart);
+		}
+
+		RL_FREE(basePathDir);
+
+		upload.materialImages = AllocGLTFArray(scratch, model.materialCount*MAX_MATERIAL_MAPS, sizeof(int));
+		for (int i = 0; i < model.materialCount*MAX_MATERIAL_MAPS; i++) upload.materialImages[i] = -1;
+
+		// Load materials data
+		//----------------------------------------------------------------------------------------------------
+		for (unsigned int i = 0, j = 1; i < data->materials_count; i++, j++)
+		{
+			model.materials[j] = LoadMaterialDefault();
+
+			// Check glTF material flow: PBR metallic/roughness flow
+			// NOTE: Alternatively, materials can follow PBR specular/glossiness flow
+			if (data->materials[i].has_pbr_metallic_roughness)
+			{
+				// Load base color texture (albedo)
+				if (data->materials[i].pbr_metallic_roughness.base_color_texture.texture)
+				{
+					upload.materialImages[j*MAX_MATERIAL_MAPS + MATERIAL_MAP_ALBEDO] = GetGLTFImageIndex(imageJobs, data, data->materials[i].pbr_metallic_roughness.base_color_texture.texture, transcode);
+				}
+				// Load base color factor (tint)
+				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.r = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[0]*255);
+				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.g = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[1]*255);
+				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.b = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[2]*255);
+				model.materials[j].maps[MATERIAL_MAP_ALBEDO].color.a = (unsigned char)(data->materials[i].pbr_metallic_roughness.base_color_factor[3]*255);
+
+				// Load metallic/roughness texture
+				if (data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture)
+				{
+					upload.materialImages[j*MAX_MATERIAL_MAPS + MATERIAL_MAP_ROUGHNESS] = GetGLTFImageIndex(imageJobs, data, data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture, transcode);
+
+					// Load metallic/roughness material properties
+					float roughness = data->materials[i].pbr_metallic_roughness.roughness_factor;
+					model.materials[j].maps[MATERIAL_MAP_ROUGHNESS].value = roughness;
+
+					float metallic = data->materials[i].pbr_metallic_roughness.metallic_factor;
+					model.materials[j].maps[MATERIAL_MAP_METALNESS].value = metallic;
+				}
+
+				// Load normal texture
+				if (data->materials[i].normal_texture.texture)
+				{
+					upload.materialImages[j*MAX_MATERIAL_MAPS + MATERIAL_MAP_NORMAL] = GetGLTFImageIndex(imageJobs, data, data->materials[i].normal_texture.texture, transcode);
+				}
+
+				// Load ambient occlusion texture
+				if (data->materials[i].occlusion_texture.texture)
+				{
+					upload.materialImages[j*MAX_MATERIAL_MAPS + MATERIAL_MAP_OCCLUSION] = GetGLTFImageIndex(imageJobs, data, data->materials[i].occlusion_texture.texture, transcode);
+				}
+
+				// Load emissive texture
+				if (data->materials[i].emissive_texture.texture)
+				{
+					upload.materialImages[j*MAX_MATERIAL_MAPS + MATERIAL_MAP_EMISSION] = GetGLTFImageIndex(imageJobs, data, data->materials[i].emissive_texture.texture, transcode);
+
+					// Load emissive color factor
+					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.r = (unsigned char)(data->materials[i].emissive_factor[0]*255);
+					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.g = (unsigned char)(data->materials[i].emissive_factor[1]*255);
+					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.b = (unsigned char)(data->materials[i].emissive_factor[2]*255);
+					model.materials[j].maps[MATERIAL_MAP_EMISSION].color.a = 255;
+				}
+			}
+
+			// Other possible materials not supported by raylib pipeline:
+			// has_clearcoat, has_transmission, has_volume, has_ior, has specular, has_sheen
+		}
+		LoadGLTFMaterialLods(&model, data, arena);
+		FreeGLTFArray(scratch, imageJobs);
+
+        TRACELOG(LOG_DEBUG,"%x",data->meshes);
+
+		// Load meshes data, every primitive is decoded into its own mesh slot by a pool of worker threads
+		//----------------------------------------------------------------------------------------------------
+		GLTFPrimitiveQueue primitives = { 0 };
+		primitives.jobs = AllocGLTFArray(scratch, primitivesCount + 1, sizeof(GLTFPrimitiveJob));
+		primitives.meshes = model.meshes;
+		primitives.meshBounds = model.meshBounds;
+		primitives.meshAttributes = upload.meshAttributes;
+
+		// NOTE: Morph targets are only allocated if some triangles primitive has them
+		for (unsigned int i = 0; (i < data->meshes_count) && (model.meshMorphs == NULL); i++)
+		{
+			for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
+			{
+				const cgltf_primitive *primitive = &data->meshes[i].primitives[p];
+				if ((primitive->type == cgltf_primitive_type_triangles) && (primitive->targets_count > 0)) model.meshMorphs = AllocGLTFArray(arena, model.meshCount, sizeof(GLTFMorphTargets));
+				if (model.meshMorphs != NULL) break;
+			}
+		}
+		primitives.meshMorphs = model.meshMorphs;
+		primitives.arena = arena;
+		primitives.scratch = scratch;
+		primitives.freeMeshData = freeMeshData;
+		primitives.mappedFiles = &files;
+		primitives.keepQuantized = keepQuantized;
+		primitives.fileName = fileName;
+
+		int workerJobs = 0;
+		for (unsigned int i = 0; i < data->meshes_count; i++)
+		{
+			for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
+			{
+				// NOTE: We only support primitives defined by triangles
+				// Other alternatives: points, lines, line_strip, triangle_strip
+				const cgltf_primitive *primitive = &data->meshes[i].primitives[p];
+				if (primitive->type != cgltf_primitive_type_triangles) continue;
+
+				GLTFPrimitiveJob *job = &primitives.jobs[primitives.jobCount];
+				job->primitive = primitive;
+				job->slot = primitives.jobCount++;
+
+				// NOTE: Draco compressed primitives accessors have no buffer views, they are loaded with the indices
+				job->draco = primitive->has_draco_mesh_compression;
+				job->split = (primitive->indices != NULL) && (primitive->indices->component_type == cgltf_component_type_r_32u) && (GetGLTFPrimitiveVertexCount(primitive) > 65536);
+				if (!job->draco) workerJobs++;
+			}
+		}
+
+		// NOTE: Model and scratch arenas are shared by the workers while decoding, their allocations are locked
+		int meshThreads = (loadOptions != NULL)? loadOptions->meshThreads : 0;
+#if defined(RGLTF_SUPPORT_THREADS)
+		pthread_mutex_t arenaLock;
+		pthread_mutex_init(&arenaLock, NULL);
+		pthread_mutex_init(&primitives.lock, NULL);
+		if (arena != NULL) arena->lock = &arenaLock;
+		if (scratch != NULL) scratch->lock = &arenaLock;
+#endif
+		RunGLTFWorkers(LoadGLTFPrimitivesWorker, &primitives, meshThreads, workerJobs);
+#if defined(RGLTF_SUPPORT_THREADS)
+		if (arena != NULL) arena->lock = NULL;
+		if (scratch != NULL) scratch->lock = NULL;
+		pthread_mutex_destroy(&primitives.lock);
+		pthread_mutex_destroy(&arenaLock);
+#endif
+
+		// Load Draco compressed primitives, on the calling thread so the decoder callback doesn't need to be thread safe
+		for (int k = 0; k < primitives.jobCount; k++)
+		{
+			GLTFPrimitiveJob *job = &primitives.jobs[k];
+			if (!job->draco) continue;
+
+			if (job->primitive->targets_count > 0) TRACELOG(LOG_WARNING, "MODEL: [%s] Draco compressed primitives morph targets not supported, targets skipped", fileName);
+			LoadGLTFDracoPrimitive(&model.meshes[job->slot], &model.meshBounds[job->slot], &job->indices32, data, job->primitive, job->slot, loadOptions, fileName, arena, scratch);
+			if (job->indices32 != NULL) job->subMeshes = SplitGLTFIndices(job->indices32, (int)job->primitive->indices->count, model.meshes[job->slot].vertexCount, &job->subMeshCount, scratch);
+		}
+
+		// Get primitives first mesh (prefix sum of primitives mesh count), split primitives meshes are
+		// placed consecutively so they are still in the glTF mesh interval (node meshStart/meshEnd)
+		int splitMeshCount = 0;
+		for (int k = 0; k < primitives.jobCount; k++)
+		{
+			GLTFPrimitiveJob *job = &primitives.jobs[k];
+			job->meshIndex = job->slot + splitMeshCount;
+			job->meshCount = (job->subMeshCount > 1)? job->subMeshCount : 1;
+			splitMeshCount += job->meshCount - 1;
+
+			if (job->indices32 != NULL) TRACELOG(LOG_INFO, "MODEL: [%s] Primitive with %i vertices split in %i meshes (u16 indices)", fileName, model.meshes[job->slot].vertexCount, job->subMeshCount);
+		}
+
+		if (splitMeshCount > 0)
+		{
+			int meshCount = model.meshCount + splitMeshCount;
+			model.meshes = ReallocGLTFArray(arena, model.meshes, model.meshCount*sizeof(Mesh), meshCount*sizeof(Mesh));
+			model.meshMaterial = ReallocGLTFArray(arena, model.meshMaterial, model.meshCount*sizeof(int), meshCount*sizeof(int));
+			model.meshBounds = ReallocGLTFArray(arena, model.meshBounds, model.meshCount*sizeof(BoundingBox), meshCount*sizeof(BoundingBox));
+			upload.meshAttributes = ReallocGLTFArray(scratch, upload.meshAttributes, (model.meshCount*GLTF_VERTEX_ATTRIBUTES + 1)*sizeof(GLTFVertexAttribute), (meshCount*GLTF_VERTEX_ATTRIBUTES + 1)*sizeof(GLTFVertexAttribute));
+			if (model.meshMorphs != NULL) model.meshMorphs = ReallocGLTFArray(arena, model.meshMorphs, model.meshCount*sizeof(GLTFMorphTargets), meshCount*sizeof(GLTFMorphTargets));
+
+			// NOTE: Every not loaded mesh slot is empty, so the new ones are added at the end
+			for (int k = model.meshCount; k < meshCount; k++)
+			{
+				model.meshes[k] = (Mesh){ 0 };
+				model.meshMaterial[k] = 0;
+				model.meshBounds[k] = EmptyBoundingBox();
+				if (model.meshMorphs != NULL) model.meshMorphs[k] = (GLTFMorphTargets){ 0 };
+				for (int a = 0; a < GLTF_VERTEX_ATTRIBUTES; a++) upload.meshAttributes[k*GLTF_VERTEX_ATTRIBUTES + a] = (GLTFVertexAttribute){ 0 };
+			}
+
+			model.meshCount = meshCount;
+
+			// Move primitives meshes to their first mesh, from the last primitive so no mesh is overwritten before being moved
+			for (int k = primitives.jobCount - 1; (k >= 0) && (primitives.jobs[k].meshIndex != primitives.jobs[k].slot); k--)
+			{
+				const GLTFPrimitiveJob *job = &primitives.jobs[k];
+
+				model.meshes[job->meshIndex] = model.meshes[job->slot];
+				model.meshBounds[job->meshIndex] = model.meshBounds[job->slot];
+				memcpy(&upload.meshAttributes[job->meshIndex*GLTF_VERTEX_ATTRIBUTES], &upload.meshAttributes[job->slot*GLTF_VERTEX_ATTRIBUTES], GLTF_VERTEX_ATTRIBUTES*sizeof(GLTFVertexAttribute));
+				if (model.meshMorphs != NULL) model.meshMorphs[job->meshIndex] = model.meshMorphs[job->slot];
+
+				model.meshes[job->slot] = (Mesh){ 0 };
+				model.meshBounds[job->slot] = EmptyBoundingBox();
+				if (model.meshMorphs != NULL) model.meshMorphs[job->slot] = (GLTFMorphTargets){ 0 };
+				for (int a = 0; a < GLTF_VERTEX_ATTRIBUTES; a++) upload.meshAttributes[job->slot*GLTF_VERTEX_ATTRIBUTES + a] = (GLTFVertexAttribute){ 0 };
+			}
+		}
+
+		// Split primitives with too many vertices for u16 indices in several meshes
+		for (int k = 0; k < primitives.jobCount; k++)
+		{
+			GLTFPrimitiveJob *job = &primitives.jobs[k];
+			if (job->indices32 == NULL) continue;
+
+			Mesh mesh = model.meshes[job->meshIndex];
+			GLTFMorphTargets morph = (model.meshMorphs != NULL)? model.meshMorphs[job->meshIndex] : (GLTFMorphTargets){ 0 };
+			GLTFVertexAttribute attributes[GLTF_VERTEX_ATTRIBUTES];
+			memcpy(attributes, &upload.meshAttributes[job->meshIndex*GLTF_VERTEX_ATTRIBUTES], sizeof(attributes));
+
+			for (int s = 0; s < job->subMeshCount; s++)
+			{
+				int meshIndex = job->meshIndex + s;
+				model.meshes[meshIndex] = GetGLTFSubMesh(&mesh, &job->subMeshes[s], arena, scratch, freeMeshData);
+				model.meshBounds[meshIndex] = GetMeshBoundingBox(model.meshes[meshIndex]);
+
+				if (model.meshMorphs != NULL)
+				{
+					model.meshMorphs[meshIndex] = GetGLTFSubMeshMorphTargets(&morph, &job->subMeshes[s], arena);
+					model.meshBounds[meshIndex] = GetGLTFMorphBounds(model.meshBounds[meshIndex], &model.meshMorphs[meshIndex]);
+				}
+
+				for (int a = 0; a < GLTF_VERTEX_ATTRIBUTES; a++)
+				{
+					GLTFVertexAttribute *attribute = &upload.meshAttributes[meshIndex*GLTF_VERTEX_ATTRIBUTES + a];
+					*attribute = attributes[a];
+					if (attributes[a].data == NULL) continue;
+
+					attribute->data = AllocGLTFArray(scratch, job->subMeshes[s].vertexCount, attributes[a].elementSize);
+					GatherGLTFVertices(attribute->data, attributes[a].data, job->subMeshes[s].vertexMap, job->subMeshes[s].vertexCount, attributes[a].elementSize);
+				}
+
+				FreeGLTFArray(scratch, job->subMeshes[s].vertexMap);
+				FreeGLTFArray(scratch, job->subMeshes[s].indices);
+			}
+
+			// NOTE: Without triangles, the primitive is loaded as an empty mesh
+			if (job->subMeshCount == 0)
+			{
+				model.meshes[job->meshIndex] = (Mesh){ 0 };
+				if (model.meshMorphs != NULL) model.meshMorphs[job->meshIndex] = (GLTFMorphTargets){ 0 };
+				for (int a = 0; a < GLTF_VERTEX_ATTRIBUTES; a++) upload.meshAttributes[job->meshIndex*GLTF_VERTEX_ATTRIBUTES + a] = (GLTFVertexAttribute){ 0 };
+			}
+
+			UnloadGLTFMeshData(mesh, scratch);
+			UnloadGLTFMorphTargets(morph, scratch);
+			for (int a = 0; a < GLTF_VERTEX_ATTRIBUTES; a++) FreeGLTFArray(scratch, attributes[a].data);
+
+			FreeGLTFArray(scratch, job->subMeshes);
+			FreeGLTFArray(scratch, job->indices32);
+		}
+
+		for (int i = 0; i < model.meshCount; i++) model.meshes[i].vboId = (unsigned int *)AllocGLTFArray(arena, MAX_MESH_VERTEX_BUFFERS, sizeof(unsigned int));
+
+		// Morph targets deltas of every vertex are uploaded as a vertex attribute of the morphed meshes
+		for (int i = 0; (model.meshMorphs != NULL) && (i < model.meshCount); i++)
+		{
+			if (model.meshMorphs[i].deltaCount > 0) upload.meshAttributes[i*GLTF_VERTEX_ATTRIBUTES + GLTF_VERTEX_ATTRIBUTE_MORPH] = GetGLTFMorphAttribute(&model.meshMorphs[i], model.meshes[i].vertexCount, scratch);
+		}
+
+		// Assign to every primitive mesh the corresponding material index, and get glTF meshes intervals
+		// NOTE: If no material defined, mesh uses the already assigned default material (index: 0)
+		// The primitive actually keeps the pointer to the corresponding material, raylib instead assigns
+		// to the mesh its index, as loaded in model.materials array (skipping index 0, the default material)
+		for (int i = 0, k = 0, meshIndex = 0; i < (int)data->meshes_count; i++)
+		{
+			mesh_id_starts[i] = meshIndex;
+			for (unsigned int p = 0; p < data->meshes[i].primitives_count; p++)
+			{
+				if (data->meshes[i].primitives[p].type != cgltf_primitive_type_triangles) continue;
+
+				const GLTFPrimitiveJob *job = &primitives.jobs[k++];
+				int materialIndex = (job->primitive->material != NULL)? (int)(job->primitive->material - data->materials) + 1 : 0;
+
+				for (int s = 0; s < job->meshCount; s++) model.meshMaterial[job->meshIndex + s] = materialIndex;
+				meshIndex = job->meshIndex + job->meshCount;
+			}
+			mesh_id_ends[i] = meshIndex;
+		}
+
+		// NOTE: Mapped files some mesh array points to are kept until the mesh is uploaded
+		for (int k = 0; k < primitives.jobCount; k++) files.keepMapped |= primitives.jobs[k].mapped;
+		FreeGLTFArray(scratch, primitives.jobs);
+        TRACELOG(LOG_DEBUG,"%x", data->meshes);
+
+		// Load node data
+		model.nodeCount = data->nodes_count;
+		model.nodes = AllocGLTFArray(arena, data->nodes_count, sizeof(GLTFNode));
+        TRACELOG(LOG_DEBUG,"Loading nodes %d", model.nodeCount);
+        TRACELOG(LOG_DEBUG,"-----------", model.nodeCount);
+		for (unsigned int i = 0; i < data->nodes_count; i++) {
+            if (data->nodes[i].mesh == NULL) {
+                model.nodes[i].meshStart = -1;
+                model.nodes[i].meshEnd = -1;
+            } else {
+                int mesh_id = (data->nodes[i].mesh - data->meshes);
+                TRACELOG(LOG_DEBUG, "Mesh: %x %x %d %d", data->nodes[i].mesh, data->meshes, mesh_id,
+                         data->meshes_count);
+                model.nodes[i].meshStart = mesh_id_starts[mesh_id];
+                model.nodes[i].meshEnd = mesh_id_ends[mesh_id];
+            }
+
+            model.nodes[i].childrenCount = data->nodes[i].children_count;
+            model.nodes[i].children = AllocGLTFArray(arena, model.nodes[i].childrenCount, sizeof(int));
+            for (unsigned  int j = 0; j < data->nodes[i].children_count; j++)
+                model.nodes[i].children[j]=data->nodes[i].children[j]-data->nodes;
+            Matrix matScale;
+			Matrix matRotation;
+			Matrix matTranslation;
+
+			if (data->nodes[i].has_translation) {
+				model.nodes[i].transform.translation.x = data->nodes[i].translation[0];
+				model.nodes[i].transform.translation.y = data->nodes[i].translation[1];
+				model.nodes[i].transform.translation.z = data->nodes[i].translation[2];
+				matTranslation = MatrixTranslate(model.nodes[i].transform.translation.x,
+												 model.nodes[i].transform.translation.y,
+												 model.nodes[i].transform.translation.z);
+			} else
+				matTranslation = MatrixIdentity();
+			if (data->nodes[i].has_rotation) {
+				model.nodes[i].transform.rotation.x = data->nodes[i].rotation[0];
+				model.nodes[i].transform.rotation.y = data->nodes[i].rotation[1];
+				model.nodes[i].transform.rotation.z = data->nodes[i].rotation[2];
+				model.nodes[i].transform.rotation.w = data->nodes[i].rotation[3];
+				matRotation = QuaternionToMatrix(model.nodes[i].transform.rotation);
+			} else {
+				model.nodes[i].transform.rotation = QuaternionIdentity();
+				matRotation = MatrixIdentity();
+			}
+
+			if (data->nodes[i].has_scale) {
+				model.nodes[i].transform.scale.x = data->nodes[i].scale[0];
+				model.nodes[i].transform.scale.y = data->nodes[i].scale[1];
+				model.nodes[i].transform.scale.z = data->nodes[i].scale[2];
+				matScale = MatrixScale(model.nodes[i].transform.scale.x,
+									   model.nodes[i].transform.scale.y,
+									   model.nodes[i].transform.scale.z);
+			} else {
+				model.nodes[i].transform.scale.x = 1;
+				model.nodes[i].transform.scale.y = 1;
+				model.nodes[i].transform.scale.z = 1;
+				matScale = MatrixIdentity();
+			}
+			model.nodes[i].transformMatrix = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+
+			LoadGLTFNodeInstances(&model.nodes[i], data, &data->nodes[i], fileName, arena);
+			LoadGLTFNodeLods(&model.nodes[i], &model, data, &data->nodes[i], arena);
+			LoadGLTFNodeWeights(&model.nodes[i], &data->nodes[i], arena);
+			model.nodes[i].skin = ((data->nodes[i].skin != NULL) && (data->nodes[i].mesh != NULL))? (int)(data->nodes[i].skin - data->skins) : -1;
+		}
+
+		// Load skins, their joint matrices are computed with the initial world transforms
+		model.skinCount = (int)data->skins_count;
+		model.skins = AllocGLTFArray(arena, data->skins_count, sizeof(GLTFSkin));
+		for (unsigned int i = 0; i < data->skins_count; i++) LoadGLTFSkin(&model.skins[i], data, &data->skins[i], fileName, arena, scratch);
+
+		// Load animations keyframe tracks
+		model.animationCount = (int)data->animations_count;
+		model.animations = AllocGLTFArray(arena, data->animations_count, sizeof(GLTFAnimation));
+		for (unsigned int i = 0; i < data->animations_count; i++) LoadGLTFAnimation(&model.animations[i], data, &data->animations[i], fileName, arena, scratch);
+
+		// Flatten node hierarchy and compute the initial world transforms
+		SortGLTFNodes(&model, scratch);
+		model.worldTransforms = AllocGLTFArray(arena, data->nodes_count, sizeof(Matrix));
+		for (int i = 0; i < model.nodeCount; i++) model.nodes[i].dirty = true;
+		model.transformsDirty = true;
+		UpdateGLTFModelTransforms(&model);
+        TRACELOG(LOG_DEBUG,"Loading scene");
+
+		// Load scene data
+		if (data->scenes_count > 0) {
+			model.scene = (data->scene - data->scenes);
+			model.sceneCount = data->scenes_count;
+			model.scenes = AllocGLTFArray(arena, data->scenes_count, sizeof(GLTFScene));
+			memset(model.scenes, 0, sizeof(GLTFScene) * data->scenes_count);
+			for (unsigned int i = 0; i < data->scenes_count; i++) {
+				model.scenes[i].nodeCount = data->scenes[i].nodes_count;
+				model.scenes[i].nodes = AllocGLTFArray(arena, data->scenes[i].nodes_count, sizeof(int));
+				for (unsigned int j = 0; j < data->scenes[i].nodes_count; j++) {
+					model.scenes[i].nodes[j] = (data->scenes[i].nodes[j] - data->nodes);
+				}
+			}
+		}
+
+		FreeGLTFArray(scratch, mesh_id_starts);
+		FreeGLTFArray(scratch, mesh_id_ends);
+
+		// Free all cgltf loaded data
+		cgltf_free(data);
+		UnloadGLTFSparseAccessors(sparseViews, sparseViewCount);
+
+		if (stats != NULL) AddGLTFStageTime(&stats->meshTime, &stageStart);
+	}
+	else TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to load glTF data", fileName);
+
+	if (files.keepMapped)
+	{
+		upload.mappedFiles = files;
+		upload.mappedFiles.options = NULL;
+	}
+	else RL_FREE(files.files);
+
+	upload.model = model;
+
+	return upload;
+}
+
+// Draw queue used by the immediate draw functions (DrawGLTFModel(), DrawGLTFScene()...), released by UnloadGLTFDrawQueue()
+// NOTE: Its memory is reused by every immediate draw, they must be called from the main thread (like any raylib draw)
+static GLTFDrawList drawQueue = { 0 };
+
+// Multiply a material color by a tint color
+static Color TintColor(Color color, Color tint)
+{
+	Color colorTint = WHITE;
+	colorTint.r = (unsigned char) ((((float) color.r / 255.0) * ((float) tint.r / 255.0)) * 255.0f);
+	colorTint.g = (unsigned char) ((((float) color.g / 255.0) * ((float) tint.g / 255.0)) * 255.0f);
+	colorTint.b = (unsigned char) ((((float) color.b / 255.0) * ((float) tint.b / 255.0)) * 255.0f);
+	colorTint.a = (unsigned char) ((((float) color.a / 255.0) * ((float) tint.a / 255.0)) * 255.0f);
+	return colorTint;
+}
+
+// Compute the tinted diffuse color of every model material, once per material instead of once per mesh
+static const Color *TintGLTFMaterialColors(GLTFDrawList *list, GLTFModel model, Color tint)
+{
+	if (list->colorCapacity < model.materialCount) {
+		list->colorCapacity = model.materialCount;
+		list->colors = RL_REALLOC(list->colors, list->colorCapacity*sizeof(Color));
+	}
+	for (int i = 0; i < model.materialCount; i++) list->colors[i] = TintColor(model.materials[i].maps[MATERIAL_MAP_DIFFUSE].color, tint);
+	return list->colors;
+}
+
+// Get first index of a pModel mesh in its index buffer, meshes in the shared pModel buffers start at their range
+static int GetGLTFMeshFirstIndex(const GLTFModel *model, int mesh)
+{
+	return (model->meshFirstIndex != NULL)? model->meshFirstIndex[mesh] : 0;
+}
+
+static GLTFDrawItem *AddGLTFDrawItem(GLTFDrawList *list, const Mesh *mesh, int firstIndex, const Material *material, Color color, Matrix transform)
+{
+	if (list->itemCount >= list->itemCapacity) {
+		list->itemCapacity = (list->itemCapacity > 0)? list->itemCapacity*2 : 64;
+		list->items = RL_REALLOC(list->items, list->itemCapacity*sizeof(GLTFDrawItem));
+	}
+	GLTFDrawItem *item = &list->items[list->itemCount++];
+	item->mesh = mesh;
+	item->material = material;
+	item->color = color;
+	item->transform = transform;
+	item->firstIndex = firstIndex;
+	item->jointCount = 0;
+	item->jointStart = 0;
+	item->morphTargets = NULL;
+	item->weightStart = 0;
+	return item;
+}
+
+// Node transform and bounds relative to the parent of a draw list node subtree root
+struct GLTFDrawNode {
+	Matrix transform;            // Node transform without the subtree root ancestors
+	BoundingBox bounds;          // Node meshes bounds
+	BoundingBox subtreeBounds;   // Node subtree meshes bounds
+};
+
+// Get a joint matrix (transform*inverseBind) as its 3 first rows, (r, c) element of a raylib matrix is m[c*4 + r]
+static void GetGLTFJointMatrixRows(Matrix inverseBind, Matrix transform, float *rows)
+{
+	float16 ibm = MatrixToFloatV(inverseBind);
+	float16 joint = MatrixToFloatV(transform);
+	const float *a = ibm.v;
+	const float *b = joint.v;
+
+	for (int r = 0; r < 3; r++) {
+		rows[r*4 + 0] = b[r]*a[0] + b[4 + r]*a[1] + b[8 + r]*a[2];
+		rows[r*4 + 1] = b[r]*a[4] + b[4 + r]*a[5] + b[8 + r]*a[6];
+		rows[r*4 + 2] = b[r]*a[8] + b[4 + r]*a[9] + b[8 + r]*a[10];
+		rows[r*4 + 3] = b[r]*a[12] + b[4 + r]*a[13] + b[8 + r]*a[14] + b[12 + r];
+	}
+}
+
+// Get the meshes bounds of a node placed with transform (including its instances)
+static BoundingBox GetGLTFNodeMeshBounds(const GLTFModel *model, int node_id, Matrix transform)
+{
+	const GLTFNode *node = &model->nodes[node_id];
+	BoundingBox bounds = EmptyBoundingBox();
+
+	for (int j = node->meshStart; j < node->meshEnd; j++) {
+		if (node->instanceCount == 0) bounds = MergeBoundingBoxes(bounds, TransformBoundingBox(model->meshBounds[j], transform));
+		else for (int n = 0; n < node->instanceCount; n++) {
+			Matrix instanceTransform = MatrixMultiply(node->instanceTransforms[n], transform);
+			bounds = MergeBoundingBoxes(bounds, TransformBoundingBox(model->meshBounds[j], instanceTransform));
+		}
+	}
+	return bounds;
+}
+
+// Get the meshes bounds of a skinned node from its skin joint matrices palette (3 rows per joint)
+// NOTE: Skinned vertices are weighted blends of their joint transforms, so they are inside the bounds of the meshes
+// transformed by every joint, the node transform is ignored (like when drawing) but its instances are not
+static BoundingBox GetGLTFSkinnedNodeMeshBounds(const GLTFModel *model, int node_id, const float *jointMatrices)
+{
+	const GLTFNode *node = &model->nodes[node_id];
+	const GLTFSkin *skin = &model->skins[node->skin];
+	BoundingBox bounds = EmptyBoundingBox();
+
+	for (int j = 0; j < skin->jointCount; j++) {
+		const float *rows = &jointMatrices[j*12];
+		Matrix joint = { rows[0], rows[1], rows[2], rows[3], rows[4], rows[5], rows[6], rows[7], rows[8], rows[9], rows[10], rows[11], 0.0f, 0.0f, 0.0f, 1.0f };
+
+		for (int k = node->meshStart; k < node->meshEnd; k++) {
+			BoundingBox jointBounds = TransformBoundingBox(model->meshBounds[k], joint);
+			if (node->instanceCount == 0) bounds = MergeBoundingBoxes(bounds, jointBounds);
+			else for (int n = 0; n < node->instanceCount; n++) bounds = MergeBoundingBoxes(bounds, TransformBoundingBox(jointBounds, node->instanceTransforms[n]));
+		}
+	}
+	return bounds;
+}
+
+// Get a joint transform relative to the parent of a draw list node subtree root (root_id), joints out of the
+// subtree are placed by their local transforms up to that parent, joints not below it keep their world transform
+static Matrix GetGLTFDrawListJointTransform(const GLTFDrawList *list, const GLTFModel *model, int root_id, int joint_id)
+{
+	const GLTFNode *root = &model->nodes[root_id];
+	const GLTFNode *joint = &model->nodes[joint_id];
+	if ((joint->orderStart >= root->orderStart) && (joint->orderStart < root->orderEnd)) return list->nodes[joint->orderStart - root->orderStart].transform;
+
+	Matrix transform = MatrixIdentity();
+	int node_id = joint_id;
+	for (; (node_id >= 0) && (node_id != root->parent); node_id = model->nodes[node_id].parent) transform = MatrixMultiply(transform, model->nodes[node_id].transformMatrix);
+
+	return (node_id >= 0)? transform : model->worldTransforms[joint_id];
+}
+
+// Forget the skins copied to the draw list by the previously added pModel, before adding a pModel
+static void ResetGLTFDrawListSkins(GLTFDrawList *list, GLTFModel model)
+{
+	if (list->skinCapacity < model.skinCount) {
+		list->skinCapacity = model.skinCount;
+		list->skinStarts = RL_REALLOC(list->skinStarts, list->skinCapacity*sizeof(int));
+	}
+	for (int i = 0; i < model.skinCount; i++) list->skinStarts[i] = -1;
+}
+
+// Copy a pModel skin joint matrices to the draw list (once per added pModel), so items keep the current pose,
+// returns the skin joint matrices position in the draw list
+// NOTE: Skins of a node subtree added without its ancestors (root_id >= 0) are posed relative to the root parent
+static int AddGLTFDrawListSkin(GLTFDrawList *list, const GLTFModel *model, int skin_id, int root_id)
+{
+	const GLTFSkin *skin = &model->skins[skin_id];
+
+	if (list->skinStarts[skin_id] < 0) {
+		if (list->jointCount + skin->jointCount > list->jointCapacity) {
+			list->jointCapacity = (list->jointCapacity > 0)? list->jointCapacity*2 : 256;
+			if (list->jointCapacity < list->jointCount + skin->jointCount) list->jointCapacity = list->jointCount + skin->jointCount;
+			list->jointMatrices = RL_REALLOC(list->jointMatrices, list->jointCapacity*12*sizeof(float));
+		}
+		if (root_id < 0) memcpy(&list->jointMatrices[list->jointCount*12], skin->jointMatrices, skin->jointCount*12*sizeof(float));
+		else for (int j = 0; j < skin->jointCount; j++) {
+			Matrix transform = GetGLTFDrawListJointTransform(list, model, root_id, skin->joints[j]);
+			GetGLTFJointMatrixRows(skin->inverseBindMatrices[j], transform, &list->jointMatrices[(list->jointCount + j)*12]);
+		}
+		list->skinStarts[skin_id] = list->jointCount;
+		list->jointCount += skin->jointCount;
+	}
+
+	return list->skinStarts[skin_id];
+}
+
+// Set the skin joint matrices a draw list item is drawn with
+static void SetGLTFDrawItemSkin(GLTFDrawList *list, GLTFDrawItem *item, GLTFModel model, int skin_id, int root_id)
+{
+	item->jointStart = AddGLTFDrawListSkin(list, &model, skin_id, root_id);
+	item->jointCount = model.skins[skin_id].jointCount;
+}
+
+// Get the transforms of a node subtree nodes relative to the node parent, so the subtree is placed without its
+// ancestors (indexed by sorted position from the node orderStart), bounds are only computed for culling and
+// levels of detail
+// NOTE: Parents come first, every node transform is one multiply by its parent relative transform. Skins of
+// skinned nodes are copied to the draw list to get their bounds, call it after ResetGLTFDrawListSkins()
+static const GLTFDrawNode *GetGLTFDrawListSubtree(GLTFDrawList *list, const GLTFModel *model, int node_id, bool bounds)
+{
+	const GLTFNode *root = &model->nodes[node_id];
+	int count = root->orderEnd - root->orderStart;
+
+	if (list->nodeCapacity < count) {
+		list->nodeCapacity = count;
+		list->nodes = RL_REALLOC(list->nodes, list->nodeCapacity*sizeof(GLTFDrawNode));
+	}
+
+	GLTFDrawNode *nodes = list->nodes;
+	for (int k = 0; k < count; k++) {
+		const GLTFNode *node = &model->nodes[model->sortedNodes[root->orderStart + k]];
+		if (k == 0) nodes[k].transform = node->transformMatrix;
+		else nodes[k].transform = MatrixMultiply(node->transformMatrix, nodes[model->nodes[node->parent].orderStart - root->orderStart].transform);
+		if (node->lodCount > 0) bounds = true;
+	}
+	if (!bounds) return nodes;
+
+	for (int k = 0; k < count; k++) {
+		int id = model->sortedNodes[root->orderStart + k];
+		int skin_id = model->nodes[id].skin;
+		if ((skin_id >= 0) && (skin_id < model->skinCount)) {
+			int jointStart = AddGLTFDrawListSkin(list, model, skin_id, node_id);
+			nodes[k].bounds = GetGLTFSkinnedNodeMeshBounds(model, id, &list->jointMatrices[jointStart*12]);
+		}
+		else nodes[k].bounds = GetGLTFNodeMeshBounds(model, id, nodes[k].transform);
+		nodes[k].subtreeBounds = nodes[k].bounds;
+	}
+	for (int k = count - 1; k > 0; k--) {
+		const GLTFNode *node = &model->nodes[model->sortedNodes[root->orderStart + k]];
+		GLTFDrawNode *parent = &nodes[model->nodes[node->parent].orderStart - root->orderStart];
+		parent->subtreeBounds = MergeBoundingBoxes(parent->subtreeBounds, nodes[k].subtreeBounds);
+	}
+	return nodes;
+}
+
+// Get morph targets a pModel mesh is drawn with (NULL: no morph targets or deltas texture not uploaded)
+static const GLTFMorphTargets *GetGLTFDrawMorphTargets(const GLTFModel *model, int mesh)
+{
+	if ((model->meshMorphs == NULL) || (model->meshMorphs[mesh].textureId == 0)) return NULL;
+
+	return &model->meshMorphs[mesh];
+}
+
+// Copy morph target weights to the draw list (padded with zeros to a multiple of 4), returns their first weight
+// NOTE: Missing weights are zeros, so items never blend the weights uploaded for a previous item
+static int AddGLTFDrawListWeights(GLTFDrawList *list, const float *weights, int weightCount, int targetCount)
+{
+	int count = (targetCount + 3) & ~3;
+	if (list->weightCount + count > list->weightCapacity) {
+		list->weightCapacity = (list->weightCapacity > 0)? list->weightCapacity*2 : 256;
+		if (list->weightCapacity < list->weightCount + count) list->weightCapacity = list->weightCount + count;
+		list->weights = RL_REALLOC(list->weights, list->weightCapacity*sizeof(float));
+	}
+
+	int start = list->weightCount;
+	for (int i = 0; i < count; i++) list->weights[start + i] = (i < weightCount)? weights[i] : 0.0f;
+	list->weightCount += count;
+	return start;
+}
+
+// Get the view frustum planes of a model-view-projection matrix, planes point inwards
+// NOTE: Planes are defined in the space the combined matrix transforms from
+static void GetFrustumPlanes(Matrix mat, Vector4 *planes)
+{
+	Vector4 rowX = { mat.m0, mat.m4, mat.m8, mat.m12 };
+	Vector4 rowY = { mat.m1, mat.m5, mat.m9, mat.m13 };
+	Vector4 rowZ = { mat.m2, mat.m6, mat.m10, mat.m14 };
+	Vector4 rowW = { mat.m3, mat.m7, mat.m11, mat.m15 };
+
+	planes[0] = (Vector4){ rowW.x + rowX.x, rowW.y + rowX.y, rowW.z + rowX.z, rowW.w + rowX.w };     // Left
+	planes[1] = (Vector4){ rowW.x - rowX.x, rowW.y - rowX.y, rowW.z - rowX.z, rowW.w - rowX.w };     // Right
+	planes[2] = (Vector4){ rowW.x + rowY.x, rowW.y + rowY.y, rowW.z + rowY.z, rowW.w + rowY.w };     // Bottom
+	planes[3] = (Vector4){ rowW.x - rowY.x, rowW.y - rowY.y, rowW.z - rowY.z, rowW.w - rowY.w };     // Top
+	planes[4] = (Vector4){ rowW.x + rowZ.x, rowW.y + rowZ.y, rowW.z + rowZ.z, rowW.w + rowZ.w };     // Near
+	planes[5] = (Vector4){ rowW.x - rowZ.x, rowW.y - rowZ.y, rowW.z - rowZ.z, rowW.w - rowZ.w };     // Far
+}
+
+#define FRUSTUM_OUTSIDE     0
+#define FRUSTUM_INTERSECT   1
+#define FRUSTUM_INSIDE      2
+
+// Check a bounding box against the frustum planes
+// NOTE: Empty boxes are not culled, meshes with unsupported positions format have no bounds
+static int CheckFrustumBox(const Vector4 *planes, BoundingBox box)
+{
+	if (box.min.x > box.max.x) return FRUSTUM_INTERSECT;    // Empty box, bounds not known
+
+	int result = FRUSTUM_INSIDE;
+	for (int i = 0; i < 6; i++) {
+		// Box corners farthest along and against the plane normal
+		Vector3 positive = { (planes[i].x > 0)? box.max.x : box.min.x, (planes[i].y > 0)? box.max.y : box.min.y, (planes[i].z > 0)? box.max.z : box.min.z };
+		Vector3 negative = { (planes[i].x > 0)? box.min.x : box.max.x, (planes[i].y > 0)? box.min.y : box.max.y, (planes[i].z > 0)? box.min.z : box.max.z };
+
+		if (planes[i].x*positive.x + planes[i].y*positive.y + planes[i].z*positive.z + planes[i].w < 0) return FRUSTUM_OUTSIDE;
+		if (planes[i].x*negative.x + planes[i].y*negative.y + planes[i].z*negative.z + planes[i].w < 0) result = FRUSTUM_INTERSECT;
+	}
+	return result;
+}
+
+// Get pModel space to clip space transform of the current rlgl matrices, used to select levels of detail
+// NOTE: Draw lists are expected to be drawn with the same matrices (inside the same BeginMode3D())
+static Matrix GetGLTFLodTransform(Matrix transform)
+{
+	Matrix matModelView = MatrixMultiply(MatrixMultiply(transform, rlGetMatrixTransform()), rlGetMatrixModelview());
+	return MatrixMultiply(matModelView, rlGetMatrixProjection());
+}
+
+// Update the level of detail of a node from its screen coverage, levels change only past the hysteresis margin
+// NOTE: Coverage is the node subtree bounding sphere projected diameter over viewport height, lodTransform
+// transforms the bounds space to clip space. The level drawn last is kept by the drawn pModel instance (lodLevel),
+// without it the level is selected from the coverage only (no hysteresis)
+static int UpdateGLTFNodeLodLevel(const GLTFNode *node, BoundingBox subtreeBounds, Matrix lodTransform, int *lodLevel)
+{
+	Vector3 center = Vector3Scale(Vector3Add(subtreeBounds.min, subtreeBounds.max), 0.5f);
+	float radius = Vector3Distance(subtreeBounds.max, center);
+
+	// Clip space height of a pModel space unit, divided by clip w at the sphere center (1 with orthographic projections)
+	float scale = sqrtf(lodTransform.m1*lodTransform.m1 + lodTransform.m5*lodTransform.m5 + lodTransform.m9*lodTransform.m9);
+	float w = lodTransform.m3*center.x + lodTransform.m7*center.y + lodTransform.m11*center.z + lodTransform.m15;
+	float coverage = (w > 0.0f)? radius*scale/w : FLT_MAX;
+
+	if (lodLevel == NULL)
+	{
+		int level = 0;
+		while ((level <= node->lodCount) && (coverage < node->lodCoverage[level])) level++;
+		return level;
+	}
+
+	int level = *lodLevel;
+	if (level < 0) level = 0;
+	if (level > node->lodCount + 1) level = node->lodCount + 1;
+	while ((level > 0) && (coverage >= node->lodCoverage[level - 1]*(1.0f + GLTF_LOD_HYSTERESIS))) level--;
+	while ((level <= node->lodCount) && (coverage < node->lodCoverage[level]*(1.0f - GLTF_LOD_HYSTERESIS))) level++;
+
+	*lodLevel = level;
+	return level;
+}
+
+// Get the material of a level of detail, materials without that many levels use their lowest one
+static int GetGLTFMaterialLod(const GLTFModel *model, int material, int level)
+{
+	if ((level == 0) || (model->materialLodStart == NULL)) return material;
+
+	int levels = model->materialLodStart[material + 1] - model->materialLodStart[material];
+	if (levels == 0) return material;
+
+	return model->materialLods[model->materialLodStart[material] + ((level < levels)? level : levels) - 1];
+}
+
+// Add the meshes of nodes in range [orderStart, orderEnd) of the sorted node array, using cached world transforms
+// and bounds, or the transforms and bounds of the node subtree starting at orderStart if provided
+// NOTE: If frustum planes are provided, node subtrees outside the frustum are skipped, if a pModel space to clip
+// space transform is provided, nodes with levels of detail are drawn at the level of their screen coverage
+static void AddGLTFSortedNodesToDrawList(GLTFDrawList *list, GLTFModel model, int orderStart, int orderEnd, Matrix matTransform, const Color *colors, const Vector4 *planes, const Matrix *lodTransform, const GLTFDrawNode *subtree)
+{
+	int root_id = (subtree != NULL)? model.sortedNodes[orderStart] : -1;
+	int insideEnd = orderStart;     // Nodes before this position are known to be inside the frustum
+	int visited = 0;
+	int culled = 0;
+
+	for (int k = orderStart; k < orderEnd; k++) {
+		int node_id = model.sortedNodes[k];
+		const GLTFNode *node = &model.nodes[node_id];
+		const GLTFDrawNode *relative = (subtree != NULL)? &subtree[k - orderStart] : NULL;
+		visited++;
+
+		if (planes != NULL && k >= insideEnd) {
+			int frustum = CheckFrustumBox(planes, (relative != NULL)? relative->subtreeBounds : node->subtreeBounds);
+			if (frustum == FRUSTUM_OUTSIDE) {
+				culled += node->orderEnd - k;
+				k = node->orderEnd - 1;     // Skip the whole subtree
+				continue;
+			}
+			if (frustum == FRUSTUM_INSIDE) insideEnd = node->orderEnd;
+			else if (CheckFrustumBox(planes, (relative != NULL)? relative->bounds : node->bounds) == FRUSTUM_OUTSIDE) {
+				culled++;
+				continue;
+			}
+		}
+
+		int level = 0;
+		if ((lodTransform != NULL) && (node->lodCount > 0)) {
+			int *lodLevel = ((list->lodLevels != NULL) && (node_id < list->lodLevelCount))? &list->lodLevels[node_id] : NULL;
+			level = UpdateGLTFNodeLodLevel(node, (relative != NULL)? relative->subtreeBounds : node->subtreeBounds, *lodTransform, lodLevel);
+			if (level > node->lodCount) {
+				culled += node->orderEnd - k;
+				k = node->orderEnd - 1;     // Too small to be drawn, skip the whole subtree
+				continue;
+			}
+
+			// Lower level nodes replace the node subtree, they are root nodes placed relative to the node parent
+			int lod_id = (level > 0)? node->lodNodes[level - 1] : -1;
+			if (lod_id >= 0) {
+				Matrix lodMatTransform = matTransform;
+				if (relative != NULL) {
+					if (k > orderStart) lodMatTransform = MatrixMultiply(subtree[model.nodes[node->parent].orderStart - orderStart].transform, matTransform);
+				}
+				else if (node->parent >= 0) lodMatTransform = MatrixMultiply(model.worldTransforms[node->parent], matTransform);
+				AddGLTFSortedNodesToDrawList(list, model, model.nodes[lod_id].orderStart, model.nodes[lod_id].orderEnd, lodMatTransform, colors, NULL, NULL, NULL);
+				k = node->orderEnd - 1;
+				continue;
+			}
+		}
+		if (node->meshStart >= node->meshEnd) continue;
+
+		// NOTE: Skinned meshes ignore their node transform, joint matrices place them in pModel space
+		bool skinned = (node->skin >= 0) && (node->skin < model.skinCount);
+		Matrix nodeTransform = skinned? matTransform : MatrixMultiply((relative != NULL)? relative->transform : model.worldTransforms[node_id], matTransform);
+		int weightStart = -1;       // Node morph target weights in the draw list, copied once for all its meshes
+		for (int j = node->meshStart; j < node->meshEnd; j++) {
+			int m = GetGLTFMaterialLod(&model, model.meshMaterial[j], level);
+			int firstIndex = GetGLTFMeshFirstIndex(&model, j);
+			const GLTFMorphTargets *morph = GetGLTFDrawMorphTargets(&model, j);
+			if ((morph != NULL) && (weightStart < 0)) weightStart = AddGLTFDrawListWeights(list, node->weights, node->weightCount, (node->weightCount > morph->targetCount)? node->weightCount : morph->targetCount);
+			int instanceCount = (node->instanceCount > 0)? node->instanceCount : 1;
+			for (int n = 0; n < instanceCount; n++) {
+				Matrix transform = (node->instanceCount > 0)? MatrixMultiply(node->instanceTransforms[n], nodeTransform) : nodeTransform;
+				GLTFDrawItem *item = AddGLTFDrawItem(list, &model.meshes[j], firstIndex, &model.materials[m], colors[m], transform);
+				if (skinned) SetGLTFDrawItemSkin(list, item, model, node->skin, root_id);
+				if (morph != NULL) {
+					item->morphTargets = morph;
+					item->weightStart = weightStart;
+				}
+			}
+		}
+	}
+
+	if (list->stats != NULL) {
+		list->stats->nodesVisited += visited;
+		list->stats->nodesCulled += culled;
+	}
+}
+
+// Load a draw list
+GLTFDrawList LoadGLTFDrawList(int capacity)
+{
+	GLTFDrawList list = { 0 };
+	if (capacity > 0) {
+		list.itemCapacity = capacity;
+		list.items = RL_MALLOC(capacity*sizeof(GLTFDrawItem));
+	}
+	return list;
+}
+
+// Unload draw list
+void UnloadGLTFDrawList(GLTFDrawList list)
+{
+	RL_FREE(list.items);
+	RL_FREE(list.colors);
+	RL_FREE(list.jointMatrices);
+	RL_FREE(list.skinStarts);
+	RL_FREE(list.weights);
+	RL_FREE(list.instances);
+	RL_FREE(list.nodes);
+}
+
+// Remove all draw list items
+void ClearGLTFDrawList(GLTFDrawList *list)
+{
+	list->itemCount = 0;
+	list->jointCount = 0;
+	list->weightCount = 0;
+}
+
+// Add a Model's node meshes to draw list
+// NOTE: Cached world transforms are used, call UpdateGLTFModelTransforms() after changing node transforms
+void AddGLTFNodeToDrawList(GLTFDrawList *list, GLTFModel model, int node_id, Matrix transform, Color tint)
+{
+	if (node_id < 0 || node_id >= model.nodeCount) return;
+
+	Matrix lodTransform = GetGLTFLodTransform(transform);
+	const Color *colors = TintGLTFMaterialColors(list, model, tint);
+	ResetGLTFDrawListSkins(list, model);
+
+	// World transforms include the node ancestors, but transform replaces them: the subtree of nodes with
+	// ancestors is placed by transforms relative to the node parent
+	const GLTFDrawNode *subtree = (model.nodes[node_id].parent >= 0)? GetGLTFDrawListSubtree(list, &model, node_id, false) : NULL;
+	AddGLTFSortedNodesToDrawList(list, model, model.nodes[node_id].orderStart, model.nodes[node_id].orderEnd, transform, colors, NULL, &lodTransform, subtree);
+}
+
+// Add a Model's scene meshes to draw list
+// NOTE: Levels of detail are selected with the current view and projection, add scenes inside BeginMode3D()
+void AddGLTFSceneToDrawList(GLTFDrawList *list, GLTFModel model, int scene_id, Matrix transform, Color tint)
+{
+	if (scene_id < 0 || scene_id >= model.sceneCount) return;
+
+	Matrix lodTransform = GetGLTFLodTransform(transform);
+	const Color *colors = TintGLTFMaterialColors(list, model, tint);
+	ResetGLTFDrawListSkins(list, model);
+	for (int i = 0; i < model.scenes[scene_id].nodeCount; i++) {
+		int node_id = model.scenes[scene_id].nodes[i];
+		if (node_id < 0 || node_id >= model.nodeCount) continue;
+
+		// Scene nodes are root nodes, their world transforms don't include any ancestor
+		AddGLTFSortedNodesToDrawList(list, model, model.nodes[node_id].orderStart, model.nodes[node_id].orderEnd, transform, colors, NULL, &lodTransform, NULL);
+	}
+}
+
+// Add a Model's scene meshes inside the view frustum to draw list
+// NOTE: Levels of detail are selected with viewProjection too
+void AddGLTFSceneToDrawListCulled(GLTFDrawList *list, GLTFModel model, int scene_id, Matrix transform, Matrix viewProjection, Color tint)
+{
+	if (scene_id < 0 || scene_id >= model.sceneCount) return;
+
+	// Frustum planes in pModel space, so node bounds can be tested without transforming them
+	Matrix lodTransform = MatrixMultiply(transform, viewProjection);
+	Vector4 planes[6];
+	GetFrustumPlanes(lodTransform, planes);
+
+	const Color *colors = TintGLTFMaterialColors(list, model, tint);
+	ResetGLTFDrawListSkins(list, model);
+	for (int i = 0; i < model.scenes[scene_id].nodeCount; i++) {
+		int node_id = model.scenes[scene_id].nodes[i];
+		if (node_id < 0 || node_id >= model.nodeCount) continue;
+
+		AddGLTFSortedNodesToDrawList(list, model, model.nodes[node_id].orderStart, model.nodes[node_id].orderEnd, transform, colors, planes, &lodTransform, NULL);
+	}
+}
+
+// Draw items order: by shader, then by material, then by mesh
+static int CompareGLTFDrawItems(const void *a, const void *b)
+{
+	const GLTFDrawItem *itemA = (const GLTFDrawItem *)a;
+	const GLTFDrawItem *itemB = (const GLTFDrawItem *)b;
+
+	if (itemA->material->shader.id != itemB->material->shader.id) return (itemA->material->shader.id < itemB->material->shader.id)? -1 : 1;
+	if (itemA->material != itemB->material) return ((uintptr_t)itemA->material < (uintptr_t)itemB->material)? -1 : 1;
+	if (itemA->mesh != itemB->mesh) return ((uintptr_t)itemA->mesh < (uintptr_t)itemB->mesh)? -1 : 1;
+	return 0;
+}
+
+// Bind material texture maps, only changing the texture slots that differ from the bound ones
+// NOTE: Passing a NULL material unbinds all texture slots
+static void BindMaterialMaps(const Material *material, unsigned int *boundTextures)
+{
+	for (int i = 0; i < MAX_MATERIAL_MAPS; i++) {
+		unsigned int textureId = (material != NULL)? material->maps[i].texture.id : 0;
+		if (textureId == boundTextures[i]) continue;
+
+		bool cubemap = (i == MATERIAL_MAP_IRRADIANCE) || (i == MATERIAL_MAP_PREFILTER) || (i == MATERIAL_MAP_CUBEMAP);
+		rlActiveTextureSlot(i);
+		if (textureId > 0) {
+			if (cubemap) rlEnableTextureCubemap(textureId);
+			else rlEnableTexture(textureId);
+			rlSetUniform(material->shader.locs[SHADER_LOC_MAP_DIFFUSE + i], &i, SHADER_UNIFORM_INT, 1);
+		} else {
+			if (cubemap) rlDisableTextureCubemap();
+			else rlDisableTexture();
+		}
+		boundTextures[i] = textureId;
+	}
+}
+
+// Morph targets deltas texture slot, after the material maps slots
+#define GLTF_MORPH_TEXTURE_SLOT     MAX_MATERIAL_MAPS
+
+// Bind morph targets deltas texture to its texture slot and set the shader sampler (if location available)
+// NOTE: Passing a 0 texture unbinds the texture slot
+static void BindGLTFMorphTexture(unsigned int textureId, int location)
+{
+	int slot = GLTF_MORPH_TEXTURE_SLOT;
+	rlActiveTextureSlot(slot);
+	if (textureId > 0) {
+		rlEnableTexture(textureId);
+		if (location != -1) rlSetUniform(location, &slot, SHADER_UNIFORM_INT, 1);
+	}
+	else rlDisableTexture();
+}
+
+// Check if mesh is drawn with indices, CPU indices could be freed once uploaded (GLTFLoadOptions.freeMeshData)
+static bool IsGLTFMeshIndexed(const Mesh *mesh)
+{
+	return (mesh->indices != NULL) || ((mesh->vboId != NULL) && (mesh->vboId[GLTF_VERTEX_BUFFER_INDICES] != 0));
+}
+
+// Bind mesh vertex buffers to the shader attribute locations
+static void BindMeshBuffers(const Mesh *mesh, const Shader *shader)
+{
+	// Try binding vertex array objects (VAO) or use VBOs if not possible
+	if (rlEnableVertexArray(mesh->vaoId)) return;
+
+	// Bind mesh VBO data: vertex position (shader-location = 0)
+	rlEnableVertexBuffer(mesh->vboId[0]);
+	rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_POSITION], 3, RL_FLOAT, 0, 0, 0);
+	rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_POSITION]);
+
+	// Bind mesh VBO data: vertex texcoords (shader-location = 1)
+	rlEnableVertexBuffer(mesh->vboId[1]);
+	rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, 0, 0, 0);
+	rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+
+	if (shader->locs[SHADER_LOC_VERTEX_NORMAL] != -1) {
+		// Bind mesh VBO data: vertex normals (shader-location = 2)
+		rlEnableVertexBuffer(mesh->vboId[2]);
+		rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_NORMAL], 3, RL_FLOAT, 0, 0, 0);
+		rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_NORMAL]);
+	}
+
+	// Bind mesh VBO data: vertex colors (shader-location = 3, if available)
+	if (shader->locs[SHADER_LOC_VERTEX_COLOR] != -1) {
+		if (mesh->vboId[3] != 0) {
+			rlEnableVertexBuffer(mesh->vboId[3]);
+			rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, 1, 0, 0);
+			rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_COLOR]);
+		} else {
+			// Set default value for unused attribute
+			float value[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			rlSetVertexAttributeDefault(shader->locs[SHADER_LOC_VERTEX_COLOR], value, SHADER_ATTRIB_VEC4, 4);
+			rlDisableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_COLOR]);
+		}
+	}
+
+	// Bind mesh VBO data: vertex tangents (shader-location = 4, if available)
+	if (shader->locs[SHADER_LOC_VERTEX_TANGENT] != -1) {
+		rlEnableVertexBuffer(mesh->vboId[4]);
+		rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TANGENT], 4, RL_FLOAT, 0, 0, 0);
+		rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TANGENT]);
+	}
+
+	// Bind mesh VBO data: vertex texcoords2 (shader-location = 5, if available)
+	if (shader->locs[SHADER_LOC_VERTEX_TEXCOORD02] != -1) {
+		rlEnableVertexBuffer(mesh->vboId[5]);
+		rlSetVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TEXCOORD02], 2, RL_FLOAT, 0, 0, 0);
+		rlEnableVertexAttribute(shader->locs[SHADER_LOC_VERTEX_TEXCOORD02]);
+	}
+
+	if (IsGLTFMeshIndexed(mesh)) rlEnableVertexBufferElement(mesh->vboId[6]);
+}
+
+// Get view-projection matrix of every eye (stereo rendering: view offset and projection per eye), returns eye count
+static int GetGLTFEyeViewProjections(Matrix matView, Matrix matProjection, Matrix *matEyeViewProjection)
+{
+	if (!rlIsStereoRenderEnabled()) {
+		matEyeViewProjection[0] = MatrixMultiply(matView, matProjection);
+		return 1;
+	}
+
+	for (int eye = 0; eye < 2; eye++) matEyeViewProjection[eye] = MatrixMultiply(MatrixMultiply(matView, rlGetMatrixViewOffsetStereo(eye)), rlGetMatrixProjectionStereo(eye));
+	return 2;
+}
+
+// Set viewport of a stereo rendering eye (left or right half of the framebuffer)
+static void SetGLTFEyeViewport(int eye)
+{
+	rlViewport(eye*rlGetFramebufferWidth()/2, 0, rlGetFramebufferWidth()/2, rlGetFramebufferHeight());
+}
+
+// Sort and draw draw list items
+// NOTE: Shader, material textures and mesh buffers are only bound when they change between items,
+// per item only the model dependant uniforms are uploaded (same uniforms as DrawMesh() uses)
+void DrawGLTFDrawList(GLTFDrawList *list)
+{
+	if (list->itemCount == 0) return;
+
+	qsort(list->items, list->itemCount, sizeof(GLTFDrawItem), CompareGLTFDrawItems);
+
+	// Get a copy of current matrices to work with
+	Matrix matView = rlGetMatrixModelview();
+	Matrix matProjection = rlGetMatrixProjection();
+	Matrix matEyeViewProjection[2];
+	int eyeCount = GetGLTFEyeViewProjections(matView, matProjection, matEyeViewProjection);
+	Matrix matStack = rlGetMatrixTransform();
+
+	unsigned int boundTextures[MAX_MATERIAL_MAPS] = { 0 };
+	const Shader *shader = NULL;
+	const Material *material = NULL;
+	const Mesh *mesh = NULL;
+	Color color = { 0 };
+	int jointMatricesLoc = -2;      // Skinning shader joint matrices location (-2: not queried yet)
+	int jointStart = -1;            // First joint matrix uploaded to the shader
+	int morphDeltasLoc = -2;        // Morph targets shader deltas sampler location (-2: not queried yet)
+	int morphWeightsLoc = -2;       // Morph targets shader weights location
+	unsigned int morphTexture = 0;  // Morph targets deltas texture bound to the shader
+	bool morphBound = false;        // Morph targets texture slot used, unbound once drawn
+	int weightStart = -1;           // First morph target weight uploaded to the shader
+	int shaderSwitches = 0;
+	int materialSwitches = 0;
+
+	for (int i = 0; i < list->itemCount; i++) {
+		const GLTFDrawItem *item = &list->items[i];
+
+		if (shader == NULL || item->material->shader.id != shader->id) {
+			// Texture sampler uniforms belong to the shader, force rebinding textures
+			if (shader != NULL) BindMaterialMaps(NULL, boundTextures);
+			shader = &item->material->shader;
+			material = NULL;
+			mesh = NULL;
+			jointMatricesLoc = -2;
+			jointStart = -1;
+			morphDeltasLoc = -2;
+			morphTexture = 0;
+			weightStart = -1;
+			shaderSwitches++;
+
+			// Bind shader program and upload view and projection matrices (if locations available)
+			rlEnableShader(shader->id);
+			if (shader->locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_VIEW], matView);
+			if (shader->locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_PROJECTION], matProjection);
+		}
+
+		if (item->material != material) {
+			material = item->material;
+			BindMaterialMaps(material, boundTextures);
+			materialSwitches++;
+
+			// Upload to shader material.colSpecular (if location available)
+			if (shader->locs[SHADER_LOC_COLOR_SPECULAR] != -1) {
+				float values[4] = {
+					(float)material->maps[MATERIAL_MAP_SPECULAR].color.r/255.0f,
+					(float)material->maps[MATERIAL_MAP_SPECULAR].color.g/255.0f,
+					(float)material->maps[MATERIAL_MAP_SPECULAR].color.b/255.0f,
+					(float)material->maps[MATERIAL_MAP_SPECULAR].color.a/255.0f
+				};
+				rlSetUniform(shader->locs[SHADER_LOC_COLOR_SPECULAR], values, SHADER_UNIFORM_VEC4, 1);
+			}
+
+			// Force uploading the tinted diffuse color
+			color = item->color;
+			color.a = ~color.a;
+		}
+
+		if (item->mesh != mesh) {
+			mesh = item->mesh;
+			BindMeshBuffers(mesh, shader);
+		}
+
+		// Upload to shader material.colDiffuse (if location available)
+		if (shader->locs[SHADER_LOC_COLOR_DIFFUSE] != -1 && memcmp(&color, &item->color, sizeof(Color)) != 0) {
+			float values[4] = {
+				(float)item->color.r/255.0f,
+				(float)item->color.g/255.0f,
+				(float)item->color.b/255.0f,
+				(float)item->color.a/255.0f
+			};
+			rlSetUniform(shader->locs[SHADER_LOC_COLOR_DIFFUSE], values, SHADER_UNIFORM_VEC4, 1);
+		}
+		color = item->color;
+
+		// Upload skin joint matrices (if location available), items of the same skin share them
+		if ((item->jointCount > 0) && (item->jointStart != jointStart)) {
+			if (jointMatricesLoc == -2) jointMatricesLoc = GetShaderLocation(*shader, GLTF_SHADER_UNIFORM_JOINT_MATRICES);
+			if (jointMatricesLoc != -1) rlSetUniform(jointMatricesLoc, &list->jointMatrices[item->jointStart*12], SHADER_UNIFORM_VEC4, item->jointCount*3);
+			jointStart = item->jointStart;
+		}
+
+		// Bind morph targets deltas texture and upload weights (if locations available), items of the same node share them
+		// NOTE: Not morphed vertices have no deltas, the bound texture and weights don't change them
+		if (item->morphTargets != NULL) {
+			if (morphDeltasLoc == -2) {
+				morphDeltasLoc = GetShaderLocation(*shader, GLTF_SHADER_UNIFORM_MORPH_DELTAS);
+				morphWeightsLoc = GetShaderLocation(*shader, GLTF_SHADER_UNIFORM_MORPH_WEIGHTS);
+			}
+			if (item->morphTargets->textureId != morphTexture) {
+				morphTexture = item->morphTargets->textureId;
+				BindGLTFMorphTexture(morphTexture, morphDeltasLoc);
+				morphBound = true;
+			}
+			if ((morphWeightsLoc != -1) && (item->weightStart != weightStart)) {
+				rlSetUniform(morphWeightsLoc, &list->weights[item->weightStart], SHADER_UNIFORM_VEC4, (item->morphTargets->targetCount + 3)/4);
+				weightStart = item->weightStart;
+			}
+		}
+
+		// Model transformation matrix is send to shader uniform location: SHADER_LOC_MATRIX_MODEL
+		if (shader->locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_MODEL], item->transform);
+
+		// Accumulate several model transformations
+		Matrix matModel = MatrixMultiply(item->transform, matStack);
+
+		// Upload model normal matrix (if locations available)
+		if (shader->locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(matModel)));
+
+		// Stereo rendering draws every item once per eye
+		for (int eye = 0; eye < eyeCount; eye++) {
+			if (eyeCount > 1) SetGLTFEyeViewport(eye);
+
+			// Send combined model-view-projection matrix to shader
+			rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(matModel, matEyeViewProjection[eye]));
+
+			// Draw mesh
+			if (IsGLTFMeshIndexed(mesh)) rlDrawVertexArrayElements(item->firstIndex, mesh->triangleCount*3, 0);
+			else rlDrawVertexArray(0, mesh->vertexCount);
+		}
+	}
+
+	// Unbind all binded texture maps
+	BindMaterialMaps(NULL, boundTextures);
+	if (morphBound) BindGLTFMorphTexture(0, -1);
+
+	// Disable all possible vertex array objects (or VBOs)
+	rlDisableVertexArray();
+	rlDisableVertexBuffer();
+	rlDisableVertexBufferElement();
+
+	// Disable shader program
+	rlDisableShader();
+
+	// Restore rlgl internal modelview and projection matrices
+	rlSetMatrixModelview(matView);
+	rlSetMatrixProjection(matProjection);
+
+	if (list->stats != NULL) {
+		list->stats->drawCalls += list->itemCount*eyeCount;
+		list->stats->shaderSwitches += shaderSwitches;
+		list->stats->materialSwitches += materialSwitches;
+	}
+}
+
+// Set draw statistics accumulated by the immediate draw functions (DrawGLTFModel(), DrawGLTFScene()...)
+// NOTE: Counters are accumulated until statistics are disabled (NULL), draw lists have their own (GLTFDrawList.stats)
+void SetGLTFDrawStats(GLTFDrawStats *stats)
+{
+	drawQueue.stats = stats;
+}
+
+// Set levels of detail of the pModel instance drawn by the next immediate draw functions calls (one per pModel node)
+// NOTE: Every drawn instance needs its own levels (zero initialized) for the hysteresis, set them before drawing it,
+// without them (NULL) levels are selected from the screen coverage only
+void SetGLTFDrawLodLevels(int *lodLevels, int count)
+{
+	drawQueue.lodLevels = lodLevels;
+	drawQueue.lodLevelCount = (lodLevels != NULL)? count : 0;
+}
+
+// Unload draw queue memory of the immediate draw functions, call it once done drawing (i.e. before CloseWindow())
+// NOTE: Draw statistics and levels of detail (SetGLTFDrawStats(), SetGLTFDrawLodLevels()) are kept, the queue grows again if something else is drawn
+void UnloadGLTFDrawQueue(void)
+{
+	GLTFDrawList settings = { 0 };
+	settings.stats = drawQueue.stats;
+	settings.lodLevelCount = drawQueue.lodLevelCount;
+	settings.lodLevels = drawQueue.lodLevels;
+
+	UnloadGLTFDrawList(drawQueue);
+	drawQueue = settings;
+}
+
+// Draw a pModel (with texture if set)
+void DrawGLTFModel(GLTFModel model, Vector3 position, float scale, Color tint)
+{
+	Vector3 vScale = { scale, scale, scale };
+	Vector3 rotationAxis = { 0.0f, 1.0f, 0.0f };
+
+	DrawGLTFModelEx(model, position, rotationAxis, 0.0f, vScale, tint);
+}
+
+// Draw a pModel with extended parameters
+void DrawGLTFModelEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+{
+	// Calculate transformation matrix from function parameters
+	// Get transform matrix (rotation -> scale -> translation)
+	Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
 	Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle*DEG2RAD);
 	Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
 
-	Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+	Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+
+	// Combine pModel transformation matrix (pModel.transform) with matrix generated by function parameters (matTransform)
+	model.transform = MatrixMultiply(model.transform, matTransform);
+	if (model.scene >= 0
+		&& model.scene < model.sceneCount
+		&& model.scenes[model.scene].nodeCount>0) { // we have a scene to draw
+		DrawGLTFScene(model, model.scene, model.transform, tint);
+	} else {
+		ClearGLTFDrawList(&drawQueue);
+		const Color *colors = TintGLTFMaterialColors(&drawQueue, model, tint);
+		for (int i = 0; i < model.meshCount; i++) {
+			GLTFDrawItem *item = AddGLTFDrawItem(&drawQueue, &model.meshes[i], GetGLTFMeshFirstIndex(&model, i), &model.materials[model.meshMaterial[i]], colors[model.meshMaterial[i]], model.transform);
+
+			// NOTE: Without nodes there are no weights, morphed meshes are drawn with zero weights
+			item->morphTargets = GetGLTFDrawMorphTargets(&model, i);
+			if (item->morphTargets != NULL) item->weightStart = AddGLTFDrawListWeights(&drawQueue, NULL, 0, item->morphTargets->targetCount);
+		}
+		DrawGLTFDrawList(&drawQueue);
+	}
+}
+
+// Draw a mesh once per instance transform like DrawMeshInstanced(), drawing its indices from firstIndex
+// NOTE: Used for meshes in the shared pModel buffers and indexed meshes with freed CPU indices,
+// raylib draws meshes without CPU indices as not indexed
+static void DrawGLTFMeshInstanced(const Mesh *mesh, int firstIndex, const Material *material, const Matrix *transforms, int count)
+{
+	const Shader *shader = &material->shader;
+	unsigned int boundTextures[MAX_MATERIAL_MAPS] = { 0 };
+
+	// Bind shader program
+	rlEnableShader(shader->id);
+
+	// Upload to shader material.colDiffuse and material.colSpecular (if locations available)
+	const int colorLocs[2] = { SHADER_LOC_COLOR_DIFFUSE, SHADER_LOC_COLOR_SPECULAR };
+	const int colorMaps[2] = { MATERIAL_MAP_DIFFUSE, MATERIAL_MAP_SPECULAR };
+	for (int i = 0; i < 2; i++) {
+		if (shader->locs[colorLocs[i]] == -1) continue;
+		Color color = material->maps[colorMaps[i]].color;
+		float values[4] = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+		rlSetUniform(shader->locs[colorLocs[i]], values, SHADER_UNIFORM_VEC4, 1);
+	}
+
+	// Get a copy of current matrices to work with, upload view and projection matrices (if locations available)
+	Matrix matView = rlGetMatrixModelview();
+	Matrix matProjection = rlGetMatrixProjection();
+	if (shader->locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_VIEW], matView);
+	if (shader->locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_PROJECTION], matProjection);
+
+	// Instance transforms are sent to shader attribute location: SHADER_LOC_MATRIX_MODEL (one vec4 per matrix column)
+	float16 *instanceTransforms = (float16 *)RL_MALLOC(count*sizeof(float16));
+	for (int i = 0; i < count; i++) instanceTransforms[i] = MatrixToFloatV(transforms[i]);
+
+	BindMeshBuffers(mesh, shader);
+	unsigned int instancesVboId = rlLoadVertexBuffer(instanceTransforms, count*sizeof(float16), false);
+	for (int i = 0; (shader->locs[SHADER_LOC_MATRIX_MODEL] != -1) && (i < 4); i++) {
+		rlEnableVertexAttribute(shader->locs[SHADER_LOC_MATRIX_MODEL] + i);
+		rlSetVertexAttribute(shader->locs[SHADER_LOC_MATRIX_MODEL] + i, 4, RL_FLOAT, 0, sizeof(Matrix), (void *)(i*sizeof(Vector4)));
+		rlSetVertexAttributeDivisor(shader->locs[SHADER_LOC_MATRIX_MODEL] + i, 1);
+	}
+	rlDisableVertexBuffer();
+
+	// Upload model normal matrix (if locations available), instance transforms are applied by the shader
+	if (shader->locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_NORMAL], MatrixIdentity());
+
+	BindMaterialMaps(material, boundTextures);
+
+	// Accumulate internal matrix transform (push/pop) and view matrix, draw once per eye
+	Matrix matEyeViewProjection[2];
+	int eyeCount = GetGLTFEyeViewProjections(matView, matProjection, matEyeViewProjection);
+	Matrix matStack = rlGetMatrixTransform();
+	for (int eye = 0; eye < eyeCount; eye++) {
+		if (eyeCount > 1) SetGLTFEyeViewport(eye);
+		rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(matStack, matEyeViewProjection[eye]));
+
+		if (IsGLTFMeshIndexed(mesh)) rlDrawVertexArrayElementsInstanced(firstIndex, mesh->triangleCount*3, 0, count);
+		else rlDrawVertexArrayInstanced(0, mesh->vertexCount, count);
+	}
+
+	BindMaterialMaps(NULL, boundTextures);
+	rlDisableVertexArray();
+	rlDisableVertexBufferElement();
+	rlDisableShader();
+
+	rlUnloadVertexBuffer(instancesVboId);
+	RL_FREE(instanceTransforms);
+}
+
+// Draw meshes [meshStart, meshEnd) once per instance transform, one instanced draw call per mesh
+// NOTE: Skinned meshes (skin_id >= 0) joint matrices and morphed meshes weights (NULL: zero weights) are uploaded first,
+// shader uniforms are kept by the shader program, so every instance is drawn with the same pose and weights
+static void DrawGLTFMeshesInstanced(GLTFModel model, int meshStart, int meshEnd, const Matrix *transforms, int count, const Color *colors, int skin_id, const float *weights, int weightCount)
+{
+	for (int j = meshStart; j < meshEnd; j++) {
+		Material *material = &model.materials[model.meshMaterial[j]];
+		if (skin_id >= 0) {
+			int loc = GetShaderLocation(material->shader, GLTF_SHADER_UNIFORM_JOINT_MATRICES);
+			rlEnableShader(material->shader.id);
+			if (loc != -1) rlSetUniform(loc, model.skins[skin_id].jointMatrices, SHADER_UNIFORM_VEC4, model.skins[skin_id].jointCount*3);
+		}
+
+		const GLTFMorphTargets *morph = GetGLTFDrawMorphTargets(&model, j);
+		if (morph != NULL) {
+			float morphWeights[GLTF_MAX_MORPH_TARGETS] = { 0 };
+			for (int t = 0; (t < weightCount) && (t < morph->targetCount); t++) morphWeights[t] = weights[t];
+
+			int weightsLoc = GetShaderLocation(material->shader, GLTF_SHADER_UNIFORM_MORPH_WEIGHTS);
+			rlEnableShader(material->shader.id);
+			if (weightsLoc != -1) rlSetUniform(weightsLoc, morphWeights, SHADER_UNIFORM_VEC4, (morph->targetCount + 3)/4);
+			BindGLTFMorphTexture(morph->textureId, GetShaderLocation(material->shader, GLTF_SHADER_UNIFORM_MORPH_DELTAS));
+		}
+
+		Color color = material->maps[MATERIAL_MAP_DIFFUSE].color;
+		material->maps[MATERIAL_MAP_DIFFUSE].color = colors[model.meshMaterial[j]];
+		if ((model.meshFirstIndex != NULL) || ((model.meshes[j].indices == NULL) && IsGLTFMeshIndexed(&model.meshes[j]))) DrawGLTFMeshInstanced(&model.meshes[j], GetGLTFMeshFirstIndex(&model, j), material, transforms, count);
+		else DrawMeshInstanced(model.meshes[j], *material, transforms, count);
+		material->maps[MATERIAL_MAP_DIFFUSE].color = color;
+
+		if (morph != NULL) BindGLTFMorphTexture(0, -1);
+	}
+
+	// NOTE: Every instanced mesh draw binds its shader and material
+	if (drawQueue.stats != NULL) {
+		drawQueue.stats->drawCalls += (meshEnd - meshStart)*(rlIsStereoRenderEnabled()? 2 : 1);
+		drawQueue.stats->shaderSwitches += meshEnd - meshStart;
+		drawQueue.stats->materialSwitches += meshEnd - meshStart;
+	}
+}
+
+// Get draw list instance transforms array with room for count transforms (contents not kept)
+static Matrix *ReserveGLTFDrawListInstances(GLTFDrawList *list, int count)
+{
+	if (list->instanceCapacity < count) {
+		list->instanceCapacity = count;
+		list->instances = RL_REALLOC(list->instances, list->instanceCapacity*sizeof(Matrix));
+	}
+	return list->instances;
+}
+
+// Draw a pModel many times with GPU instancing
+// NOTE: Every node world transform is combined with every instance transform, so draw calls
+// only depend on the number of primitives. Nodes with EXT_mesh_gpu_instancing data are drawn
+// once per node instance and per instance transform. Material shaders must support instancing.
+void DrawGLTFModelInstanced(GLTFModel model, const Matrix *transforms, int count, Color tint)
+{
+	if (transforms == NULL || count <= 0) return;
+
+	const Color *colors = TintGLTFMaterialColors(&drawQueue, model, tint);
+
+	if (model.scene < 0
+		|| model.scene >= model.sceneCount
+		|| model.scenes[model.scene].nodeCount == 0) {   // no scene to draw, draw all meshes
+		Matrix *instances = ReserveGLTFDrawListInstances(&drawQueue, count);
+		for (int n = 0; n < count; n++) instances[n] = MatrixMultiply(model.transform, transforms[n]);
+		DrawGLTFMeshesInstanced(model, 0, model.meshCount, instances, count, colors, -1, NULL, 0);
+		return;
+	}
+
+	const GLTFScene *scene = &model.scenes[model.scene];
+	for (int i = 0; i < scene->nodeCount; i++) {
+		int root_id = scene->nodes[i];
+		if (root_id < 0 || root_id >= model.nodeCount) continue;
+
+		if (drawQueue.stats != NULL) drawQueue.stats->nodesVisited += model.nodes[root_id].orderEnd - model.nodes[root_id].orderStart;
+
+		for (int k = model.nodes[root_id].orderStart; k < model.nodes[root_id].orderEnd; k++) {
+			int node_id = model.sortedNodes[k];
+			const GLTFNode *node = &model.nodes[node_id];
+			if (node->meshStart >= node->meshEnd) continue;
+
+			int nodeInstances = (node->instanceCount > 0)? node->instanceCount : 1;
+			Matrix *instances = ReserveGLTFDrawListInstances(&drawQueue, nodeInstances*count);
+
+			// NOTE: Skinned meshes ignore their node transform, joint matrices place them in pModel space
+			bool skinned = (node->skin >= 0) && (node->skin < model.skinCount);
+			Matrix nodeTransform = skinned? model.transform : MatrixMultiply(model.worldTransforms[node_id], model.transform);
+			for (int l = 0; l < nodeInstances; l++) {
+				Matrix localTransform = (node->instanceCount > 0)? MatrixMultiply(node->instanceTransforms[l], nodeTransform) : nodeTransform;
+				for (int n = 0; n < count; n++) instances[l*count + n] = MatrixMultiply(localTransform, transforms[n]);
+			}
+
+			DrawGLTFMeshesInstanced(model, node->meshStart, node->meshEnd, instances, nodeInstances*count, colors, skinned? node->skin : -1, node->weights, node->weightCount);
+		}
+	}
+}
+
+// Draw a pModel wires (with texture if set)
+void DrawGLTFModelWires(GLTFModel model, Vector3 position, float scale, Color tint)
+{
+	rlEnableWireMode();
+
+	DrawGLTFModel(model, position, scale, tint);
+
+	rlDisableWireMode();
+}
+
+// Draw a pModel wires (with texture if set) with extended parameters
+void DrawGLTFModelWiresEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+{
+	rlEnableWireMode();
+
+	DrawGLTFModelEx(model, position, rotationAxis, rotationAngle, scale, tint);
+
+	rlDisableWireMode();
+}
+
+// Draw a Model's node (with texture if set)
+// NOTE: Cached world transforms are used, call UpdateGLTFModelTransforms() after changing node transforms
+void DrawGLTFNode(GLTFModel model,int node_id, Matrix matTransform, Color tint) {
+    ClearGLTFDrawList(&drawQueue);
+    AddGLTFNodeToDrawList(&drawQueue, model, node_id, matTransform, tint);
+    DrawGLTFDrawList(&drawQueue);
+}
+
+// Draw a Model's scene wires (with texture if set)
+void DrawGLTFNodeWires(GLTFModel model, int node_id, Matrix matTransform, Color tint)
+{
+    rlEnableWireMode();
+
+    DrawGLTFNode(model, node_id, matTransform, tint);
+
+    rlDisableWireMode();
+}
+
+// Draw a Model's scene with extended parameters
+void DrawGLTFScene(GLTFModel model, int scene_id, Matrix matTransform, Color tint)
+{
+	ClearGLTFDrawList(&drawQueue);
+	AddGLTFSceneToDrawList(&drawQueue, model, scene_id, matTransform, tint);
+	DrawGLTFDrawList(&drawQueue);
+}
+
+// Draw a Model's scene, skipping node subtrees outside the view frustum
+// NOTE: Cached node bounds are used, call UpdateGLTFModelTransforms() after changing node transforms
+void DrawGLTFSceneCulled(GLTFModel model, int scene_id, Matrix matTransform, Matrix viewProjection, Color tint)
+{
+	ClearGLTFDrawList(&drawQueue);
+	AddGLTFSceneToDrawListCulled(&drawQueue, model, scene_id, matTransform, viewProjection, tint);
+	DrawGLTFDrawList(&drawQueue);
+}
+
+// Draw a Model's node, skipping node subtrees outside the view frustum
+void DrawGLTFNodeCulled(GLTFModel model, int node_id, Matrix matTransform, Matrix viewProjection, Color tint)
+{
+	if (node_id < 0 || node_id >= model.nodeCount) return;
+
+	Matrix lodTransform = MatrixMultiply(matTransform, viewProjection);
+	Vector4 planes[6];
+	GetFrustumPlanes(lodTransform, planes);
+
+	ClearGLTFDrawList(&drawQueue);
+	const Color *colors = TintGLTFMaterialColors(&drawQueue, model, tint);
+	ResetGLTFDrawListSkins(&drawQueue, model);
+
+	// World transforms include the node ancestors, but matTransform replaces them (see AddGLTFNodeToDrawList())
+	const GLTFDrawNode *subtree = (model.nodes[node_id].parent >= 0)? GetGLTFDrawListSubtree(&drawQueue, &model, node_id, true) : NULL;
+	AddGLTFSortedNodesToDrawList(&drawQueue, model, model.nodes[node_id].orderStart, model.nodes[node_id].orderEnd, matTransform, colors, planes, &lodTransform, subtree);
+	DrawGLTFDrawList(&drawQueue);
+}
+
+// Get camera view-projection matrix, computed the same way BeginMode3D() does
+Matrix GetGLTFCameraViewProjection(Camera camera, float aspect)
+{
+	Matrix matProjection = MatrixIdentity();
+	if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+		double top = camera.fovy/2.0;
+		double right = top*aspect;
+		matProjection = MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	} else {
+		matProjection = MatrixPerspective(camera.fovy*DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	}
+	Matrix matView = MatrixLookAt(camera.position, camera.target, camera.up);
+
+	return MatrixMultiply(matView, matProjection);
+}
+
+// Draw a Model's scene wires (with texture if set)
+void DrawGLTFSceneWires(GLTFModel model, int scene_id, Matrix matTransform, Color tint)
+{
+	rlEnableWireMode();
+
+	DrawGLTFScene(model, scene_id, matTransform, tint);
+
+	rlDisableWireMode();
+}
+
+// Set a Model's node local transform
+void SetGLTFNodeTransform(GLTFModel *model, int node_id, Transform transform)
+{
+	if (node_id < 0 || node_id >= model->nodeCount) return;
+
+	model->nodes[node_id].transform = transform;
+	model->nodes[node_id].transformMatrix = TransformToMatrix(transform);
+	model->nodes[node_id].dirty = true;
+	model->transformsDirty = true;
+}
+
+// Set a Model's node mesh morph target weights, weights beyond the mesh targets are ignored
+void SetGLTFNodeMorphWeights(GLTFModel *model, int node_id, const float *weights, int count)
+{
+	if (node_id < 0 || node_id >= model->nodeCount) return;
+
+	GLTFNode *node = &model->nodes[node_id];
+	for (int i = 0; (i < count) && (i < node->weightCount); i++) node->weights[i] = weights[i];
+}
+
+// Update every skin joint matrices palette from the joints world transforms, once per skin (shared by its meshes),
+// and the bounds of skinned nodes from their palette
+// NOTE: Joint matrices are affine, only their 3 first rows (column vector convention) are kept
+static void UpdateGLTFSkinJointMatrices(GLTFModel *model)
+{
+	for (int s = 0; s < model->skinCount; s++) {
+		const GLTFSkin *skin = &model->skins[s];
+
+		// Joint matrix = world * inverseBind
+		for (int j = 0; j < skin->jointCount; j++) GetGLTFJointMatrixRows(skin->inverseBindMatrices[j], model->worldTransforms[skin->joints[j]], &skin->jointMatrices[j*12]);
+	}
+
+	for (int i = 0; i < model->nodeCount; i++) {
+		int skin_id = model->nodes[i].skin;
+		if ((skin_id >= 0) && (skin_id < model->skinCount)) model->nodes[i].bounds = GetGLTFSkinnedNodeMeshBounds(model, i, model->skins[skin_id].jointMatrices);
+	}
+}
+
+#define GLTF_BVH_LEAF_SIZE      4       // Maximum number of items (triangles or node instances) of a BVH leaf
+#define GLTF_BVH_MAX_DEPTH      48      // Deeper BVH nodes are split in halves, so traversal stacks are bounded
+#define GLTF_BVH_STACK_SIZE     128
+
+// Bounding volume hierarchy node, children of inner nodes are placed after their parent
+typedef struct GLTFBVHNode {
+	BoundingBox bounds;             // Bounds of the node items
+	int first;                      // First item (leaf) or first child (inner node, second child is next one)
+	int count;                      // Number of items (0: inner node)
+} GLTFBVHNode;
+
+// Bounding volume hierarchy over items bounds, items of every leaf are contiguous in items array
+typedef struct GLTFBVH {
+	int nodeCount;                  // Number of nodes (0: no items)
+	GLTFBVHNode *nodes;             // Nodes array, root first
+	int *items;                     // Item ids sorted by leaf
+} GLTFBVH;
+
+// Node instance, the node meshes placed by one of the node instance transforms (or the node world transform)
+typedef struct GLTFBVHInstance {
+	int node;                       // Node id
+	int instance;                   // Node instance id (EXT_mesh_gpu_instancing, 0 if not instanced)
+	Matrix invTransform;            // pModel space to mesh space transform
+} GLTFBVHInstance;
+
+// Model acceleration structure: triangles BVH of every mesh (mesh space) and node instances BVH (pModel space)
+struct GLTFModelBVH {
+	GLTFBVH *meshes;                // Triangles BVH of every pModel mesh (empty if mesh vertices are not kept)
+	int instanceCount;              // Number of node instances
+	GLTFBVHInstance *instances;     // Node instances
+	BoundingBox *instanceBounds;    // Node instances bounds (pModel space)
+	int *nodeInstances;             // First instance of every node (-1: not in the pModel scene or without meshes)
+	GLTFBVH top;                    // Node instances BVH, refit when world transforms are updated
+};
+
+// Ray closest hit, ray distances are in ray direction units so hits in every space can be compared
+typedef struct GLTFRayHit {
+	float distance;                 // Hit distance (FLT_MAX: no hit)
+	int node;                       // Node hit
+	int instance;                   // Node instance hit
+	int mesh;                       // Mesh hit
+	int triangle;                   // Mesh triangle hit
+} GLTFRayHit;
+
+static float GetVector3Component(Vector3 v, int axis)
+{
+	return (axis == 0)? v.x : (axis == 1)? v.y : v.z;
+}
+
+// Build a BVH over items bounds, nodes are split at the middle of their items centers along their largest axis
+static void BuildGLTFBVH(GLTFBVH *bvh, const BoundingBox *bounds, int count)
+{
+	bvh->nodeCount = 0;
+	bvh->nodes = NULL;
+	bvh->items = NULL;
+	if (count <= 0) return;
+
+	bvh->nodes = RL_MALLOC((2*count - 1)*sizeof(GLTFBVHNode));
+	bvh->items = RL_MALLOC(count*sizeof(int));
+	int *depths = RL_MALLOC((2*count - 1)*sizeof(int));
+	for (int i = 0; i < count; i++) bvh->items[i] = i;
+
+	bvh->nodes[0].first = 0;
+	bvh->nodes[0].count = count;
+	depths[0] = 0;
+	bvh->nodeCount = 1;
+
+	// NOTE: Nodes are split in creation order, so children are always placed after their parent
+	for (int i = 0; i < bvh->nodeCount; i++) {
+		GLTFBVHNode *node = &bvh->nodes[i];
+		int end = node->first + node->count;
+
+		BoundingBox centers = EmptyBoundingBox();
+		node->bounds = EmptyBoundingBox();
+		for (int k = node->first; k < end; k++) {
+			BoundingBox box = bounds[bvh->items[k]];
+			Vector3 center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+			node->bounds = MergeBoundingBoxes(node->bounds, box);
+			centers = MergeBoundingBoxes(centers, (BoundingBox){ center, center });
+		}
+		if (node->count <= GLTF_BVH_LEAF_SIZE) continue;
+
+		Vector3 extent = Vector3Subtract(centers.max, centers.min);
+		int axis = ((extent.x >= extent.y) && (extent.x >= extent.z))? 0 : (extent.y >= extent.z)? 1 : 2;
+		float split = (GetVector3Component(centers.min, axis) + GetVector3Component(centers.max, axis))*0.5f;
+
+		int middle = node->first;
+		for (int k = node->first; (depths[i] < GLTF_BVH_MAX_DEPTH) && (k < end); k++) {
+			BoundingBox box = bounds[bvh->items[k]];
+			if ((GetVector3Component(box.min, axis) + GetVector3Component(box.max, axis))*0.5f >= split) continue;
+
+			int item = bvh->items[k];
+			bvh->items[k] = bvh->items[middle];
+			bvh->items[middle++] = item;
+		}
+		// Every item center on the same side (or node too deep): split items in halves
+		if ((middle == node->first) || (middle == end)) middle = node->first + node->count/2;
+
+		int left = bvh->nodeCount;
+		bvh->nodes[left] = (GLTFBVHNode){ .first = node->first, .count = middle - node->first };
+		bvh->nodes[left + 1] = (GLTFBVHNode){ .first = middle, .count = end - middle };
+		depths[left] = depths[left + 1] = depths[i] + 1;
+		bvh->nodeCount += 2;
+
+		node->first = left;
+		node->count = 0;
+	}
+
+	RL_FREE(depths);
+}
+
+// Recompute BVH nodes bounds from their items bounds, its hierarchy is kept
+static void RefitGLTFBVH(GLTFBVH *bvh, const BoundingBox *bounds)
+{
+	for (int i = bvh->nodeCount - 1; i >= 0; i--) {
+		GLTFBVHNode *node = &bvh->nodes[i];
+		if (node->count == 0) {
+			node->bounds = MergeBoundingBoxes(bvh->nodes[node->first].bounds, bvh->nodes[node->first + 1].bounds);
+			continue;
+		}
+
+		node->bounds = EmptyBoundingBox();
+		for (int k = node->first; k < node->first + node->count; k++) node->bounds = MergeBoundingBoxes(node->bounds, bounds[bvh->items[k]]);
+	}
+}
+
+static void UnloadGLTFBVH(GLTFBVH *bvh)
+{
+	RL_FREE(bvh->nodes);
+	RL_FREE(bvh->items);
+}
+
+// Check if mesh triangles are kept in CPU memory (GLTFLoadOptions.freeMeshData), needed by ray queries
+// NOTE: Indexed meshes need their indices too, with freed indices consecutive vertices are not their triangles
+static bool IsGLTFMeshDataKept(const Mesh *mesh)
+{
+	return (mesh->vertices != NULL) && ((mesh->indices != NULL) || !IsGLTFMeshIndexed(mesh));
+}
+
+// Get mesh triangle vertices (mesh space)
+static void GetGLTFMeshTriangle(const Mesh *mesh, int triangle, Vector3 *vertices)
+{
+	for (int i = 0; i < 3; i++) {
+		int index = (mesh->indices != NULL)? mesh->indices[triangle*3 + i] : triangle*3 + i;
+		vertices[i] = (Vector3){ mesh->vertices[index*3], mesh->vertices[index*3 + 1], mesh->vertices[index*3 + 2] };
+	}
+}
+
+// Get ray distance to a box (0 if the ray starts inside), direction inverse is precomputed
+static bool GetRayGLTFBoxDistance(Vector3 origin, Vector3 invDirection, BoundingBox box, float *distance)
+{
+	float t1 = (box.min.x - origin.x)*invDirection.x;
+	float t2 = (box.max.x - origin.x)*invDirection.x;
+	float tmin = fminf(t1, t2);
+	float tmax = fmaxf(t1, t2);
+
+	t1 = (box.min.y - origin.y)*invDirection.y;
+	t2 = (box.max.y - origin.y)*invDirection.y;
+	tmin = fmaxf(tmin, fminf(t1, t2));
+	tmax = fminf(tmax, fmaxf(t1, t2));
+
+	t1 = (box.min.z - origin.z)*invDirection.z;
+	t2 = (box.max.z - origin.z)*invDirection.z;
+	tmin = fmaxf(tmin, fminf(t1, t2));
+	tmax = fminf(tmax, fmaxf(t1, t2));
+
+	if ((tmax < 0.0f) || (tmax < tmin)) return false;
+
+	*distance = (tmin > 0.0f)? tmin : 0.0f;
+	return true;
+}
+
+// Get ray distance to a triangle (Moller-Trumbore intersection, both faces are hit)
+static bool GetRayGLTFTriangleDistance(Vector3 origin, Vector3 direction, const Vector3 *vertices, float *distance)
+{
+	Vector3 edge1 = Vector3Subtract(vertices[1], vertices[0]);
+	Vector3 edge2 = Vector3Subtract(vertices[2], vertices[0]);
+	Vector3 p = Vector3CrossProduct(direction, edge2);
+	float det = Vector3DotProduct(edge1, p);
+	if (det == 0.0f) return false;      // Ray parallel to triangle
+
+	float invDet = 1.0f/det;
+	Vector3 tv = Vector3Subtract(origin, vertices[0]);
+	float u = Vector3DotProduct(tv, p)*invDet;
+	if ((u < 0.0f) || (u > 1.0f)) return false;
+
+	Vector3 q = Vector3CrossProduct(tv, edge1);
+	float v = Vector3DotProduct(direction, q)*invDet;
+	if ((v < 0.0f) || (u + v > 1.0f)) return false;
+
+	float t = Vector3DotProduct(edge2, q)*invDet;
+	if (t < 0.0f) return false;
+
+	*distance = t;
+	return true;
+}
+
+// BVH item ray test, updates hit if the item is hit closer than hit distance
+typedef bool (*GLTFRayItemCallback)(const void *data, int item, Vector3 origin, Vector3 direction, GLTFRayHit *hit);
+
+// Test ray against BVH items closer than hit distance, nearest nodes first
+static bool TraceGLTFBVHRay(const GLTFBVH *bvh, Vector3 origin, Vector3 direction, GLTFRayItemCallback testItem, const void *data, GLTFRayHit *hit)
+{
+	Vector3 invDirection = { 1.0f/direction.x, 1.0f/direction.y, 1.0f/direction.z };
+	int stack[GLTF_BVH_STACK_SIZE];
+	float stackDistances[GLTF_BVH_STACK_SIZE];
+	int top = 0;
+	bool found = false;
+
+	float distance = 0.0f;
+	if ((bvh->nodeCount == 0) || !GetRayGLTFBoxDistance(origin, invDirection, bvh->nodes[0].bounds, &distance)) return false;
+	stack[top] = 0;
+	stackDistances[top++] = distance;
+
+	while (top > 0) {
+		top--;
+		if (stackDistances[top] >= hit->distance) continue;
+		const GLTFBVHNode *node = &bvh->nodes[stack[top]];
+
+		if (node->count > 0) {
+			for (int k = node->first; k < node->first + node->count; k++) {
+				if (testItem(data, bvh->items[k], origin, direction, hit)) found = true;
+			}
+			continue;
+		}
+
+		// Push the farthest child first, so the nearest one is visited first and may skip it
+		float distances[2];
+		bool hits[2];
+		for (int c = 0; c < 2; c++) hits[c] = GetRayGLTFBoxDistance(origin, invDirection, bvh->nodes[node->first + c].bounds, &distances[c]) && (distances[c] < hit->distance);
+		int nearest = (hits[1] && (!hits[0] || (distances[1] < distances[0])))? 1 : 0;
+		for (int c = 1; c >= 0; c--) {
+			int child = (c == 0)? nearest : 1 - nearest;
+			if (!hits[child]) continue;
+			stack[top] = node->first + child;
+			stackDistances[top++] = distances[child];
+		}
+	}
+
+	return found;
+}
+
+// Test ray against a mesh triangle (mesh space)
+static bool GetRayGLTFMeshTriangleHit(const void *data, int triangle, Vector3 origin, Vector3 direction, GLTFRayHit *hit)
+{
+	Vector3 vertices[3];
+	float distance = 0.0f;
+	GetGLTFMeshTriangle((const Mesh *)data, triangle, vertices);
+	if (!GetRayGLTFTriangleDistance(origin, direction, vertices, &distance) || (distance >= hit->distance)) return false;
+
+	hit->distance = distance;
+	hit->triangle = triangle;
+	return true;
+}
+
+// Get the closest ray hit of a mesh triangles (mesh space), triangles BVH is used if built
+static bool GetRayGLTFMeshHit(const Mesh *mesh, const GLTFBVH *bvh, Vector3 origin, Vector3 direction, GLTFRayHit *hit)
+{
+	if (!IsGLTFMeshDataKept(mesh)) return false;
+	if ((bvh != NULL) && (bvh->nodeCount > 0)) return TraceGLTFBVHRay(bvh, origin, direction, GetRayGLTFMeshTriangleHit, mesh, hit);
+
+	bool found = false;
+	for (int t = 0; t < mesh->triangleCount; t++) {
+		if (GetRayGLTFMeshTriangleHit(mesh, t, origin, direction, hit)) found = true;
+	}
+	return found;
+}
+
+// Get the meshes transform of a node instance to pModel space
+// NOTE: Skinned meshes are placed by their joints, they are tested in mesh space (bind pose)
+static Matrix GetGLTFNodeInstanceTransform(const GLTFModel *model, int node_id, int instance)
+{
+	const GLTFNode *node = &model->nodes[node_id];
+	if ((node->skin >= 0) && (node->skin < model->skinCount)) return MatrixIdentity();
+	if (node->instanceCount > 0) return MatrixMultiply(node->instanceTransforms[instance], model->worldTransforms[node_id]);
+
+	return model->worldTransforms[node_id];
+}
+
+// Update node instances transforms and bounds of a node (pModel space)
+static void UpdateGLTFBVHNodeInstances(GLTFModel *model, int node_id)
+{
+	GLTFModelBVH *bvh = model->bvh;
+	const GLTFNode *node = &model->nodes[node_id];
+
+	if (bvh->nodeInstances[node_id] < 0) return;
+
+	int instanceCount = (node->instanceCount > 0)? node->instanceCount : 1;
+	for (int i = bvh->nodeInstances[node_id]; i < bvh->nodeInstances[node_id] + instanceCount; i++) {
+		Matrix transform = GetGLTFNodeInstanceTransform(model, node_id, bvh->instances[i].instance);
+		bvh->instances[i].invTransform = MatrixInvert(transform);
+
+		bvh->instanceBounds[i] = EmptyBoundingBox();
+		for (int j = node->meshStart; j < node->meshEnd; j++) bvh->instanceBounds[i] = MergeBoundingBoxes(bvh->instanceBounds[i], TransformBoundingBox(model->meshBounds[j], transform));
+	}
+}
+
+// Get the closest ray hit of a node instance meshes (ray in pModel space), invTransform is the instance inverse transform
+static bool GetRayGLTFNodeInstanceHit(const GLTFModel *model, int node_id, int instance, Matrix invTransform, Vector3 origin, Vector3 direction, GLTFRayHit *hit)
+{
+	const GLTFNode *node = &model->nodes[node_id];
+
+	// NOTE: Affine transforms keep ray distances in direction units, hits of every instance can be compared
+	Vector3 meshOrigin = Vector3Transform(origin, invTransform);
+	Vector3 meshDirection = Vector3Subtract(Vector3Transform(Vector3Add(origin, direction), invTransform), meshOrigin);
+
+	bool found = false;
+	for (int j = node->meshStart; j < node->meshEnd; j++) {
+		const GLTFBVH *meshBVH = (model->bvh != NULL)? &model->bvh->meshes[j] : NULL;
+		if (!GetRayGLTFMeshHit(&model->meshes[j], meshBVH, meshOrigin, meshDirection, hit)) continue;
+
+		hit->node = node_id;
+		hit->instance = instance;
+		hit->mesh = j;
+		found = true;
+	}
+	return found;
+}
+
+// Test ray against a pModel BVH node instance (pModel space)
+static bool GetRayGLTFBVHInstanceHit(const void *data, int item, Vector3 origin, Vector3 direction, GLTFRayHit *hit)
+{
+	const GLTFModel *model = (const GLTFModel *)data;
+	const GLTFBVHInstance *instance = &model->bvh->instances[item];
+
+	return GetRayGLTFNodeInstanceHit(model, instance->node, instance->instance, instance->invTransform, origin, direction, hit);
+}
+
+// Check if a node is drawn with the pModel scene (pModel.scene), all nodes are drawn without scene
+static bool IsGLTFSceneNode(const GLTFModel *model, int node_id)
+{
+	if ((model->scene < 0) || (model->scene >= model->sceneCount) || (model->scenes[model->scene].nodeCount == 0)) return true;
+
+	int root = node_id;
+	while (model->nodes[root].parent >= 0) root = model->nodes[root].parent;
+	for (int i = 0; i < model->scenes[model->scene].nodeCount; i++) {
+		if (model->scenes[model->scene].nodes[i] == root) return true;
+	}
+	return false;
+}
+
+// Unload pModel acceleration structure
+static void UnloadGLTFModelBVH(GLTFModel *model)
+{
+	GLTFModelBVH *bvh = model->bvh;
+	if (bvh == NULL) return;
+
+	for (int j = 0; j < model->meshCount; j++) UnloadGLTFBVH(&bvh->meshes[j]);
+	UnloadGLTFBVH(&bvh->top);
+	RL_FREE(bvh->meshes);
+	RL_FREE(bvh->instances);
+	RL_FREE(bvh->instanceBounds);
+	RL_FREE(bvh->nodeInstances);
+	RL_FREE(bvh);
+
+	model->bvh = NULL;
+}
+
+// Update node meshes bounds from its world transform
+// NOTE: Skinned nodes bounds are updated with their skin joint matrices (UpdateGLTFSkinJointMatrices())
+static void UpdateGLTFNodeBounds(GLTFModel *model, int node_id)
+{
+	int skin_id = model->nodes[node_id].skin;
+	if ((skin_id >= 0) && (skin_id < model->skinCount)) return;
+
+	model->nodes[node_id].bounds = GetGLTFNodeMeshBounds(model, node_id, model->worldTransforms[node_id]);
+}
+
+// Update cached world transforms
+// NOTE: Only the subtrees of dirty nodes are recomputed, subtrees are contiguous in sorted order
+void UpdateGLTFModelTransforms(GLTFModel *model)
+{
+	if (!model->transformsDirty) return;
+
+	for (int k = 0; k < model->nodeCount; ) {
+		const GLTFNode *node = &model->nodes[model->sortedNodes[k]];
+		if (!node->dirty) {
+			k++;
+			continue;
+		}
+
+		// Parents come first, so the parent of every node in the subtree is already up to date
+		for (int end = node->orderEnd; k < end; k++) {
+			int node_id = model->sortedNodes[k];
+			int parent = model->nodes[node_id].parent;
+			if (parent >= 0) model->worldTransforms[node_id] = MatrixMultiply(model->nodes[node_id].transformMatrix, model->worldTransforms[parent]);
+			else model->worldTransforms[node_id] = model->nodes[node_id].transformMatrix;
+			model->nodes[node_id].dirty = false;
+			UpdateGLTFNodeBounds(model, node_id);
+			if (model->bvh != NULL) UpdateGLTFBVHNodeInstances(model, node_id);
+		}
+	}
+
+	// Skinned nodes are placed by their joints, wherever they are in the hierarchy
+	UpdateGLTFSkinJointMatrices(model);
+
+	// Merge subtree bounds upwards, children are placed after their parents
+	for (int k = 0; k < model->nodeCount; k++) model->nodes[k].subtreeBounds = model->nodes[k].bounds;
+	for (int k = model->nodeCount - 1; k >= 0; k--) {
+		const GLTFNode *node = &model->nodes[model->sortedNodes[k]];
+		if (node->parent >= 0) model->nodes[node->parent].subtreeBounds = MergeBoundingBoxes(model->nodes[node->parent].subtreeBounds, node->subtreeBounds);
+	}
+
+	// Node instances BVH hierarchy is kept, only its bounds are recomputed
+	if (model->bvh != NULL) RefitGLTFBVH(&model->bvh->top, model->bvh->instanceBounds);
+
+	model->transformsDirty = false;
+}
+
+// Get a Model's node cached world transform
+Matrix GetGLTFNodeWorldTransform(GLTFModel model, int node_id)
+{
+	if (node_id < 0 || node_id >= model.nodeCount) return MatrixIdentity();
+	return model.worldTransforms[node_id];
+}
+
+// Generate pModel acceleration structure for ray and box queries: triangles BVH of every mesh and node instances BVH
+// NOTE: Mesh vertices and indices must be kept in CPU memory (GLTFLoadOptions.freeMeshData), node instances BVH is refit
+// by UpdateGLTFModelTransforms(), only nodes of the pModel scene are added (levels of detail are not)
+void GenGLTFModelBVH(GLTFModel *model)
+{
+	UnloadGLTFModelBVH(model);
+	UpdateGLTFModelTransforms(model);
+
+	GLTFModelBVH *bvh = RL_CALLOC(1, sizeof(GLTFModelBVH));
+	model->bvh = bvh;
+
+	int missingVertices = 0;
+	bvh->meshes = RL_CALLOC(model->meshCount + 1, sizeof(GLTFBVH));
+	for (int j = 0; j < model->meshCount; j++) {
+		const Mesh *mesh = &model->meshes[j];
+		if (!IsGLTFMeshDataKept(mesh)) {
+			if (mesh->vertexCount > 0) missingVertices++;
+			continue;
+		}
+
+		BoundingBox *bounds = RL_MALLOC((mesh->triangleCount + 1)*sizeof(BoundingBox));
+		for (int t = 0; t < mesh->triangleCount; t++) {
+			Vector3 vertices[3];
+			GetGLTFMeshTriangle(mesh, t, vertices);
+			bounds[t].min = Vector3Min(Vector3Min(vertices[0], vertices[1]), vertices[2]);
+			bounds[t].max = Vector3Max(Vector3Max(vertices[0], vertices[1]), vertices[2]);
+		}
+		BuildGLTFBVH(&bvh->meshes[j], bounds, mesh->triangleCount);
+		RL_FREE(bounds);
+	}
+	if (missingVertices > 0) TRACELOG(LOG_WARNING, "MODEL: %i meshes vertices or indices are not kept in CPU memory, they are ignored by ray queries", missingVertices);
+
+	bvh->nodeInstances = RL_MALLOC((model->nodeCount + 1)*sizeof(int));
+	for (int i = 0; i < model->nodeCount; i++) {
+		const GLTFNode *node = &model->nodes[i];
+		bvh->nodeInstances[i] = -1;
+		if ((node->meshStart >= node->meshEnd) || !IsGLTFSceneNode(model, i)) continue;
+
+		bvh->nodeInstances[i] = bvh->instanceCount;
+		bvh->instanceCount += (node->instanceCount > 0)? node->instanceCount : 1;
+	}
+
+	bvh->instances = RL_MALLOC((bvh->instanceCount + 1)*sizeof(GLTFBVHInstance));
+	bvh->instanceBounds = RL_MALLOC((bvh->instanceCount + 1)*sizeof(BoundingBox));
+	for (int i = 0; i < model->nodeCount; i++) {
+		if (bvh->nodeInstances[i] < 0) continue;
+
+		int instanceCount = (model->nodes[i].instanceCount > 0)? model->nodes[i].instanceCount : 1;
+		for (int n = 0; n < instanceCount; n++) {
+			bvh->instances[bvh->nodeInstances[i] + n].node = i;
+			bvh->instances[bvh->nodeInstances[i] + n].instance = n;
+		}
+		UpdateGLTFBVHNodeInstances(model, i);
+	}
+	BuildGLTFBVH(&bvh->top, bvh->instanceBounds, bvh->instanceCount);
+}
+
+// Get collision info between ray and pModel
+RayCollision GetRayCollisionGLTFModel(GLTFModel model, Ray ray, Matrix transform)
+{
+	return GetRayCollisionGLTFModelEx(model, ray, transform, NULL, NULL);
+}
+
+// Get collision info between ray and pModel, hit node and mesh ids are returned if not NULL (-1: no hit)
+// NOTE: Without acceleration structure (GenGLTFModelBVH()) every triangle of the pModel scene is tested,
+// cached world transforms are used, call UpdateGLTFModelTransforms() after changing node transforms
+RayCollision GetRayCollisionGLTFModelEx(GLTFModel model, Ray ray, Matrix transform, int *node_id, int *mesh_id)
+{
+	RayCollision collision = { 0 };
+	GLTFRayHit hit = { FLT_MAX, -1, 0, -1, -1 };
+
+	// Ray in pModel space
+	Matrix invTransform = MatrixInvert(transform);
+	Vector3 origin = Vector3Transform(ray.position, invTransform);
+	Vector3 direction = Vector3Subtract(Vector3Transform(Vector3Add(ray.position, ray.direction), invTransform), origin);
+
+	if (model.bvh != NULL) TraceGLTFBVHRay(&model.bvh->top, origin, direction, GetRayGLTFBVHInstanceHit, &model, &hit);
+	else {
+		for (int i = 0; i < model.nodeCount; i++) {
+			const GLTFNode *node = &model.nodes[i];
+			if ((node->meshStart >= node->meshEnd) || !IsGLTFSceneNode(&model, i)) continue;
+
+			int instanceCount = (node->instanceCount > 0)? node->instanceCount : 1;
+			for (int n = 0; n < instanceCount; n++) GetRayGLTFNodeInstanceHit(&model, i, n, MatrixInvert(GetGLTFNodeInstanceTransform(&model, i, n)), origin, direction, &hit);
+		}
+	}
+
+	if (node_id != NULL) *node_id = hit.node;
+	if (mesh_id != NULL) *mesh_id = hit.mesh;
+	if (hit.node < 0) return collision;
+
+	// Hit triangle in world space, for the hit normal
+	Vector3 vertices[3];
+	Matrix meshTransform = MatrixMultiply(GetGLTFNodeInstanceTransform(&model, hit.node, hit.instance), transform);
+	GetGLTFMeshTriangle(&model.meshes[hit.mesh], hit.triangle, vertices);
+	for (int i = 0; i < 3; i++) vertices[i] = Vector3Transform(vertices[i], meshTransform);
+
+	collision.hit = true;
+	collision.distance = hit.distance*Vector3Length(ray.direction);
+	collision.point = Vector3Add(ray.position, Vector3Scale(ray.direction, hit.distance));
+	collision.normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(vertices[1], vertices[0]), Vector3Subtract(vertices[2], vertices[0])));
+
+	return collision;
+}
+
+// Get pModel node instances with bounds overlapping a box, returns the number of ids written to node_ids
+// NOTE: Node bounds are transformed to world space (conservative), instanced nodes are returned once per instance
+// overlapping the box (instance ids are returned if not NULL)
+int GetGLTFModelBoxOverlaps(GLTFModel model, BoundingBox box, Matrix transform, int *node_ids, int *instances, int maxCount)
+{
+	int count = 0;
+
+	if (model.bvh == NULL) {
+		for (int i = 0; (i < model.nodeCount) && (count < maxCount); i++) {
+			const GLTFNode *node = &model.nodes[i];
+			if ((node->meshStart >= node->meshEnd) || !IsGLTFSceneNode(&model, i)) continue;
+
+			int instanceCount = (node->instanceCount > 0)? node->instanceCount : 1;
+			for (int n = 0; (n < instanceCount) && (count < maxCount); n++) {
+				Matrix instanceTransform = MatrixMultiply(GetGLTFNodeInstanceTransform(&model, i, n), transform);
+				BoundingBox bounds = EmptyBoundingBox();
+				for (int j = node->meshStart; j < node->meshEnd; j++) bounds = MergeBoundingBoxes(bounds, TransformBoundingBox(model.meshBounds[j], instanceTransform));
+				if (!CheckCollisionBoxes(bounds, box)) continue;
+
+				node_ids[count] = i;
+				if (instances != NULL) instances[count] = n;
+				count++;
+			}
+		}
+		return count;
+	}
+
+	const GLTFBVH *top = &model.bvh->top;
+	int stack[GLTF_BVH_STACK_SIZE];
+	int stackSize = 0;
+	if (top->nodeCount > 0) stack[stackSize++] = 0;
+
+	while ((stackSize > 0) && (count < maxCount)) {
+		const GLTFBVHNode *node = &top->nodes[stack[--stackSize]];
+		if (!CheckCollisionBoxes(TransformBoundingBox(node->bounds, transform), box)) continue;
+
+		if (node->count == 0) {
+			stack[stackSize++] = node->first + 1;
+			stack[stackSize++] = node->first;
+			continue;
+		}
+
+		for (int k = node->first; (k < node->first + node->count) && (count < maxCount); k++) {
+			if ((node->count > 1) && !CheckCollisionBoxes(TransformBoundingBox(model.bvh->instanceBounds[top->items[k]], transform), box)) continue;
+
+			const GLTFBVHInstance *instance = &model.bvh->instances[top->items[k]];
+			node_ids[count] = instance->node;
+			if (instances != NULL) instances[count] = instance->instance;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+// Load animation playback state of a pModel instance, pose starts as the pModel nodes transforms
+GLTFAnimationState LoadGLTFAnimationState(GLTFModel model, int animation_id, bool loop)
+{
+	GLTFAnimationState state = { 0 };
+	if (animation_id < 0 || animation_id >= model.animationCount) {
+		TRACELOG(LOG_WARNING, "MODEL: Animation %i not found", animation_id);
+		return state;
+	}
+
+	state.animation = animation_id;
+	state.loop = loop;
+	state.cursors = RL_CALLOC(model.animations[animation_id].trackCount + 1, sizeof(int));
+	state.pose = RL_MALLOC((model.nodeCount + 1)*sizeof(Transform));
+	for (int i = 0; i < model.nodeCount; i++) state.pose[i] = model.nodes[i].transform;
+
+	// NOTE: Weights of every weights track are consecutive (in tracks order), starting as the nodes weights
+	const GLTFAnimation *animation = &model.animations[animation_id];
+	state.weights = RL_CALLOC(animation->weightCount + 1, sizeof(float));
+	for (int t = 0, w = 0; t < animation->trackCount; t++) {
+		const GLTFAnimationTrack *track = &animation->tracks[t];
+		if (track->path != GLTF_ANIMATION_WEIGHTS) continue;
+
+		const GLTFNode *node = &model.nodes[track->node];
+		for (int i = 0; (i < track->components) && (i < node->weightCount); i++) state.weights[w + i] = node->weights[i];
+		w += track->components;
+	}
+
+	return state;
+}
+
+// Unload animation playback state
+void UnloadGLTFAnimationState(GLTFAnimationState state)
+{
+	RL_FREE(state.cursors);
+	RL_FREE(state.pose);
+	RL_FREE(state.weights);
+}
+
+// Sample animation track at time, result gets track components floats
+// NOTE: The track cursor is the last keyframe sampled, while time moves forward the keyframe interval is found
+// stepping from it (amortized O(1)), a binary search is only needed when time goes back (looping or seeking)
+static void SampleGLTFAnimationTrack(const GLTFAnimationTrack *track, float time, int *cursor, float *result)
+{
+	const float *times = track->times;
+	int last = track->keyCount - 1;
+	int k = *cursor;
+
+	if ((k > last) || (times[k] > time)) {
+		int low = 0, high = last;
+		while (low < high) {
+			int mid = (low + high + 1)/2;
+			if (times[mid] <= time) low = mid;
+			else high = mid - 1;
+		}
+		k = low;
+	}
+	while ((k < last) && (times[k + 1] <= time)) k++;
+	*cursor = k;
+
+	// Cubic spline keys store in-tangent, value and out-tangent
+	int components = track->components;
+	bool rotation = (track->path == GLTF_ANIMATION_ROTATION);
+	bool cubic = (track->interpolation == GLTF_INTERPOLATION_CUBICSPLINE);
+	int stride = cubic? 3*components : components;
+	const float *v0 = &track->values[k*stride + (cubic? components : 0)];
+
+	if ((k == last) || (time <= times[k]) || (track->interpolation == GLTF_INTERPOLATION_STEP)) {
+		for (int i = 0; i < components; i++) result[i] = v0[i];
+		return;
+	}
+
+	float dt = times[k + 1] - times[k];
+	float t = (time - times[k])/dt;
+	const float *v1 = v0 + stride;
+
+	if (cubic) {
+		const float *outTangent = v0 + components;
+		const float *inTangent = v1 - components;
+		float t2 = t*t, t3 = t2*t;
+		float h00 = 2*t3 - 3*t2 + 1, h10 = (t3 - 2*t2 + t)*dt, h01 = -2*t3 + 3*t2, h11 = (t3 - t2)*dt;
+		for (int i = 0; i < components; i++) result[i] = h00*v0[i] + h10*outTangent[i] + h01*v1[i] + h11*inTangent[i];
+
+		if (rotation) {
+			Quaternion q = QuaternionNormalize((Quaternion){ result[0], result[1], result[2], result[3] });
+			result[0] = q.x; result[1] = q.y; result[2] = q.z; result[3] = q.w;
+		}
+	}
+	else if (rotation) {
+		Quaternion q = QuaternionSlerp((Quaternion){ v0[0], v0[1], v0[2], v0[3] }, (Quaternion){ v1[0], v1[1], v1[2], v1[3] }, t);
+		result[0] = q.x; result[1] = q.y; result[2] = q.z; result[3] = q.w;
+	}
+	else for (int i = 0; i < components; i++) result[i] = v0[i] + t*(v1[i] - v0[i]);
+}
+
+// Advance playback time of many animation states and sample their animations pose
+// NOTE: States can play different animations of the pModel, each state keeps its own pose so a single
+// pModel can be posed for many instances (ApplyGLTFAnimationState() before adding each one to a draw list)
+void UpdateGLTFAnimationStates(GLTFModel model, GLTFAnimationState *states, int count, float deltaTime)
+{
+	for (int s = 0; s < count; s++) {
+		GLTFAnimationState *state = &states[s];
+		if ((state->pose == NULL) || (state->animation < 0) || (state->animation >= model.animationCount)) continue;
+
+		const GLTFAnimation *animation = &model.animations[state->animation];
+		state->time += deltaTime;
+		if (state->loop && (animation->duration > 0)) {
+			state->time = fmodf(state->time, animation->duration);
+			if (state->time < 0) state->time += animation->duration;
+		}
+
+		for (int t = 0, w = 0; t < animation->trackCount; t++) {
+			const GLTFAnimationTrack *track = &animation->tracks[t];
+
+			// NOTE: Weights tracks are sampled into the state weights, the others into the state pose
+			if (track->path == GLTF_ANIMATION_WEIGHTS) {
+				SampleGLTFAnimationTrack(track, state->time, &state->cursors[t], &state->weights[w]);
+				w += track->components;
+				continue;
+			}
+
+			Transform *transform = &state->pose[track->node];
+			float value[4];
+			SampleGLTFAnimationTrack(track, state->time, &state->cursors[t], value);
+
+			switch (track->path) {
+				case GLTF_ANIMATION_TRANSLATION: transform->translation = (Vector3){ value[0], value[1], value[2] }; break;
+				case GLTF_ANIMATION_ROTATION: transform->rotation = (Quaternion){ value[0], value[1], value[2], value[3] }; break;
+				default: transform->scale = (Vector3){ value[0], value[1], value[2] }; break;
+			}
+		}
+	}
+}
+
+// Set a Model's animated nodes transforms and morph target weights from an animation state pose
+// NOTE: Only animated nodes are marked dirty, UpdateGLTFModelTransforms() recomputes their subtrees
+void ApplyGLTFAnimationState(GLTFModel *model, const GLTFAnimationState *state)
+{
+	if ((state->pose == NULL) || (state->animation < 0) || (state->animation >= model->animationCount)) return;
+
+	const GLTFAnimation *animation = &model->animations[state->animation];
+	for (int i = 0; i < animation->nodeCount; i++) SetGLTFNodeTransform(model, animation->nodes[i], state->pose[animation->nodes[i]]);
+
+	for (int t = 0, w = 0; (state->weights != NULL) && (t < animation->trackCount); t++) {
+		const GLTFAnimationTrack *track = &animation->tracks[t];
+		if (track->path != GLTF_ANIMATION_WEIGHTS) continue;
+
+		SetGLTFNodeMorphWeights(model, track->node, &state->weights[w], track->components);
+		w += track->components;
+	}
+}
+
+void UnloadGLTFModel(GLTFModel model)
+{
+	// Unload shared vertex and index buffers once, meshes using them don't unload them
+	for (int i = 0; (model.vertexBuffer != 0) && (i < model.meshCount); i++)
+	{
+		if (model.meshes[i].vboId == NULL) continue;
+		if (model.meshes[i].vboId[GLTF_VERTEX_BUFFER_POSITION] == model.vertexBuffer) model.meshes[i].vboId[GLTF_VERTEX_BUFFER_POSITION] = 0;
+		if (model.meshes[i].vboId[GLTF_VERTEX_BUFFER_INDICES] == model.indexBuffer) model.meshes[i].vboId[GLTF_VERTEX_BUFFER_INDICES] = 0;
+	}
+	if (model.vertexBuffer != 0) rlUnloadVertexBuffer(model.vertexBuffer);
+	if (model.indexBuffer != 0) rlUnloadVertexBuffer(model.indexBuffer);
+
+	// Unload meshes
+	// NOTE: Arena meshes arrays are released with the arena, only their GPU buffers are unloaded
+	for (int i = 0; i < model.meshCount; i++)
+	{
+		if (model.arena == NULL) UnloadMesh(model.meshes[i]);
+		else
+		{
+			rlUnloadVertexArray(model.meshes[i].vaoId);
+			for (int j = 0; (model.meshes[i].vboId != NULL) && (j < MAX_MESH_VERTEX_BUFFERS); j++) rlUnloadVertexBuffer(model.meshes[i].vboId[j]);
+			UnloadGLTFMeshData(model.meshes[i], model.arena);
+			FreeGLTFArray(model.arena, model.meshes[i].vboId);
+		}
+	}
+
+	// Unload morph targets deltas textures
+	for (int i = 0; (model.meshMorphs != NULL) && (i < model.meshCount); i++)
+	{
+		if (model.meshMorphs[i].textureId != 0) rlUnloadTexture(model.meshMorphs[i].textureId);
+		UnloadGLTFMorphTargets(model.meshMorphs[i], model.arena);
+	}
+
+	// Unload materials maps
+	// NOTE: As the user could be sharing shaders and textures between models,
+	// we don't unload the material but just free it's maps,
+	// the user is responsible for freeing shaders and textures not loaded by the model
+	// Asset cache materials are released instead, their maps are freed by their last user
+	for (int i = 0; i < model.materialCount; i++)
+	{
+		if ((model.assetCache != NULL) && (model.materials[i].maps != NULL) && ReleaseGLTFAsset(model.assetCache, GLTF_ASSET_MATERIAL, 0, model.materials[i].maps)) continue;
+		FreeGLTFArray(model.arena, model.materials[i].maps);
+	}
+
+	// Unload textures loaded from model images (shared by materials), asset cache textures are released
+	for (int i = 0; i < model.textureCount; i++)
+	{
+		if (model.textures[i].id == 0) continue;
+		if ((model.assetCache == NULL) || !ReleaseGLTFAsset(model.assetCache, GLTF_ASSET_TEXTURE, model.textures[i].id, NULL)) UnloadTexture(model.textures[i]);
+	}
+	FreeGLTFArray(model.arena, model.textures);
+
+	// Unload arrays
+	FreeGLTFArray(model.arena, model.meshes);
+	FreeGLTFArray(model.arena, model.materials);
+	FreeGLTFArray(model.arena, model.meshMaterial);
+	FreeGLTFArray(model.arena, model.meshBounds);
+	FreeGLTFArray(model.arena, model.meshMorphs);
+	FreeGLTFArray(model.arena, model.meshFirstIndex);
+	FreeGLTFArray(model.arena, model.materialLodStart);
+	FreeGLTFArray(model.arena, model.materialLods);
+
+	// Unload scenes and nodes
+	// NOTE: Arena nodes data is released at once, there is no need to walk the nodes
+	for (int i = 0; (model.arena == NULL) && (i < model.nodeCount); i++) {
+		RL_FREE(model.nodes[i].children);
+		RL_FREE(model.nodes[i].instanceTransforms);
+		RL_FREE(model.nodes[i].lodNodes);
+		RL_FREE(model.nodes[i].lodCoverage);
+		RL_FREE(model.nodes[i].weights);
+	}
+	FreeGLTFArray(model.arena, model.nodes);
+	FreeGLTFArray(model.arena, model.sortedNodes);
+	FreeGLTFArray(model.arena, model.worldTransforms);
+	for (int i = 0; (model.arena == NULL) && (i < model.sceneCount); i++) RL_FREE(model.scenes[i].nodes);
+	FreeGLTFArray(model.arena, model.scenes);
+	for (int i = 0; (model.arena == NULL) && (i < model.skinCount); i++) {
+		RL_FREE(model.skins[i].joints);
+		RL_FREE(model.skins[i].inverseBindMatrices);
+		RL_FREE(model.skins[i].jointMatrices);
+	}
+	FreeGLTFArray(model.arena, model.skins);
+	for (int i = 0; (model.arena == NULL) && (i < model.animationCount); i++) {
+		if (model.animations[i].trackCount > 0) {
+			RL_FREE(model.animations[i].tracks[0].times);
+			RL_FREE(model.animations[i].tracks[0].values);
+		}
+		RL_FREE(model.animations[i].tracks);
+		RL_FREE(model.animations[i].nodes);
+	}
+	FreeGLTFArray(model.arena, model.animations);
+
+	UnloadGLTFModelBVH(&model);
+	UnloadGLTFArena(model.arena);
+
+	TRACELOG(LOG_INFO, "MODEL: Unloaded pModel (and meshes) from RAM and VRAM");
+}
+
+// Load asset cache, models loaded with it (GLTFLoadOptions.assetCache) share textures and materials
+GLTFAssetCache *LoadGLTFAssetCache(void)
+{
+	GLTFAssetCache *cache = RL_CALLOC(1, sizeof(GLTFAssetCache));
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_init(&cache->lock, NULL);
+#endif
+
+	return cache;
+}
+
+// Unload asset cache, resources still in use are unloaded too
+// NOTE: Models using the cache must be unloaded first, otherwise their textures and materials are not valid anymore
+void UnloadGLTFAssetCache(GLTFAssetCache *cache)
+{
+	if (cache == NULL) return;
+
+	if (cache->assetCount > 0) TRACELOG(LOG_WARNING, "MODEL: Asset cache unloaded with %i resources still in use", cache->assetCount);
+	for (int i = 0; i < cache->assetCount; i++) UnloadGLTFAsset(cache->assets[i]);
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_destroy(&cache->lock);
+#endif
+	RL_FREE(cache->assets);
+	RL_FREE(cache);
+}
+
+// Load shader shared through the asset cache, every pair of files (vsFileName, fsFileName) is loaded once
+// NOTE: Shader must be released with UnloadGLTFAssetShader(), it's unloaded by its last user
+Shader LoadGLTFAssetShader(GLTFAssetCache *cache, const char *vsFileName, const char *fsFileName)
+{
+	if (cache == NULL) return LoadShader(vsFileName, fsFileName);
+
+	// NOTE: File names are hashed with their NUL terminators, so different pairs don't share keys
+	GLTFAsset asset = { 0 };
+	asset.type = GLTF_ASSET_SHADER;
+	asset.key = GetGLTFHash((const unsigned char *)((vsFileName != NULL)? vsFileName : ""), (vsFileName != NULL)? strlen(vsFileName) + 1 : 1, GLTF_HASH_SEED);
+	asset.key = GetGLTFAssetKey((fsFileName != NULL)? fsFileName : "", (fsFileName != NULL)? strlen(fsFileName) + 1 : 1, asset.key);
+
+	if (AcquireGLTFAsset(cache, &asset)) return asset.shader;
+
+	// NOTE: Shaders failing to load are the default shader, it's not cached
+	asset.shader = LoadShader(vsFileName, fsFileName);
+	if (asset.shader.id != rlGetShaderIdDefault()) AddGLTFAsset(cache, asset);
+
+	return asset.shader;
+}
+
+// Release shader loaded with LoadGLTFAssetShader(), shaders not loaded through the cache are unloaded
+void UnloadGLTFAssetShader(GLTFAssetCache *cache, Shader shader)
+{
+	if ((cache == NULL) || !ReleaseGLTFAsset(cache, GLTF_ASSET_SHADER, shader.id, NULL)) UnloadShader(shader);
+}
+
+// Set defaults for missing pModel data, before uploading it to GPU
+static void BeginGLTFModelUpload(GLTFModelUpload *upload, const char *fileName)
+{
+	GLTFModel model = upload->model;
+
+	// Make sure pModel transform is set to identity matrix!
+	model.transform = MatrixIdentity();
+
+	if (model.meshCount == 0)
+	{
+		model.meshCount = 1;
+		model.meshes = (Mesh *)AllocGLTFArray(model.arena, model.meshCount, sizeof(Mesh));
+#if defined(SUPPORT_MESH_GENERATION)
+		TRACELOG(LOG_WARNING, "MESH: [%s] Failed to load mesh data, default to cube mesh", fileName);
+		model.meshes[0] = GenMeshCube(1.0f, 1.0f, 1.0f);
+#else
+		TRACELOG(LOG_WARNING, "MESH: [%s] Failed to load mesh data", fileName);
+#endif
+		model.meshBounds = (BoundingBox *)ReallocGLTFArray(model.arena, model.meshBounds, 0, model.meshCount*sizeof(BoundingBox));
+		model.meshBounds[0] = GetMeshBoundingBox(model.meshes[0]);
+
+		// NOTE: Generated mesh is already uploaded
+		upload->uploadedMeshes = model.meshCount;
+	}
+
+	if (model.materialCount == 0)
+	{
+		TRACELOG(LOG_WARNING, "MATERIAL: [%s] Failed to load material data, default to white material", fileName);
+
+		model.materialCount = 1;
+		model.materials = (Material *)AllocGLTFArray(model.arena, model.materialCount, sizeof(Material));
+		model.materials[0] = LoadMaterialDefault();
+
+		if (model.meshMaterial == NULL) model.meshMaterial = (int *)AllocGLTFArray(model.arena, model.meshCount, sizeof(int));
+	}
+
+	upload->model = model;
+}
+
+// Check if there is upload budget left for an item of itemSize bytes, at least one item is uploaded per call
+static bool IsGLTFUploadBudgetLeft(int uploadedItems, int uploadedBytes, int itemSize, int byteBudget, double startTime, float timeBudget)
+{
+	if (uploadedItems == 0) return true;
+	if ((byteBudget > 0) && (uploadedBytes + itemSize > byteBudget)) return false;
+	if ((timeBudget > 0.0f) && ((GetTime() - startTime) >= timeBudget)) return false;
+
+	return true;
+}
+
+// Get GPU format of a mesh vertex attribute, the compact attribute if any or mesh data (floats, colors: u8)
+// NOTE: Returned attribute data is NULL if the mesh has no data for it (skinning and morph attributes are only compact)
+static GLTFVertexAttribute GetGLTFMeshAttribute(const Mesh *mesh, const GLTFVertexAttribute *attributes, int index)
+{
+	if ((attributes != NULL) && (attributes[index].data != NULL)) return attributes[index];
+
+	unsigned char *data[GLTF_VERTEX_ATTRIBUTES] = { (unsigned char *)mesh->vertices, (unsigned char *)mesh->texcoords, (unsigned char *)mesh->normals, mesh->colors, (unsigned char *)mesh->tangents, (unsigned char *)mesh->texcoords2, NULL, NULL, NULL };
+	const int components[GLTF_VERTEX_ATTRIBUTES] = { 3, 2, 3, 4, 4, 2, 4, 4, 2 };
+	bool colors = (index == GLTF_VERTEX_BUFFER_COLOR);
+
+	GLTFVertexAttribute result = { 0 };
+	result.data = data[index];
+	result.components = components[index];
+	result.type = colors? RL_UNSIGNED_BYTE : RL_FLOAT;
+	result.normalized = colors;
+	result.elementSize = components[index]*(colors? (int)sizeof(unsigned char) : (int)sizeof(float));
+
+	return result;
+}
+
+// Get mesh vertex attributes GPU formats (one per vertex buffer)
+static void GetGLTFMeshAttributes(const Mesh *mesh, const GLTFVertexAttribute *attributes, GLTFVertexAttribute *formats)
+{
+	for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++) formats[i] = GetGLTFMeshAttribute(mesh, attributes, i);
+}
+
+// Get size of the mesh indices uploaded to GPU (u16 indices)
+static int GetGLTFMeshIndexDataSize(const Mesh *mesh)
+{
+	return (mesh->indices != NULL)? mesh->triangleCount*3*(int)sizeof(unsigned short) : 0;
+}
+
+// Get size of the mesh vertex data uploaded by UploadGLTFMesh()
+static int GetGLTFMeshDataSize(Mesh mesh, const GLTFVertexAttribute *attributes)
+{
+	int vertexSize = 0;
+	for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++)
+	{
+		GLTFVertexAttribute format = GetGLTFMeshAttribute(&mesh, attributes, i);
+		if (format.data != NULL) vertexSize += format.elementSize;
+	}
+
+	return mesh.vertexCount*vertexSize + GetGLTFMeshIndexDataSize(&mesh);
+}
+
+// Get interleaved vertex layout: attributes offsets in the vertex (-1: not present), returns vertex stride in bytes
+// NOTE: Attributes are interleaved in shader location order, aligned to 4 bytes
+static int GetGLTFInterleavedLayout(const GLTFVertexAttribute *formats, int *offsets)
+{
+	int stride = 0;
+	for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++)
+	{
+		offsets[i] = (formats[i].data != NULL)? stride : -1;
+		if (formats[i].data != NULL) stride += (formats[i].elementSize + 3) & ~3;
+	}
+
+	return stride;
+}
+
+// Interleave vertex attributes data into vertices (stride bytes per vertex)
+static void InterleaveGLTFVertices(int vertexCount, const GLTFVertexAttribute *formats, const int *offsets, int stride, unsigned char *vertices)
+{
+	for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++)
+	{
+		if (formats[i].data == NULL) continue;
+
+		const unsigned char *src = formats[i].data;
+		unsigned char *dst = vertices + offsets[i];
+		for (int v = 0; v < vertexCount; v++, src += formats[i].elementSize, dst += stride) memcpy(dst, src, formats[i].elementSize);
+	}
+}
+
+// Set default vertex attribute value for a missing attribute, as set by UploadMesh() (skinning and morph attributes: zero)
+static void SetGLTFVertexAttributeDefault(int index)
+{
+	const int components[GLTF_VERTEX_ATTRIBUTES] = { 3, 2, 3, 4, 4, 2, 4, 4, 2 };
+	const int types[GLTF_VERTEX_ATTRIBUTES] = { SHADER_ATTRIB_VEC3, SHADER_ATTRIB_VEC2, SHADER_ATTRIB_VEC3, SHADER_ATTRIB_VEC4, SHADER_ATTRIB_VEC4, SHADER_ATTRIB_VEC2, SHADER_ATTRIB_VEC4, SHADER_ATTRIB_VEC4, SHADER_ATTRIB_VEC2 };
+	const float defaults[GLTF_VERTEX_ATTRIBUTES][4] = { { 0.0f }, { 0.0f }, { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f }, { 0.0f }, { 0.0f }, { 0.0f }, { 0.0f } };
+
+	rlSetVertexAttributeDefault(index, defaults[index], types[index], components[index]);
+	rlDisableVertexAttribute(index);
+}
+
+// Set bound vertex array attributes reading the bound interleaved vertex buffer, vertices start at byte offset
+static void SetGLTFInterleavedAttributes(const GLTFVertexAttribute *formats, const int *offsets, int stride, int offset)
+{
+	for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++)
+	{
+		if (formats[i].data != NULL)
+		{
+			rlSetVertexAttribute(i, formats[i].components, formats[i].type, formats[i].normalized, stride, (void *)(uintptr_t)(offset + offsets[i]));
+			rlEnableVertexAttribute(i);
+		}
+		else SetGLTFVertexAttributeDefault(i);
+	}
+}
+
+// Upload mesh vertex data to GPU like UploadMesh(), compact (quantized) attributes are uploaded as they are
+// NOTE: Attributes formats are kept by the mesh vertex array, if vertex arrays are not supported
+// mesh float data is uploaded, DrawMesh() only binds float vertex buffers. Interleaved vertices
+// are uploaded to the position vertex buffer (GLTF_VERTEX_LAYOUT_INTERLEAVED), other buffers are 0
+// NOTE: Skinned and morphed meshes are always interleaved, joints, weights and morph ranges have no vertex buffer slot
+static void UploadGLTFMesh(Mesh *mesh, const GLTFVertexAttribute *attributes, bool interleaved)
+{
+	bool compact = false;
+	for (int i = 0; (attributes != NULL) && (i < GLTF_VERTEX_ATTRIBUTES); i++) if (attributes[i].data != NULL) compact = true;
+
+	bool skinned = (attributes != NULL) && (attributes[GLTF_VERTEX_ATTRIBUTE_JOINTS].data != NULL);
+	bool morphed = (attributes != NULL) && (attributes[GLTF_VERTEX_ATTRIBUTE_MORPH].data != NULL);
+	if (skinned || morphed) interleaved = true;
+
+	if (compact || interleaved) mesh->vaoId = rlLoadVertexArray();
+	if (mesh->vaoId == 0)
+	{
+		if (skinned) TRACELOG(LOG_WARNING, "MESH: Skinning requires vertex arrays (VAO), skinned mesh is drawn in bind pose");
+		if (morphed) TRACELOG(LOG_WARNING, "MESH: Morph targets require vertex arrays (VAO), morphed mesh is drawn without them");
+		UploadMesh(mesh, false);
+		return;
+	}
+
+	GLTFVertexAttribute formats[GLTF_VERTEX_ATTRIBUTES];
+	GetGLTFMeshAttributes(mesh, attributes, formats);
+
+	rlEnableVertexArray(mesh->vaoId);
+
+	if (interleaved)
+	{
+		int offsets[GLTF_VERTEX_ATTRIBUTES];
+		int stride = GetGLTFInterleavedLayout(formats, offsets);
+		unsigned char *vertices = RL_MALLOC(mesh->vertexCount*stride);
+
+		InterleaveGLTFVertices(mesh->vertexCount, formats, offsets, stride, vertices);
+		mesh->vboId[GLTF_VERTEX_BUFFER_POSITION] = rlLoadVertexBuffer(vertices, mesh->vertexCount*stride, false);
+		SetGLTFInterleavedAttributes(formats, offsets, stride, 0);
+
+		RL_FREE(vertices);
+	}
+	else
+	{
+		for (int i = 0; i < GLTF_VERTEX_ATTRIBUTES; i++)
+		{
+			if (formats[i].data != NULL)
+			{
+				mesh->vboId[i] = rlLoadVertexBuffer(formats[i].data, mesh->vertexCount*formats[i].elementSize, false);
+				rlSetVertexAttribute(i, formats[i].components, formats[i].type, formats[i].normalized, formats[i].elementSize, 0);
+				rlEnableVertexAttribute(i);
+			}
+			else SetGLTFVertexAttributeDefault(i);
+		}
+	}
+
+	if (mesh->indices != NULL) mesh->vboId[GLTF_VERTEX_BUFFER_INDICES] = rlLoadVertexBufferElement(mesh->indices, mesh->triangleCount*3*sizeof(unsigned short), false);
+
+	rlDisableVertexArray();
+
+	TRACELOG(LOG_INFO, "VAO: [ID %i] Mesh uploaded successfully to VRAM (GPU), %s vertex attributes", mesh->vaoId, interleaved? "interleaved" : "compact");
+}
+
+// Upload every pModel mesh to a single interleaved vertex buffer and a single index buffer (GLTF_VERTEX_LAYOUT_SHARED)
+// NOTE: Every mesh vertex array reads its vertices range (mesh indices are not offset), mesh indices ranges are
+// drawn from pModel.meshFirstIndex. Returns false if vertex arrays are not supported (nothing is uploaded)
+static bool UploadGLTFSharedMeshes(GLTFModel *model, const GLTFVertexAttribute *meshAttributes)
+{
+	unsigned int vaoId = rlLoadVertexArray();
+	if (vaoId == 0) return false;
+
+	int *vertexOffsets = RL_MALLOC(model->meshCount*sizeof(int));
+	model->meshFirstIndex = (int *)AllocGLTFArray(model->arena, model->meshCount, sizeof(int));
+
+	// Get every mesh vertices range in the vertex buffer and indices range in the index buffer
+	int vertexDataSize = 0;
+	int indexCount = 0;
+	for (int i = 0; i < model->meshCount; i++)
+	{
+		const Mesh *mesh = &model->meshes[i];
+		GLTFVertexAttribute formats[GLTF_VERTEX_ATTRIBUTES];
+		int offsets[GLTF_VERTEX_ATTRIBUTES];
+		GetGLTFMeshAttributes(mesh, (meshAttributes != NULL)? &meshAttributes[i*GLTF_VERTEX_ATTRIBUTES] : NULL, formats);
+
+		vertexOffsets[i] = vertexDataSize;
+		model->meshFirstIndex[i] = indexCount;
+		vertexDataSize += mesh->vertexCount*GetGLTFInterleavedLayout(formats, offsets);
+		if (mesh->indices != NULL) indexCount += mesh->triangleCount*3;
+	}
+
+	unsigned char *vertices = RL_MALLOC(vertexDataSize);
+	unsigned short *indices = (indexCount > 0)? RL_MALLOC(indexCount*sizeof(unsigned short)) : NULL;
+	for (int i = 0; i < model->meshCount; i++)
+	{
+		const Mesh *mesh = &model->meshes[i];
+		GLTFVertexAttribute formats[GLTF_VERTEX_ATTRIBUTES];
+		int offsets[GLTF_VERTEX_ATTRIBUTES];
+		GetGLTFMeshAttributes(mesh, (meshAttributes != NULL)? &meshAttributes[i*GLTF_VERTEX_ATTRIBUTES] : NULL, formats);
+
+		int stride = GetGLTFInterleavedLayout(formats, offsets);
+		InterleaveGLTFVertices(mesh->vertexCount, formats, offsets, stride, vertices + vertexOffsets[i]);
+		if (mesh->indices != NULL) memcpy(indices + model->meshFirstIndex[i], mesh->indices, mesh->triangleCount*3*sizeof(unsigned short));
+	}
+
+	model->vertexBuffer = rlLoadVertexBuffer(vertices, vertexDataSize, false);
+	if (indices != NULL) model->indexBuffer = rlLoadVertexBufferElement(indices, indexCount*sizeof(unsigned short), false);
+	RL_FREE(vertices);
+	RL_FREE(indices);
+
+	// Set every mesh vertex array attributes to its vertices range
+	for (int i = 0; i < model->meshCount; i++)
+	{
+		Mesh *mesh = &model->meshes[i];
+		GLTFVertexAttribute formats[GLTF_VERTEX_ATTRIBUTES];
+		int offsets[GLTF_VERTEX_ATTRIBUTES];
+		GetGLTFMeshAttributes(mesh, (meshAttributes != NULL)? &meshAttributes[i*GLTF_VERTEX_ATTRIBUTES] : NULL, formats);
+
+		mesh->vaoId = (i == 0)? vaoId : rlLoadVertexArray();
+		mesh->vboId[GLTF_VERTEX_BUFFER_POSITION] = model->vertexBuffer;
+		if (mesh->indices != NULL) mesh->vboId[GLTF_VERTEX_BUFFER_INDICES] = model->indexBuffer;
+
+		rlEnableVertexArray(mesh->vaoId);
+		rlEnableVertexBuffer(model->vertexBuffer);
+		SetGLTFInterleavedAttributes(formats, offsets, GetGLTFInterleavedLayout(formats, offsets), vertexOffsets[i]);
+		if (mesh->indices != NULL) rlEnableVertexBufferElement(model->indexBuffer);
+		rlDisableVertexArray();
+	}
+	rlDisableVertexBuffer();
+	rlDisableVertexBufferElement();
+
+	RL_FREE(vertexOffsets);
+
+	TRACELOG(LOG_INFO, "VAO: [ID %i] Model meshes uploaded successfully to VRAM (GPU), shared vertex buffer (%i meshes)", model->meshes[0].vaoId, model->meshCount);
+
+	return true;
+}
+
+// Get size of the morph targets deltas texture uploaded by UploadGLTFMorphTargets()
+static int GetGLTFMorphDataSize(const GLTFMorphTargets *morph)
+{
+	if ((morph == NULL) || (morph->deltaCount == 0)) return 0;
+
+	int height = (morph->deltaCount*2 + GLTF_MORPH_TEXTURE_WIDTH - 1)/GLTF_MORPH_TEXTURE_WIDTH;
+	if (height > GLTF_MORPH_TEXTURE_MAX_HEIGHT) return 0;
+
+	return GLTF_MORPH_TEXTURE_WIDTH*height*4*(int)sizeof(float);
+}
+
+// Upload morph targets deltas to a float texture, GLTF_MORPH_TEXTURE_WIDTH texels wide (2 texels per delta)
+// NOTE: Float textures are required and texture height is limited to GLTF_MORPH_TEXTURE_MAX_HEIGHT, otherwise the
+// mesh is drawn without morph targets
+static void UploadGLTFMorphTargets(GLTFMorphTargets *morph)
+{
+	if ((morph == NULL) || (morph->deltaCount == 0) || (morph->textureId != 0)) return;
+
+	int height = (morph->deltaCount*2 + GLTF_MORPH_TEXTURE_WIDTH - 1)/GLTF_MORPH_TEXTURE_WIDTH;
+	if (height > GLTF_MORPH_TEXTURE_MAX_HEIGHT)
+	{
+		TRACELOG(LOG_WARNING, "MESH: Morph targets deltas (%i) exceed the max texture height (%i), morphed mesh is drawn without them", morph->deltaCount, GLTF_MORPH_TEXTURE_MAX_HEIGHT);
+		return;
+	}
+
+	float *texels = RL_CALLOC(GLTF_MORPH_TEXTURE_WIDTH*height*4, sizeof(float));
+	memcpy(texels, morph->deltas, morph->deltaCount*8*sizeof(float));
+
+	morph->textureId = rlLoadTexture(texels, GLTF_MORPH_TEXTURE_WIDTH, height, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+	RL_FREE(texels);
+
+	if (morph->textureId == 0) TRACELOG(LOG_WARNING, "MESH: Morph targets require float textures, morphed mesh is drawn without them");
+}
+
+// Free mesh CPU arrays selected by flags (GLTFMeshDataFlags) once the mesh is uploaded to GPU
+// NOTE: With arenas, these arrays are allocated from the scratch arena, released with the upload data
+// (arrays of cached models are pModel arena memory, they are kept until the pModel is unloaded)
+// Arrays pointing to memory-mapped files are not freed, the files are released with the upload data
+static void FreeGLTFUploadedMeshData(Mesh *mesh, unsigned int flags, GLTFArena *arena, GLTFArena *scratch, const GLTFFileList *mappedFiles)
+{
+	if (mesh->vboId == NULL) return;
+
+#define FREE_MESH_DATA(field, flag) \
+	if (flags & flag) \
+	{ \
+		if (!IsGLTFArenaMemory(arena, mesh->field) && !IsGLTFMappedMemory(mappedFiles, mesh->field, 1)) FreeGLTFArray(scratch, mesh->field); \
+		mesh->field = NULL; \
+	}
+
+	FREE_MESH_DATA(vertices, GLTF_MESH_DATA_VERTICES)
+	FREE_MESH_DATA(texcoords, GLTF_MESH_DATA_TEXCOORDS)
+	FREE_MESH_DATA(texcoords2, GLTF_MESH_DATA_TEXCOORDS)
+	FREE_MESH_DATA(normals, GLTF_MESH_DATA_NORMALS)
+	FREE_MESH_DATA(tangents, GLTF_MESH_DATA_TANGENTS)
+	FREE_MESH_DATA(colors, GLTF_MESH_DATA_COLORS)
+	FREE_MESH_DATA(indices, GLTF_MESH_DATA_INDICES)
+
+#undef FREE_MESH_DATA
+}
+
+// Get asset cache key of a decoded image (models loaded from binary caches have no image keys)
+static uint64_t GetGLTFImageKey(const Image *image)
+{
+	int header[4] = { image->width, image->height, image->mipmaps, image->format };
+	uint64_t seed = GetGLTFHash((const unsigned char *)header, sizeof(header), GLTF_HASH_SEED);
+
+	return GetGLTFAssetKey(image->data, GetPixelDataSize(image->width, image->height, image->format), seed);
+}
+
+// Load texture from image, shared through the asset cache if an image with the same key was already uploaded
+static Texture2D LoadGLTFAssetTexture(GLTFAssetCache *cache, uint64_t key, Image image, bool *shared)
+{
+	GLTFAsset asset = { 0 };
+	asset.type = GLTF_ASSET_TEXTURE;
+	asset.key = key;
+
+	*shared = (cache != NULL) && (key != 0) && AcquireGLTFAsset(cache, &asset);
+	if (*shared) return asset.texture;
+
+	asset.texture = LoadTextureFromImage(image);
+	if ((cache != NULL) && (key != 0) && (asset.texture.id != 0)) AddGLTFAsset(cache, asset);
+
+	return asset.texture;
+}
+
+// Get asset cache key of a material content: shader, maps and parameters
+// NOTE: MaterialMap has no padding, maps are hashed at once
+static uint64_t GetGLTFMaterialKey(Material material)
+{
+	uint64_t hash = GetGLTFHash((const unsigned char *)&material.shader.id, sizeof(material.shader.id), GLTF_HASH_SEED);
+	hash = GetGLTFHash((const unsigned char *)&material.shader.locs, sizeof(material.shader.locs), hash);
+	hash = GetGLTFHash((const unsigned char *)material.params, sizeof(material.params), hash);
+
+	return GetGLTFAssetKey(material.maps, MAX_MATERIAL_MAPS*sizeof(MaterialMap), hash);
+}
+
+// Share pModel materials through the asset cache, once their textures are uploaded
+// NOTE: Materials with the same content use the same maps array, changing it changes every pModel using it
+static void ShareGLTFModelMaterials(GLTFModel *model, GLTFLoadStats *stats)
+{
+	for (int i = 0; i < model->materialCount; i++)
+	{
+		Material *material = &model->materials[i];
+		if (material->maps == NULL) continue;
+
+		GLTFAsset asset = { 0 };
+		asset.type = GLTF_ASSET_MATERIAL;
+		asset.key = GetGLTFMaterialKey(*material);
+
+		if (AcquireGLTFAsset(model->assetCache, &asset))
+		{
+			if (stats != NULL) stats->sharedMaterials++;
+		}
+		else
+		{
+			asset.material = *material;
+			asset.material.maps = RL_MALLOC(MAX_MATERIAL_MAPS*sizeof(MaterialMap));
+			memcpy(asset.material.maps, material->maps, MAX_MATERIAL_MAPS*sizeof(MaterialMap));
+			AddGLTFAsset(model->assetCache, asset);
+		}
+
+		FreeGLTFArray(model->arena, material->maps);
+		*material = asset.material;
+	}
+}
+
+// Upload pModel textures and meshes to GPU within budget, returns true when everything is uploaded
+static bool UploadGLTFModelItems(GLTFModelUpload *upload, int byteBudget, float timeBudget)
+{
+	GLTFModel *model = &upload->model;
+	double startTime = (timeBudget > 0.0f)? GetTime() : 0.0;
+	int uploadedItems = 0;
+	int uploadedBytes = 0;
+
+	if (upload->uploadedTextures < upload->imageCount)
+	{
+		while (upload->uploadedTextures < upload->imageCount)
+		{
+			Image *image = &upload->images[upload->uploadedTextures];
+			int size = (image->data != NULL)? GetPixelDataSize(image->width, image->height, image->format) : 0;
+
+			if (!IsGLTFUploadBudgetLeft(uploadedItems, uploadedBytes, size, byteBudget, startTime, timeBudget)) return false;
+
+			if (image->data != NULL)
+			{
+				uint64_t key = 0;
+				if (model->assetCache != NULL) key = (upload->imageKeys != NULL)? upload->imageKeys[upload->uploadedTextures] : GetGLTFImageKey(image);
+
+				bool shared = false;
+				model->textures[upload->uploadedTextures] = LoadGLTFAssetTexture(model->assetCache, key, *image, &shared);
+				if (shared && (upload->stats != NULL)) upload->stats->sharedTextures++;
+
+				if (!IsGLTFArenaMemory(upload->scratch, image->data)) UnloadImage(*image);
+				image->data = NULL;
+				uploadedItems++;
+				uploadedBytes += size;
+			}
+
+			upload->uploadedTextures++;
+		}
+
+		// Assign uploaded textures to the materials maps using them
+		for (int i = 0; (upload->materialImages != NULL) && (i < model->materialCount*MAX_MATERIAL_MAPS); i++)
+		{
+			int image = upload->materialImages[i];
+			if ((image >= 0) && (model->textures[image].id != 0)) model->materials[i/MAX_MATERIAL_MAPS].maps[i%MAX_MATERIAL_MAPS].texture = model->textures[image];
+		}
+	}
+
+	// Upload every mesh vertex data at once to the shared buffers (a single upload item)
+	// NOTE: Meshes are uploaded one by one to their own buffers if vertex arrays are not supported
+	if ((upload->vertexLayout == GLTF_VERTEX_LAYOUT_SHARED) && (upload->uploadedMeshes == 0) && (model->meshCount > 0))
+	{
+		int size = 0;
+		int indexSize = 0;
+		int morphSize = 0;
+		for (int i = 0; i < model->meshCount; i++)
+		{
+			size += GetGLTFMeshDataSize(model->meshes[i], (upload->meshAttributes != NULL)? &upload->meshAttributes[i*GLTF_VERTEX_ATTRIBUTES] : NULL);
+			indexSize += GetGLTFMeshIndexDataSize(&model->meshes[i]);
+			if (model->meshMorphs != NULL) morphSize += GetGLTFMorphDataSize(&model->meshMorphs[i]);
+		}
+
+		if (!IsGLTFUploadBudgetLeft(uploadedItems, uploadedBytes, size + morphSize, byteBudget, startTime, timeBudget)) return false;
+
+		if (UploadGLTFSharedMeshes(model, upload->meshAttributes))
+		{
+			for (int i = 0; (model->meshMorphs != NULL) && (i < model->meshCount); i++) UploadGLTFMorphTargets(&model->meshMorphs[i]);
+
+			if (upload->stats != NULL)
+			{
+				upload->stats->vertexBytes += (unsigned int)(size - indexSize);
+				upload->stats->indexBytes += (unsigned int)indexSize;
+			}
+
+			for (int i = 0; (upload->meshAttributes != NULL) && (i < model->meshCount*GLTF_VERTEX_ATTRIBUTES); i++)
+			{
+				FreeGLTFArray(upload->scratch, upload->meshAttributes[i].data);
+				upload->meshAttributes[i].data = NULL;
+			}
+			for (int i = 0; i < model->meshCount; i++) FreeGLTFUploadedMeshData(&model->meshes[i], upload->freeMeshData, model->arena, upload->scratch, &upload->mappedFiles);
+
+			upload->uploadedMeshes = model->meshCount;
+			return true;
+		}
+	}
+
+	// Upload vertex data to GPU (static mesh)
+	while (upload->uploadedMeshes < model->meshCount)
+	{
+		Mesh *mesh = &model->meshes[upload->uploadedMeshes];
+		GLTFVertexAttribute *attributes = (upload->meshAttributes != NULL)? &upload->meshAttributes[upload->uploadedMeshes*GLTF_VERTEX_ATTRIBUTES] : NULL;
+		GLTFMorphTargets *morph = (model->meshMorphs != NULL)? &model->meshMorphs[upload->uploadedMeshes] : NULL;
+		int size = GetGLTFMeshDataSize(*mesh, attributes);
+		int morphSize = GetGLTFMorphDataSize(morph);
+
+		if (!IsGLTFUploadBudgetLeft(uploadedItems, uploadedBytes, size + morphSize, byteBudget, startTime, timeBudget)) return false;
+
+		if (upload->stats != NULL)
+		{
+			int indexSize = GetGLTFMeshIndexDataSize(mesh);
+			upload->stats->vertexBytes += (unsigned int)(size - indexSize);
+			upload->stats->indexBytes += (unsigned int)indexSize;
+		}
+
+		UploadGLTFMesh(mesh, attributes, upload->vertexLayout != GLTF_VERTEX_LAYOUT_SEPARATE);
+		UploadGLTFMorphTargets(morph);
+		for (int i = 0; (attributes != NULL) && (i < GLTF_VERTEX_ATTRIBUTES); i++)
+		{
+			FreeGLTFArray(upload->scratch, attributes[i].data);
+			attributes[i].data = NULL;
+		}
+		FreeGLTFUploadedMeshData(mesh, upload->freeMeshData, model->arena, upload->scratch, &upload->mappedFiles);
+
+		uploadedItems++;
+		uploadedBytes += size + morphSize;
+		upload->uploadedMeshes++;
+	}
+
+	return true;
+}
+
+// Upload pModel textures and meshes to GPU, returns true when everything is uploaded
+// NOTE: Uploading stops once byteBudget bytes or timeBudget seconds are used (0: no limit)
+static bool UploadGLTFModelData(GLTFModelUpload *upload, int byteBudget, float timeBudget)
+{
+	double startTime = (upload->stats != NULL)? GetTime() : 0.0;
+
+	bool uploaded = UploadGLTFModelItems(upload, byteBudget, timeBudget);
+	if (uploaded && (upload->model.assetCache != NULL)) ShareGLTFModelMaterials(&upload->model, upload->stats);
+
+	if (upload->stats != NULL) upload->stats->uploadTime += GetTime() - startTime;
+
+	return uploaded;
+}
+
+// Release pModel upload data (not uploaded images)
+static void UnloadGLTFModelUpload(GLTFModelUpload *upload)
+{
+	// NOTE: Cached images data is released with the scratch arena
+	for (int i = upload->uploadedTextures; i < upload->imageCount; i++)
+	{
+		if (!IsGLTFArenaMemory(upload->scratch, upload->images[i].data)) UnloadImage(upload->images[i]);
+	}
+
+	for (int i = upload->uploadedMeshes*GLTF_VERTEX_ATTRIBUTES; (upload->meshAttributes != NULL) && (i < upload->model.meshCount*GLTF_VERTEX_ATTRIBUTES); i++) FreeGLTFArray(upload->scratch, upload->meshAttributes[i].data);
+
+	FreeGLTFArray(upload->scratch, upload->images);
+	FreeGLTFArray(upload->scratch, upload->imageKeys);
+	FreeGLTFArray(upload->scratch, upload->materialImages);
+	FreeGLTFArray(upload->scratch, upload->meshAttributes);
+	UnloadGLTFArena(upload->scratch);
+
+	// NOTE: Not uploaded mesh arrays can't point to the mapped files once released
+	for (int i = upload->uploadedMeshes; (upload->mappedFiles.count > 0) && (i < upload->model.meshCount); i++)
+	{
+		Mesh *mesh = &upload->model.meshes[i];
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->vertices, 1)) mesh->vertices = NULL;
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->texcoords, 1)) mesh->texcoords = NULL;
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->normals, 1)) mesh->normals = NULL;
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->tangents, 1)) mesh->tangents = NULL;
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->colors, 1)) mesh->colors = NULL;
+		if (IsGLTFMappedMemory(&upload->mappedFiles, mesh->indices, 1)) mesh->indices = NULL;
+	}
+	UnloadGLTFMappedFiles(&upload->mappedFiles);
+
+	upload->images = NULL;
+	upload->imageKeys = NULL;
+	upload->materialImages = NULL;
+	upload->meshAttributes = NULL;
+	upload->scratch = NULL;
+	upload->imageCount = 0;
+}
+
+// Upload all pModel data to GPU
+static GLTFModel UploadGLTFModel(GLTFModelUpload upload, const char *fileName)
+{
+	BeginGLTFModelUpload(&upload, fileName);
+	UploadGLTFModelData(&upload, 0, 0.0f);
+	UnloadGLTFModelUpload(&upload);
+
+	return upload.model;
+}
+
+/**
+ * Load glTF 2.0 pModel
+ * 		Function implemented by Wilhem Barbier(@wbrbr), with modifications by Tyler Bezera(@gamerfiend)
+ * 		and Roy Qu(@royqh1979)
+ *
+ * 		FEATURES:
+ * 		- Supports .gltf and .glb files
+ * 		- Supports embedded (base64) or external textures
+ * 		- Supports PBR metallic/roughness flow, loads material textures, values and colors
+ * 		PBR specular/glossiness flow and extended texture flows not supported
+ * 		- Supports multiple meshes per pModel (every primitives is loaded as a separate mesh)
+ * 		- Supports EXT_mesh_gpu_instancing node instances
+ * 		- Ray and box queries (GetRayCollisionGLTFModel(), GetGLTFModelBoxOverlaps()), accelerated by a triangles BVH per mesh
+ * 		and a node instances BVH refit when node transforms change (GenGLTFModelBVH())
+ * 		- Supports MSFT_lod node and material levels of detail (MSFT_screencoverage hints), draw functions select the level
+ * 		of every node from its screen coverage, with hysteresis (GLTF_LOD_HYSTERESIS) if the levels of every drawn instance
+ * 		are provided (GLTFDrawList.lodLevels, SetGLTFDrawLodLevels()), DrawGLTFModelInstanced() draws level 0
+ * 		- Model files and external buffers are memory-mapped when supported (define RGLTF_NO_MMAP to disable)
+ * 		- Supports loading from memory with user resolved external buffers and images (LoadGLTFModelFromMemory())
+ * 		- Material images are decoded in parallel (GLTFLoadOptions.imageThreads, define RGLTF_NO_THREADS to disable)
+ * 		- Mesh primitives are decoded in parallel (GLTFLoadOptions.meshThreads), Draco primitives on the calling thread
+ * 		- Images shared by materials are decoded and uploaded once (pModel.textures, unloaded with the pModel)
+ * 		- Textures (by image file path or encoded data), materials and shaders can be shared by several models through
+ * 		a refcounted asset cache (GLTFLoadOptions.assetCache, LoadGLTFAssetShader()), cached images are not decoded again
+ * 		- Supports asynchronous loading with time-sliced GPU uploads (LoadGLTFModelAsync())
+ * 		- Loaded CPU data can be saved to a binary cache file (SaveGLTFModelCache()), loaded with almost no CPU work
+ * 		(LoadGLTFModelCache()), caches are checked against the glTF files content hash and rebuilt when stale
+ * 		- Model CPU data can be allocated from a few memory blocks, released at once (GLTFLoadOptions.arena)
+ * 		- Mesh CPU arrays can be freed once uploaded to GPU, all of them or some (GLTFLoadOptions.freeMeshData)
+ * 		- Supports skins with GPU skinning (joint matrices palette per skin, see GLTF_SHADER_UNIFORM_JOINT_MATRICES), joints
+ * 		and weights are uploaded to GPU as they are (JOINTS_0: u8, u16, WEIGHTS_0: float, normalized u8, u16)
+ * 		- Supports node animations (translation, rotation, scale and weights channels), sampled in batches into per instance
+ * 		poses (GLTFAnimationState) that set the animated nodes transforms and morph target weights
+ * 		- Supports morph targets (position and normal deltas) blended on GPU, only the deltas of moved vertices are kept in a
+ * 		float texture per mesh, weights are copied per node when drawn (see GLTF_SHADER_UNIFORM_MORPH_DELTAS, SetGLTFNodeMorphWeights())
+ * 		- Supports sparse accessors, applied to dense copies of their data when loaded
+ * 		- Mesh vertices can be uploaded interleaved, per mesh or in a single pModel vertex and index buffer (GLTFLoadOptions.vertexLayout)
+ * 		- Loading statistics: stages times, bytes read, decoded images, uploaded vertex data (GLTFLoadOptions.stats, LoadGLTFModelEx()),
+ * 		drawing statistics: visited and culled nodes, draw calls, material switches (SetGLTFDrawStats(), GLTFDrawList.stats)
+ * 		- Supports KHR_draco_mesh_compression with a user decoder (GLTFLoadOptions.decodeDraco, see draco/rgltf_draco.h)
+ * 		- Supports KHR_texture_basisu (KTX2) images with a user transcoder (GLTFLoadOptions.transcodeImage, see basisu/rgltf_basisu.h),
+ * 		transcoded to the best compressed format supported by the GPU (ASTC 4x4, DXT5, ETC2), otherwise fallback images are used
+ * 		- Supports EXT_meshopt_compression (define RGLTF_SUPPORT_MESHOPT, otherwise fallback buffers are used)
+ * 		- Supports KHR_mesh_quantization, quantized attributes are uploaded to GPU in their compact formats
+ * 		(mesh CPU data is always float, set GLTFLoadOptions.dequantize to upload floats)
+ *
+ * 		RESTRICTIONS:
+ * 		- Only triangle meshes supported
+ * 		- Vertex attibute types and formats supported:
+ * 		> Vertices (position): vec3: float, i8, u8, i16, u16 (normalized or not)
+ * 		> Normals: vec3: float, i8, i16 (normalized)
+ * 		> Tangents: vec4: float, i8, i16 (normalized)
+ * 		> Texcoords: vec2: float, i8, u8, i16, u16 (normalized or not)
+ * 		> Colors: vec4: u8, u16, f32 (normalized)
+ * 		> Indices: u16, u32 (primitives with more than 65536 vertices are split in several meshes)
+ * 		> Morph targets: POSITION, NORMAL: vec3: float, i8, i16 (normalized or not), at most GLTF_MAX_MORPH_TARGETS
+ * 		(TANGENT deltas and Draco compressed primitives targets not supported)
+ */
+GLTFModel  LoadGLTFModel(const char* fileName) {
+	return LoadGLTFModelEx(fileName, NULL);
+}
+
+// Load glTF pModel with loading options (NULL: default options)
+GLTFModel LoadGLTFModelEx(const char *fileName, const GLTFLoadOptions *options)
+{
+	return UploadGLTFModel(LoadGLTFModelData(NULL, 0, fileName, NULL, options), fileName);
+}
+
+// Load glTF pModel from memory
+// NOTE: data is only required while loading, external buffers and images are loaded with options->resolveUri
+// if provided, otherwise read from files (relative to basePath)
+GLTFModel LoadGLTFModelFromMemory(const unsigned char *data, int size, const char *basePath, GLTFLoadOptions *options)
+{
+	if ((data == NULL) || (size <= 0))
+	{
+		TRACELOG(LOG_WARNING, "MODEL: Invalid glTF data provided");
+		return UploadGLTFModel((GLTFModelUpload){ 0 }, "memory");
+	}
+
+	if ((basePath != NULL) && (basePath[0] == '\0')) basePath = NULL;
+
+	return UploadGLTFModel(LoadGLTFModelData(data, size, "memory", basePath, options), "memory");
+}
+
+// Model cache file: header, external resource uris and two relocatable data blocks, pModel data (kept in the
+// pModel arena) and upload data (images and compact vertex attributes, released once uploaded to GPU)
+// NOTE: Every block starts with its struct (GLTFModel, GLTFModelUpload) followed by the arrays, pointers are stored
+// as block offsets (+1, 0: NULL) and arrays are 16 bytes aligned, so blocks are copied at once and relocated in place
+#define GLTF_CACHE_VERSION          3
+#define GLTF_CACHE_ALIGN(size)      (((size) + 15) & ~(size_t)15)
+
+// Load options the cached data depends on (GLTFCacheHeader.flags)
+#define GLTF_CACHE_DEQUANTIZE       1
+#define GLTF_CACHE_TRANSCODE        2
+#define GLTF_CACHE_DRACO            4
+
+typedef struct GLTFCacheHeader {
+	char magic[4];              // Cache file identifier: "RGLC"
+	unsigned int version;       // Cache format version (GLTF_CACHE_VERSION)
+	unsigned int layout;        // Structs layout signature, caches are only loaded by builds with the same layout
+	unsigned int flags;         // Load options the data was loaded with
+	int textureFormat;          // Pixel format of transcoded images (0: no transcoder)
+	uint64_t sourceHash;        // Content hash of the glTF file and its external resources
+	uint64_t sourcesSize;       // Size of the external resources uris (NUL terminated), placed after the header
+	uint64_t modelSize;         // Model data block size
+	uint64_t uploadSize;        // Upload data block size
+} GLTFCacheHeader;
+
+// Cache data block being written
+typedef struct GLTFCacheBlock {
+	unsigned char *data;
+	size_t size;
+	size_t capacity;
+} GLTFCacheBlock;
+
+// Hash file content (and size), continuing from a previous hash, missing files only hash their zero size
+static uint64_t GetGLTFFileHash(const char *path, uint64_t hash)
+{
+	size_t size = 0;
+	unsigned char *data = MapGLTFFile(path, &size);
+	bool mapped = (data != NULL);
+
+	if (!mapped && FileExists(path))
+	{
+		unsigned int dataSize = 0;
+		data = LoadFileData(path, &dataSize);
+		size = dataSize;
+	}
+
+	uint64_t fileSize = (data != NULL)? size : 0;
+	hash = GetGLTFHash((const unsigned char *)&fileSize, sizeof(fileSize), hash);
+	if (data != NULL) hash = GetGLTFHash(data, size, hash);
+
+#if defined(RGLTF_SUPPORT_MMAP)
+	if (mapped) munmap(data, size);
+	else
+#endif
+	UnloadFileData(data);
+
+	return hash;
+}
+
+// Load external resources uris of a glTF file (buffers and images not embedded) as NUL terminated strings
+// NOTE: Only the glTF JSON is parsed, returned data must be freed with RL_FREE()
+static char *LoadGLTFCacheSources(const char *fileName, size_t *size)
+{
+	cgltf_options options = { 0 };
+	cgltf_data *data = NULL;
+	char *sources = NULL;
+	*size = 0;
+
+	if (cgltf_parse_file(&options, fileName, &data) != cgltf_result_success) return NULL;
+
+	for (unsigned int i = 0; i < data->buffers_count + data->images_count; i++)
+	{
+		const char *uri = (i < data->buffers_count)? data->buffers[i].uri : data->images[i - data->buffers_count].uri;
+		if ((uri == NULL) || (uri[0] == '\0') || (strncmp(uri, "data:", 5) == 0)) continue;
+
+		size_t length = strlen(uri) + 1;
+		sources = RL_REALLOC(sources, *size + length);
+		memcpy(sources + *size, uri, length);
+		*size += length;
+	}
+
+	cgltf_free(data);
+
+	return sources;
+}
+
+// Get content hash of a glTF file and its external resources (uris relative to the glTF file)
+static uint64_t GetGLTFSourceHash(const char *fileName, const char *sources, size_t sourcesSize)
+{
+	uint64_t hash = GetGLTFFileHash(fileName, GLTF_HASH_SEED);
+
+	for (size_t i = 0; i < sourcesSize; i += strlen(&sources[i]) + 1)
+	{
+		char *path = GetGLTFResourcePath(fileName, &sources[i]);
+		hash = GetGLTFFileHash(path, hash);
+		RL_FREE(path);
+	}
+
+	return hash;
+}
 
-	// Combine pModel transformation matrix (pModel.transform) with matrix generated by function parameters (matTransform)
-	model.transform = MatrixMultiply(model.transform, matTransform);
-	if (model.scene >= 0
-		&& model.scene < model.sceneCount
-		&& model.scenes[model.scene].nodeCount>0) { // we have a scene to draw
-		DrawGLTFScene(model, model.scene, model.transform, tint);
-	} else {
-		for (int i = 0; i < model.meshCount; i++) {
-			Color color = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color;
-			Color colorTint = WHITE;
-			colorTint.r = (unsigned char) ((((float) color.r / 255.0) * ((float) tint.r / 255.0)) * 255.0f);
-			colorTint.g = (unsigned char) ((((float) color.g / 255.0) * ((float) tint.g / 255.0)) * 255.0f);
-			colorTint.b = (unsigned char) ((((float) color.b / 255.0) * ((float) tint.b / 255.0)) * 255.0f);
-			colorTint.a = (unsigned char) ((((float) color.a / 255.0) * ((float) tint.a / 255.0)) * 255.0f);
+// Get structs layout signature, cached blocks are only valid for the same structs layout
+static unsigned int GetGLTFCacheLayout(void)
+{
+	const uint64_t sizes[] = { sizeof(void *), sizeof(GLTFModel), sizeof(Mesh), sizeof(Material), sizeof(MaterialMap), sizeof(GLTFNode),
+		sizeof(GLTFScene), sizeof(GLTFSkin), sizeof(GLTFAnimation), sizeof(GLTFAnimationTrack), sizeof(GLTFModelUpload),
+		sizeof(GLTFVertexAttribute), sizeof(Image), sizeof(GLTFMorphTargets), MAX_MESH_VERTEX_BUFFERS, MAX_MATERIAL_MAPS, GLTF_VERTEX_ATTRIBUTES };
+
+	return (unsigned int)GetGLTFHash((const unsigned char *)sizes, sizeof(sizes), GLTF_HASH_SEED);
+}
+
+// Get load options the cached data depends on
+static unsigned int GetGLTFCacheFlags(const GLTFLoadOptions *options)
+{
+	if (options == NULL) return 0;
+
+	return (options->dequantize? GLTF_CACHE_DEQUANTIZE : 0) | ((options->transcodeImage != NULL)? GLTF_CACHE_TRANSCODE : 0) |
+		((options->decodeDraco != NULL)? GLTF_CACHE_DRACO : 0);
+}
+
+// Get pixel format images are transcoded to by a load with these options (0: no transcoder)
+// NOTE: Without a forced format it's the GPU best supported one, caches saved on another GPU can be stale
+static int GetGLTFCacheTextureFormat(const GLTFLoadOptions *options)
+{
+	if ((options == NULL) || (options->transcodeImage == NULL)) return 0;
+
+	return (options->textureFormat != 0)? options->textureFormat : GetGLTFTranscodeFormat();
+}
+
+// Get image data size, including its mipmaps
+static int GetGLTFImageDataSize(Image image)
+{
+	int size = 0;
+	for (int i = 0, width = image.width, height = image.height; i < ((image.mipmaps > 0)? image.mipmaps : 1); i++)
+	{
+		size += GetPixelDataSize(width, height, image.format);
+		width = (width > 1)? width/2 : 1;
+		height = (height > 1)? height/2 : 1;
+	}
+
+	return size;
+}
+
+// Get number of values of an animation track (components per key, in-tangent, value and out-tangent for cubic splines)
+static size_t GetGLTFAnimationTrackValueCount(const GLTFAnimationTrack *track)
+{
+	size_t count = (size_t)track->keyCount*track->components;
+	return (track->interpolation == GLTF_INTERPOLATION_CUBICSPLINE)? count*3 : count;
+}
+
+// Append array to cache block (16 bytes aligned), returns its block offset as pointer (offset + 1, NULL if no array)
+static void *WriteGLTFCacheArray(GLTFCacheBlock *block, const void *data, size_t size)
+{
+	if (data == NULL) return NULL;
+
+	size_t offset = GLTF_CACHE_ALIGN(block->size);
+	if (offset + size > block->capacity)
+	{
+		size_t capacity = (block->capacity > 0)? block->capacity*2 : 64*1024;
+		while (capacity < offset + size) capacity *= 2;
+		block->data = RL_REALLOC(block->data, capacity);
+		block->capacity = capacity;
+	}
+
+	memset(block->data + block->size, 0, offset - block->size);
+	memcpy(block->data + offset, data, size);
+	block->size = offset + size;
+
+	return (void *)(uintptr_t)(offset + 1);
+}
+
+#define WRITE_CACHE_ARRAY(block, array, count) WriteGLTFCacheArray(block, array, (size_t)(count)*sizeof(*(array)))
+
+// Write pModel data block: meshes, materials, nodes, scenes, skins and animations
+// NOTE: GPU resources are not written, textures are reloaded from the upload images
+static void WriteGLTFModelCache(GLTFCacheBlock *block, const GLTFModel *model)
+{
+	GLTFModel cache = *model;
+	cache.arena = NULL;
+	cache.bvh = NULL;
+	cache.assetCache = NULL;
+	WriteGLTFCacheArray(block, &cache, sizeof(GLTFModel));
+
+	Mesh *meshes = RL_CALLOC(model->meshCount + 1, sizeof(Mesh));
+	for (int i = 0; (model->meshes != NULL) && (i < model->meshCount); i++)
+	{
+		Mesh mesh = model->meshes[i];
+		mesh.vertices = WRITE_CACHE_ARRAY(block, mesh.vertices, mesh.vertexCount*3);
+		mesh.texcoords = WRITE_CACHE_ARRAY(block, mesh.texcoords, mesh.vertexCount*2);
+		mesh.texcoords2 = WRITE_CACHE_ARRAY(block, mesh.texcoords2, mesh.vertexCount*2);
+		mesh.normals = WRITE_CACHE_ARRAY(block, mesh.normals, mesh.vertexCount*3);
+		mesh.tangents = WRITE_CACHE_ARRAY(block, mesh.tangents, mesh.vertexCount*4);
+		mesh.colors = WRITE_CACHE_ARRAY(block, mesh.colors, mesh.vertexCount*4);
+		mesh.indices = WRITE_CACHE_ARRAY(block, mesh.indices, mesh.triangleCount*3);
+		mesh.animVertices = WRITE_CACHE_ARRAY(block, mesh.animVertices, mesh.vertexCount*3);
+		mesh.animNormals = WRITE_CACHE_ARRAY(block, mesh.animNormals, mesh.vertexCount*3);
+		mesh.boneIds = WRITE_CACHE_ARRAY(block, mesh.boneIds, mesh.vertexCount*4);
+		mesh.boneWeights = WRITE_CACHE_ARRAY(block, mesh.boneWeights, mesh.vertexCount*4);
+		mesh.vaoId = 0;
+		mesh.vboId = WRITE_CACHE_ARRAY(block, mesh.vboId, MAX_MESH_VERTEX_BUFFERS);
+		meshes[i] = mesh;
+	}
+	cache.meshes = (model->meshes != NULL)? WRITE_CACHE_ARRAY(block, meshes, model->meshCount) : NULL;
+	RL_FREE(meshes);
+
+	// NOTE: Materials shaders are set again when loaded
+	Material *materials = RL_CALLOC(model->materialCount + 1, sizeof(Material));
+	for (int i = 0; (model->materials != NULL) && (i < model->materialCount); i++)
+	{
+		materials[i] = model->materials[i];
+		materials[i].shader = (Shader){ 0 };
+		materials[i].maps = WRITE_CACHE_ARRAY(block, model->materials[i].maps, MAX_MATERIAL_MAPS);
+	}
+	cache.materials = (model->materials != NULL)? WRITE_CACHE_ARRAY(block, materials, model->materialCount) : NULL;
+	RL_FREE(materials);
+
+	cache.meshMaterial = WRITE_CACHE_ARRAY(block, model->meshMaterial, model->meshCount);
+	cache.meshBounds = WRITE_CACHE_ARRAY(block, model->meshBounds, model->meshCount);
+
+	// NOTE: Morph targets deltas textures are uploaded again with the meshes
+	GLTFMorphTargets *morphs = RL_CALLOC(model->meshCount + 1, sizeof(GLTFMorphTargets));
+	for (int i = 0; (model->meshMorphs != NULL) && (i < model->meshCount); i++)
+	{
+		morphs[i] = model->meshMorphs[i];
+		morphs[i].vertexDeltas = WRITE_CACHE_ARRAY(block, model->meshMorphs[i].vertexDeltas, model->meshes[i].vertexCount + 1);
+		morphs[i].deltas = WRITE_CACHE_ARRAY(block, model->meshMorphs[i].deltas, model->meshMorphs[i].deltaCount*8);
+		morphs[i].textureId = 0;
+	}
+	cache.meshMorphs = (model->meshMorphs != NULL)? WRITE_CACHE_ARRAY(block, morphs, model->meshCount) : NULL;
+	RL_FREE(morphs);
+
+	cache.materialLodStart = WRITE_CACHE_ARRAY(block, model->materialLodStart, model->materialCount + 1);
+	cache.materialLods = WRITE_CACHE_ARRAY(block, model->materialLods, (model->materialLodStart != NULL)? model->materialLodStart[model->materialCount] : 0);
+
+	Texture2D *textures = RL_CALLOC(model->textureCount + 1, sizeof(Texture2D));
+	cache.textures = (model->textures != NULL)? WRITE_CACHE_ARRAY(block, textures, model->textureCount + 1) : NULL;
+	RL_FREE(textures);
+
+	GLTFNode *nodes = RL_CALLOC(model->nodeCount + 1, sizeof(GLTFNode));
+	for (int i = 0; (model->nodes != NULL) && (i < model->nodeCount); i++)
+	{
+		nodes[i] = model->nodes[i];
+		nodes[i].children = WRITE_CACHE_ARRAY(block, model->nodes[i].children, model->nodes[i].childrenCount);
+		nodes[i].instanceTransforms = WRITE_CACHE_ARRAY(block, model->nodes[i].instanceTransforms, model->nodes[i].instanceCount);
+		nodes[i].lodNodes = WRITE_CACHE_ARRAY(block, model->nodes[i].lodNodes, model->nodes[i].lodCount);
+		nodes[i].lodCoverage = WRITE_CACHE_ARRAY(block, model->nodes[i].lodCoverage, model->nodes[i].lodCount + 1);
+		nodes[i].weights = WRITE_CACHE_ARRAY(block, model->nodes[i].weights, (model->nodes[i].weightCount + 3) & ~3);
+	}
+	cache.nodes = (model->nodes != NULL)? WRITE_CACHE_ARRAY(block, nodes, model->nodeCount) : NULL;
+	RL_FREE(nodes);
+
+	cache.sortedNodes = WRITE_CACHE_ARRAY(block, model->sortedNodes, model->nodeCount);
+	cache.worldTransforms = WRITE_CACHE_ARRAY(block, model->worldTransforms, model->nodeCount);
+
+	GLTFScene *scenes = RL_CALLOC(model->sceneCount + 1, sizeof(GLTFScene));
+	for (int i = 0; (model->scenes != NULL) && (i < model->sceneCount); i++)
+	{
+		scenes[i] = model->scenes[i];
+		scenes[i].nodes = WRITE_CACHE_ARRAY(block, model->scenes[i].nodes, model->scenes[i].nodeCount);
+	}
+	cache.scenes = (model->scenes != NULL)? WRITE_CACHE_ARRAY(block, scenes, model->sceneCount) : NULL;
+	RL_FREE(scenes);
+
+	GLTFSkin *skins = RL_CALLOC(model->skinCount + 1, sizeof(GLTFSkin));
+	for (int i = 0; (model->skins != NULL) && (i < model->skinCount); i++)
+	{
+		const GLTFSkin *skin = &model->skins[i];
+		skins[i].jointCount = skin->jointCount;
+		skins[i].joints = WRITE_CACHE_ARRAY(block, skin->joints, skin->jointCount);
+		skins[i].inverseBindMatrices = WRITE_CACHE_ARRAY(block, skin->inverseBindMatrices, skin->jointCount);
+		skins[i].jointMatrices = WRITE_CACHE_ARRAY(block, skin->jointMatrices, skin->jointCount*12);
+	}
+	cache.skins = (model->skins != NULL)? WRITE_CACHE_ARRAY(block, skins, model->skinCount) : NULL;
+	RL_FREE(skins);
 
-			model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
-			DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
-			model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = color;
+	// NOTE: Animation keyframes are kept in two contiguous arrays, tracks point inside them
+	GLTFAnimation *animations = RL_CALLOC(model->animationCount + 1, sizeof(GLTFAnimation));
+	for (int i = 0; (model->animations != NULL) && (i < model->animationCount); i++)
+	{
+		const GLTFAnimation *animation = &model->animations[i];
+		animations[i] = *animation;
+		animations[i].nodes = WRITE_CACHE_ARRAY(block, animation->nodes, animation->nodeCount);
+		if (animation->trackCount == 0) continue;
+
+		size_t timeCount = 0, valueCount = 0;
+		for (int t = 0; t < animation->trackCount; t++)
+		{
+			timeCount += animation->tracks[t].keyCount;
+			valueCount += GetGLTFAnimationTrackValueCount(&animation->tracks[t]);
+		}
+
+		uintptr_t times = (uintptr_t)WRITE_CACHE_ARRAY(block, animation->tracks[0].times, timeCount);
+		uintptr_t values = (uintptr_t)WRITE_CACHE_ARRAY(block, animation->tracks[0].values, valueCount);
+		GLTFAnimationTrack *tracks = RL_MALLOC(animation->trackCount*sizeof(GLTFAnimationTrack));
+		for (int t = 0; t < animation->trackCount; t++)
+		{
+			tracks[t] = animation->tracks[t];
+			tracks[t].times = (float *)(times + (uintptr_t)(animation->tracks[t].times - animation->tracks[0].times)*sizeof(float));
+			tracks[t].values = (float *)(values + (uintptr_t)(animation->tracks[t].values - animation->tracks[0].values)*sizeof(float));
 		}
+		animations[i].tracks = WRITE_CACHE_ARRAY(block, tracks, animation->trackCount);
+		RL_FREE(tracks);
 	}
+	cache.animations = (model->animations != NULL)? WRITE_CACHE_ARRAY(block, animations, model->animationCount) : NULL;
+	RL_FREE(animations);
+
+	memcpy(block->data, &cache, sizeof(GLTFModel));
 }
 
-// Draw a pModel wires (with texture if set)
-void DrawGLTFModelWires(GLTFModel model, Vector3 position, float scale, Color tint)
+// Write upload data block: decoded images, material images and compact vertex attributes
+static void WriteGLTFModelUploadCache(GLTFCacheBlock *block, const GLTFModelUpload *upload)
 {
-	rlEnableWireMode();
+	const GLTFModel *model = &upload->model;
+	GLTFModelUpload cache = { 0 };
+	cache.imageCount = upload->imageCount;
+	WriteGLTFCacheArray(block, &cache, sizeof(GLTFModelUpload));
 
-	DrawGLTFModel(model, position, scale, tint);
+	Image *images = RL_CALLOC(upload->imageCount + 1, sizeof(Image));
+	for (int i = 0; (upload->images != NULL) && (i < upload->imageCount); i++)
+	{
+		images[i] = upload->images[i];
+		images[i].data = WriteGLTFCacheArray(block, upload->images[i].data, GetGLTFImageDataSize(upload->images[i]));
+	}
+	cache.images = (upload->images != NULL)? WRITE_CACHE_ARRAY(block, images, upload->imageCount + 1) : NULL;
+	RL_FREE(images);
 
-	rlDisableWireMode();
+	cache.materialImages = WRITE_CACHE_ARRAY(block, upload->materialImages, model->materialCount*MAX_MATERIAL_MAPS);
+
+	int attributeCount = model->meshCount*GLTF_VERTEX_ATTRIBUTES + 1;
+	GLTFVertexAttribute *attributes = RL_CALLOC(attributeCount, sizeof(GLTFVertexAttribute));
+	for (int i = 0; (upload->meshAttributes != NULL) && (i < attributeCount - 1); i++)
+	{
+		attributes[i] = upload->meshAttributes[i];
+		attributes[i].data = WRITE_CACHE_ARRAY(block, upload->meshAttributes[i].data, model->meshes[i/GLTF_VERTEX_ATTRIBUTES].vertexCount*upload->meshAttributes[i].elementSize);
+	}
+	cache.meshAttributes = (upload->meshAttributes != NULL)? WRITE_CACHE_ARRAY(block, attributes, attributeCount) : NULL;
+	RL_FREE(attributes);
+
+	memcpy(block->data, &cache, sizeof(GLTFModelUpload));
 }
 
-// Draw a pModel wires (with texture if set) with extended parameters
-void DrawGLTFModelWiresEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+// Save pModel upload data (loaded, not uploaded to GPU yet) to a cache file
+static bool SaveGLTFModelUploadCache(const GLTFModelUpload *upload, const char *fileName, const char *cacheFileName, unsigned int flags, int textureFormat)
 {
-	rlEnableWireMode();
+	GLTFCacheHeader header = { 0 };
+	memcpy(header.magic, "RGLC", 4);
+	header.version = GLTF_CACHE_VERSION;
+	header.layout = GetGLTFCacheLayout();
+	header.flags = flags;
+	header.textureFormat = textureFormat;
+	size_t sourcesSize = 0;
+	char *sources = LoadGLTFCacheSources(fileName, &sourcesSize);
+	header.sourceHash = GetGLTFSourceHash(fileName, sources, sourcesSize);
+	header.sourcesSize = sourcesSize;
 
-	DrawGLTFModelEx(model, position, rotationAxis, rotationAngle, scale, tint);
+	GLTFCacheBlock modelBlock = { 0 };
+	GLTFCacheBlock uploadBlock = { 0 };
+	WriteGLTFModelCache(&modelBlock, &upload->model);
+	WriteGLTFModelUploadCache(&uploadBlock, upload);
+	header.modelSize = modelBlock.size;
+	header.uploadSize = uploadBlock.size;
 
-	rlDisableWireMode();
+	GLTFCacheBlock file = { 0 };
+	WriteGLTFCacheArray(&file, &header, sizeof(GLTFCacheHeader));
+	if (sourcesSize > 0) WriteGLTFCacheArray(&file, sources, sourcesSize);
+	WriteGLTFCacheArray(&file, modelBlock.data, modelBlock.size);
+	WriteGLTFCacheArray(&file, uploadBlock.data, uploadBlock.size);
+
+	bool success = SaveFileData(cacheFileName, file.data, (unsigned int)file.size);
+	if (success) TRACELOG(LOG_INFO, "MODEL: [%s] Model cache saved successfully", cacheFileName);
+	else TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to save model cache", cacheFileName);
+
+	RL_FREE(file.data);
+	RL_FREE(modelBlock.data);
+	RL_FREE(uploadBlock.data);
+	RL_FREE(sources);
+
+	return success;
 }
 
-// Draw a Model's scene (with texture if set)
-void DrawGLTFNode(GLTFModel model,int node_id, Matrix matTransform, Color tint) {
-    if (node_id >= 0
-        && node_id < model.nodeCount) {
-        GLTFNode node = model.nodes[node_id];
-        Matrix nodeTransform = MatrixMultiply(node.transformMatrix, matTransform);
-        if (node.childrenCount>0) {
-            for (int i = 0; i < node.childrenCount; i++){
-                DrawGLTFNode(model,node.children[i],nodeTransform,tint);
-            }
-        } else {
-            for (int j = node.meshStart; j < node.meshEnd; j++) {
-                Color color = model.materials[model.meshMaterial[j]].maps[MATERIAL_MAP_DIFFUSE].color;
-                Color colorTint = WHITE;
-                colorTint.r = (unsigned char) ((((float) color.r / 255.0) * ((float) tint.r / 255.0)) * 255.0f);
-                colorTint.g = (unsigned char) ((((float) color.g / 255.0) * ((float) tint.g / 255.0)) * 255.0f);
-                colorTint.b = (unsigned char) ((((float) color.b / 255.0) * ((float) tint.b / 255.0)) * 255.0f);
-                colorTint.a = (unsigned char) ((((float) color.a / 255.0) * ((float) tint.a / 255.0)) * 255.0f);
-
-                model.materials[model.meshMaterial[j]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
-                DrawMesh(model.meshes[j], model.materials[model.meshMaterial[j]], nodeTransform);
-                model.materials[model.meshMaterial[j]].maps[MATERIAL_MAP_DIFFUSE].color = color;
-            }
-        }
-    }
+// Relocate a cache block pointer (offset + 1) to block memory, arrays of bytes length not fully inside the block
+// fail the cache loading
+// NOTE: Lengths are computed from element counts read from the block, they are checked as 64 bit values so
+// negative or overflowing counts are rejected too
+#define RELOCATE_CACHE_POINTER(ptr, bytes, base, size) \
+	if (((ptr) != NULL) && (((uintptr_t)(ptr) > (size) + 1) || ((int64_t)(bytes) < 0) || ((uint64_t)(bytes) > (size) + 1 - (uintptr_t)(ptr)))) \
+	{ \
+		(ptr) = NULL; \
+		valid = false; \
+	} \
+	else if ((ptr) != NULL) (ptr) = (void *)((base) + (uintptr_t)(ptr) - 1)
+
+// Relocate pModel data block arrays
+static bool RelocateGLTFModelCache(GLTFModel *model, unsigned char *base, size_t size)
+{
+	bool valid = true;
+
+	RELOCATE_CACHE_POINTER(model->meshes, (int64_t)model->meshCount*sizeof(Mesh), base, size);
+	for (int i = 0; valid && (model->meshes != NULL) && (i < model->meshCount); i++)
+	{
+		Mesh *mesh = &model->meshes[i];
+		int64_t vertexCount = mesh->vertexCount;
+		RELOCATE_CACHE_POINTER(mesh->vertices, vertexCount*3*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->texcoords, vertexCount*2*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->texcoords2, vertexCount*2*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->normals, vertexCount*3*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->tangents, vertexCount*4*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->colors, vertexCount*4*sizeof(unsigned char), base, size);
+		RELOCATE_CACHE_POINTER(mesh->indices, (int64_t)mesh->triangleCount*3*sizeof(unsigned short), base, size);
+		RELOCATE_CACHE_POINTER(mesh->animVertices, vertexCount*3*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->animNormals, vertexCount*3*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->boneIds, vertexCount*4*sizeof(unsigned char), base, size);
+		RELOCATE_CACHE_POINTER(mesh->boneWeights, vertexCount*4*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(mesh->vboId, MAX_MESH_VERTEX_BUFFERS*sizeof(unsigned int), base, size);
+	}
+
+	RELOCATE_CACHE_POINTER(model->materials, (int64_t)model->materialCount*sizeof(Material), base, size);
+	for (int i = 0; valid && (model->materials != NULL) && (i < model->materialCount); i++) RELOCATE_CACHE_POINTER(model->materials[i].maps, MAX_MATERIAL_MAPS*sizeof(MaterialMap), base, size);
+
+	RELOCATE_CACHE_POINTER(model->meshMaterial, (int64_t)model->meshCount*sizeof(int), base, size);
+	RELOCATE_CACHE_POINTER(model->meshBounds, (int64_t)model->meshCount*sizeof(BoundingBox), base, size);
+	RELOCATE_CACHE_POINTER(model->meshMorphs, (int64_t)model->meshCount*sizeof(GLTFMorphTargets), base, size);
+	for (int i = 0; valid && (model->meshMorphs != NULL) && (i < model->meshCount); i++)
+	{
+		int64_t vertexCount = (model->meshes != NULL)? model->meshes[i].vertexCount : 0;
+		RELOCATE_CACHE_POINTER(model->meshMorphs[i].vertexDeltas, (vertexCount + 1)*sizeof(int), base, size);
+		RELOCATE_CACHE_POINTER(model->meshMorphs[i].deltas, (int64_t)model->meshMorphs[i].deltaCount*8*sizeof(float), base, size);
+	}
+	RELOCATE_CACHE_POINTER(model->materialLodStart, ((int64_t)model->materialCount + 1)*sizeof(int), base, size);
+	RELOCATE_CACHE_POINTER(model->materialLods, (model->materialLodStart != NULL)? (int64_t)model->materialLodStart[model->materialCount]*sizeof(int) : 0, base, size);
+	RELOCATE_CACHE_POINTER(model->textures, ((int64_t)model->textureCount + 1)*sizeof(Texture2D), base, size);
+
+	RELOCATE_CACHE_POINTER(model->nodes, (int64_t)model->nodeCount*sizeof(GLTFNode), base, size);
+	for (int i = 0; valid && (model->nodes != NULL) && (i < model->nodeCount); i++)
+	{
+		GLTFNode *node = &model->nodes[i];
+		RELOCATE_CACHE_POINTER(node->children, (int64_t)node->childrenCount*sizeof(int), base, size);
+		RELOCATE_CACHE_POINTER(node->instanceTransforms, (int64_t)node->instanceCount*sizeof(Matrix), base, size);
+		RELOCATE_CACHE_POINTER(node->lodNodes, (int64_t)node->lodCount*sizeof(int), base, size);
+		RELOCATE_CACHE_POINTER(node->lodCoverage, ((int64_t)node->lodCount + 1)*sizeof(float), base, size);
+		RELOCATE_CACHE_POINTER(node->weights, (((int64_t)node->weightCount + 3) & ~3)*sizeof(float), base, size);
+	}
+	RELOCATE_CACHE_POINTER(model->sortedNodes, (int64_t)model->nodeCount*sizeof(int), base, size);
+	RELOCATE_CACHE_POINTER(model->worldTransforms, (int64_t)model->nodeCount*sizeof(Matrix), base, size);
+
+	RELOCATE_CACHE_POINTER(model->scenes, (int64_t)model->sceneCount*sizeof(GLTFScene), base, size);
+	for (int i = 0; valid && (model->scenes != NULL) && (i < model->sceneCount); i++) RELOCATE_CACHE_POINTER(model->scenes[i].nodes, (int64_t)model->scenes[i].nodeCount*sizeof(int), base, size);
+
+	RELOCATE_CACHE_POINTER(model->skins, (int64_t)model->skinCount*sizeof(GLTFSkin), base, size);
+	for (int i = 0; valid && (model->skins != NULL) && (i < model->skinCount); i++)
+	{
+		GLTFSkin *skin = &model->skins[i];
+		RELOCATE_CACHE_POINTER(skin->joints, (int64_t)skin->jointCount*sizeof(int), base, size);
+		RELOCATE_CACHE_POINTER(skin->inverseBindMatrices, (int64_t)skin->jointCount*sizeof(Matrix), base, size);
+		RELOCATE_CACHE_POINTER(skin->jointMatrices, (int64_t)skin->jointCount*12*sizeof(float), base, size);
+	}
+
+	RELOCATE_CACHE_POINTER(model->animations, (int64_t)model->animationCount*sizeof(GLTFAnimation), base, size);
+	for (int i = 0; valid && (model->animations != NULL) && (i < model->animationCount); i++)
+	{
+		GLTFAnimation *animation = &model->animations[i];
+		RELOCATE_CACHE_POINTER(animation->nodes, (int64_t)animation->nodeCount*sizeof(int), base, size);
+		RELOCATE_CACHE_POINTER(animation->tracks, (int64_t)animation->trackCount*sizeof(GLTFAnimationTrack), base, size);
+		for (int t = 0; valid && (animation->tracks != NULL) && (t < animation->trackCount); t++)
+		{
+			GLTFAnimationTrack *track = &animation->tracks[t];
+			uint64_t valueCount = ((track->keyCount >= 0) && (track->components >= 0))? (uint64_t)track->keyCount*(uint64_t)track->components : UINT64_MAX;
+			if ((valueCount != UINT64_MAX) && (track->interpolation == GLTF_INTERPOLATION_CUBICSPLINE)) valueCount *= 3;
+			RELOCATE_CACHE_POINTER(track->times, (int64_t)track->keyCount*sizeof(float), base, size);
+			RELOCATE_CACHE_POINTER(track->values, (valueCount <= size)? valueCount*sizeof(float) : UINT64_MAX, base, size);
+		}
+	}
+
+	return valid;
 }
 
-// Draw a Model's scene wires (with texture if set)
-void DrawGLTFNodeWires(GLTFModel model, int node_id, Matrix matTransform, Color tint)
+// Check a cached image size, so its data size (GetGLTFImageDataSize()) can't overflow
+static bool IsGLTFCacheImageValid(Image image)
 {
-    rlEnableWireMode();
+	return (image.width > 0) && (image.height > 0) && (image.mipmaps >= 0) && (image.mipmaps <= 32) &&
+		((int64_t)image.width*image.height <= INT_MAX/32);
+}
 
-    DrawGLTFNode(model, node_id, matTransform, tint);
+// Relocate upload data block arrays, pModel is the relocated pModel data block
+// NOTE: Material images must be images of the block and vertex attributes valid GPU formats
+static bool RelocateGLTFModelUploadCache(GLTFModelUpload *upload, const GLTFModel *model, unsigned char *base, size_t size)
+{
+	bool valid = (upload->imageCount >= 0);
 
-    rlDisableWireMode();
+	RELOCATE_CACHE_POINTER(upload->images, ((int64_t)upload->imageCount + 1)*sizeof(Image), base, size);
+	for (int i = 0; valid && (upload->images != NULL) && (i < upload->imageCount); i++)
+	{
+		valid = IsGLTFCacheImageValid(upload->images[i]);
+		RELOCATE_CACHE_POINTER(upload->images[i].data, valid? GetGLTFImageDataSize(upload->images[i]) : 0, base, size);
+	}
+
+	RELOCATE_CACHE_POINTER(upload->materialImages, (int64_t)model->materialCount*MAX_MATERIAL_MAPS*sizeof(int), base, size);
+	for (int i = 0; valid && (upload->materialImages != NULL) && (i < model->materialCount*MAX_MATERIAL_MAPS); i++)
+	{
+		valid = (upload->materialImages[i] >= -1) && (upload->materialImages[i] < ((upload->images != NULL)? upload->imageCount : 0));
+	}
+
+	RELOCATE_CACHE_POINTER(upload->meshAttributes, ((int64_t)model->meshCount*GLTF_VERTEX_ATTRIBUTES + 1)*sizeof(GLTFVertexAttribute), base, size);
+	for (int i = 0; valid && (upload->meshAttributes != NULL) && (i < model->meshCount*GLTF_VERTEX_ATTRIBUTES); i++)
+	{
+		GLTFVertexAttribute *attribute = &upload->meshAttributes[i];
+		if (attribute->data == NULL) continue;
+
+		valid = (model->meshes != NULL) && (attribute->elementSize > 0) && (attribute->elementSize <= 16) && (attribute->elementSize%4 == 0) &&
+			(attribute->components > 0) && (attribute->components <= 4);
+		RELOCATE_CACHE_POINTER(attribute->data, valid? (int64_t)model->meshes[i/GLTF_VERTEX_ATTRIBUTES].vertexCount*attribute->elementSize : 0, base, size);
+	}
+
+	return valid;
 }
 
-// Draw a Model's scene with extended parameters
-void DrawGLTFScene(GLTFModel model, int scene_id, Matrix matTransform, Color tint)
+#undef RELOCATE_CACHE_POINTER
+#undef WRITE_CACHE_ARRAY
+
+// Load pModel upload data from a cache file, fails if the cache is missing, stale or saved by a different build
+// NOTE: Model block is copied to the pModel arena and upload block to the scratch arena (released once uploaded)
+static bool LoadGLTFModelUploadCache(const char *cacheFileName, const char *fileName, unsigned int flags, int textureFormat, GLTFModelUpload *upload, GLTFLoadStats *stats)
 {
-	if (scene_id >= 0
-		&& scene_id < model.sceneCount) {
-		for (int i = 0; i < model.scenes[scene_id].nodeCount; i++) {
-			int node_id = model.scenes[scene_id].nodes[i];
-            DrawGLTFNode(model,node_id,matTransform,tint);
+	size_t size = 0;
+	unsigned char *data = MapGLTFFile(cacheFileName, &size);
+	bool mapped = (data != NULL);
+
+	if (!mapped && FileExists(cacheFileName))
+	{
+		unsigned int dataSize = 0;
+		data = LoadFileData(cacheFileName, &dataSize);
+		size = dataSize;
+	}
+
+	GLTFCacheHeader header = { 0 };
+	if ((data != NULL) && (size >= sizeof(GLTFCacheHeader))) memcpy(&header, data, sizeof(GLTFCacheHeader));
+
+	bool valid = (memcmp(header.magic, "RGLC", 4) == 0) && (header.version == GLTF_CACHE_VERSION) && (header.layout == GetGLTFCacheLayout()) &&
+		(header.flags == flags) && (header.textureFormat == textureFormat) && (header.sourcesSize <= size) && (header.modelSize <= size) && (header.uploadSize <= size) &&
+		(header.modelSize >= sizeof(GLTFModel)) && (header.uploadSize >= sizeof(GLTFModelUpload));
+
+	size_t modelOffset = GLTF_CACHE_ALIGN(sizeof(GLTFCacheHeader) + (valid? header.sourcesSize : 0));
+	size_t uploadOffset = GLTF_CACHE_ALIGN(modelOffset + (valid? header.modelSize : 0));
+	const char *sources = (const char *)data + sizeof(GLTFCacheHeader);
+
+	valid = valid && (uploadOffset + header.uploadSize == size) && ((header.sourcesSize == 0) || (sources[header.sourcesSize - 1] == '\0'));
+	valid = valid && (GetGLTFSourceHash(fileName, sources, header.sourcesSize) == header.sourceHash);
+
+	if (valid)
+	{
+		// NOTE: Blocks get some extra space so empty arrays placed at their end are still arena memory
+		GLTFArena *arena = LoadGLTFArena(header.modelSize + GLTF_ARENA_ALIGNMENT);
+		GLTFArena *scratch = LoadGLTFArena(header.uploadSize + GLTF_ARENA_ALIGNMENT);
+		unsigned char *modelData = AllocGLTFArena(arena, header.modelSize + GLTF_ARENA_ALIGNMENT);
+		unsigned char *uploadData = AllocGLTFArena(scratch, header.uploadSize + GLTF_ARENA_ALIGNMENT);
+		memcpy(modelData, data + modelOffset, header.modelSize);
+		memcpy(uploadData, data + uploadOffset, header.uploadSize);
+
+		GLTFModel model = { 0 };
+		memcpy(&model, modelData, sizeof(GLTFModel));
+		memcpy(upload, uploadData, sizeof(GLTFModelUpload));
+		upload->mappedFiles = (GLTFFileList){ 0 };     // NOTE: Cached mesh arrays never point to mapped files
+
+		valid = RelocateGLTFModelCache(&model, modelData, header.modelSize) && RelocateGLTFModelUploadCache(upload, &model, uploadData, header.uploadSize);
+		if (valid)
+		{
+			// NOTE: Materials get the default shader, cached maps keep their colors and values (textures are set once uploaded)
+			for (int i = 0; (model.materials != NULL) && (i < model.materialCount); i++)
+			{
+				Material material = LoadMaterialDefault();
+				for (int k = 0; (model.materials[i].maps != NULL) && (k < MAX_MATERIAL_MAPS); k++)
+				{
+					material.maps[k].color = model.materials[i].maps[k].color;
+					material.maps[k].value = model.materials[i].maps[k].value;
+				}
+				memcpy(material.params, model.materials[i].params, sizeof(material.params));
+				model.materials[i] = material;
+			}
+
+			model.arena = arena;
+			upload->model = model;
+			upload->scratch = scratch;
+			if (stats != NULL) stats->bytesRead = (unsigned int)size;
+		}
+		else
+		{
+			TRACELOG(LOG_WARNING, "MODEL: [%s] Model cache data is not valid", cacheFileName);
+			UnloadGLTFArena(arena);
+			UnloadGLTFArena(scratch);
+			*upload = (GLTFModelUpload){ 0 };
 		}
 	}
+
+#if defined(RGLTF_SUPPORT_MMAP)
+	if (mapped) munmap(data, size);
+	else
+#endif
+	UnloadFileData(data);
+
+	return valid;
 }
 
-// Draw a Model's scene wires (with texture if set)
-void DrawGLTFSceneWires(GLTFModel model, int scene_id, Matrix matTransform, Color tint)
+// Load glTF pModel CPU data and save it to a binary cache file, loaded with LoadGLTFModelCache()
+// NOTE: Cached data depends on the dequantize, transcodeImage and decodeDraco options and the transcoded images pixel format
+// (textureFormat or the GPU best supported one), caches loaded with different ones are stale
+// The asset cache is not used, every image is decoded to be saved
+bool SaveGLTFModelCache(const char *fileName, const char *cacheFileName, const GLTFLoadOptions *options)
 {
-	rlEnableWireMode();
+	GLTFLoadOptions dataOptions = (options != NULL)? *options : (GLTFLoadOptions){ 0 };
+	dataOptions.assetCache = NULL;
 
-	DrawGLTFScene(model, scene_id, matTransform, tint);
+	GLTFModelUpload upload = LoadGLTFModelData(NULL, 0, fileName, NULL, &dataOptions);
+	bool success = (upload.model.materialCount > 0) && SaveGLTFModelUploadCache(&upload, fileName, cacheFileName, GetGLTFCacheFlags(options), GetGLTFCacheTextureFormat(options));
 
-	rlDisableWireMode();
+	// NOTE: Nothing is uploaded to GPU, mesh arrays to be freed once uploaded are released with the upload data
+	for (int i = 0; i < upload.model.meshCount; i++) FreeGLTFUploadedMeshData(&upload.model.meshes[i], upload.freeMeshData, upload.model.arena, upload.scratch, &upload.mappedFiles);
+	UnloadGLTFModelUpload(&upload);
+	UnloadGLTFModel(upload.model);
+
+	return success;
 }
 
-void UnloadGLTFModel(GLTFModel model)
+// Load glTF pModel from a binary cache file, the cache is checked against the glTF file and its external
+// resources content, a missing or stale cache falls back to loading the glTF file (and the cache is saved again)
+// NOTE: Cached pModel CPU data is always allocated from an arena, mesh CPU arrays freed once uploaded are kept in it
+GLTFModel LoadGLTFModelCache(const char *cacheFileName, const char *fileName, const GLTFLoadOptions *options)
 {
-	// Unload meshes
-	for (int i = 0; i < model.meshCount; i++) UnloadMesh(model.meshes[i]);
+	unsigned int flags = GetGLTFCacheFlags(options);
+	int textureFormat = GetGLTFCacheTextureFormat(options);
+	GLTFModelUpload upload = { 0 };
 
-	// Unload materials maps
-	// NOTE: As the user could be sharing shaders and textures between models,
-	// we don't unload the material but just free it's maps,
-	// the user is responsible for freeing models shaders and textures
-	for (int i = 0; i < model.materialCount; i++) RL_FREE(model.materials[i].maps);
+	GLTFLoadStats *stats = (options != NULL)? options->stats : NULL;
+	double startTime = 0.0;
+	if (stats != NULL)
+	{
+		*stats = (GLTFLoadStats){ 0 };
+		startTime = GetTime();
+	}
 
-	// Unload arrays
-	RL_FREE(model.meshes);
-	RL_FREE(model.materials);
-	RL_FREE(model.meshMaterial);
+	if (LoadGLTFModelUploadCache(cacheFileName, fileName, flags, textureFormat, &upload, stats))
+	{
+		TRACELOG(LOG_INFO, "MODEL: [%s] Model data loaded from cache", cacheFileName);
+		if (stats != NULL) stats->parseTime = GetTime() - startTime;
+	}
+	else
+	{
+		TRACELOG(LOG_INFO, "MODEL: [%s] Model cache missing or stale, loading [%s]", cacheFileName, fileName);
 
-	// Unload scenes and nodes
-    for (int i = 0; i< model.nodeCount; i++) RL_FREE(model.nodes[i].children);
-	RL_FREE(model.nodes);
-	for (int i = 0; i < model.sceneCount; i++) RL_FREE(model.scenes[i].nodes);
-	RL_FREE(model.scenes);
+		// NOTE: Every image is decoded to be saved, textures are shared through the asset cache once uploaded
+		GLTFLoadOptions dataOptions = (options != NULL)? *options : (GLTFLoadOptions){ 0 };
+		dataOptions.assetCache = NULL;
 
-	TRACELOG(LOG_INFO, "MODEL: Unloaded pModel (and meshes) from RAM and VRAM");
+		upload = LoadGLTFModelData(NULL, 0, fileName, NULL, &dataOptions);
+		if (upload.model.materialCount > 0) SaveGLTFModelUploadCache(&upload, fileName, cacheFileName, flags, textureFormat);
+	}
+
+	upload.model.assetCache = (options != NULL)? options->assetCache : NULL;
+	upload.freeMeshData = (options != NULL)? options->freeMeshData : 0;
+	upload.vertexLayout = (options != NULL)? options->vertexLayout : GLTF_VERTEX_LAYOUT_SEPARATE;
+	upload.stats = stats;
+
+	return UploadGLTFModel(upload, fileName);
 }
 
-/**
- * Load glTF 2.0 pModel
- * 		Function implemented by Wilhem Barbier(@wbrbr), with modifications by Tyler Bezera(@gamerfiend)
- * 		and Roy Qu(@royqh1979)
- *
- * 		FEATURES:
- * 		- Supports .gltf and .glb files
- * 		- Supports embedded (base64) or external textures
- * 		- Supports PBR metallic/roughness flow, loads material textures, values and colors
- * 		PBR specular/glossiness flow and extended texture flows not supported
- * 		- Supports multiple meshes per pModel (every primitives is loaded as a separate mesh)
- *
- * 		RESTRICTIONS:
- * 		- Only triangle meshes supported
- * 		- Vertex attibute types and formats supported:
- * 		> Vertices (position): vec3: float
- * 		> Normals: vec3: float
- * 		> Texcoords: vec2: float
- * 		> Colors: vec4: u8, u16, f32 (normalized)
- * 		> Indices: u16, u32 (truncated to u16)
- */
-GLTFModel  LoadGLTFModel(const char* fileName) {
-	GLTFModel  model = LoadGLTFModelFile(fileName);
-	// Make sure pModel transform is set to identity matrix!
-	model.transform = MatrixIdentity();
+// Asynchronous pModel loading state
+struct GLTFModelAsync {
+	char *fileName;             // Model file name (copy)
+	GLTFLoadOptions options;    // Load options (copy)
+	GLTFModelUpload upload;     // Model data loaded by the background thread
+	bool loaded;                // CPU stage finished (written by the background thread)
+	bool uploading;             // GPU upload started
+	bool ready;                 // Model ready, every resource uploaded
+#if defined(RGLTF_SUPPORT_THREADS)
+	bool threadRunning;         // Background thread started and not joined yet
+	pthread_t thread;
+	pthread_mutex_t lock;
+#endif
+};
 
-	if (model.meshCount == 0)
+// Load pModel data on the CPU: parsing, buffers loading, attributes and images decoding
+static void *LoadGLTFModelAsyncWorker(void *arg)
+{
+	GLTFModelAsync *load = (GLTFModelAsync *)arg;
+	GLTFModelUpload upload = LoadGLTFModelData(NULL, 0, load->fileName, NULL, &load->options);
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_lock(&load->lock);
+#endif
+	load->upload = upload;
+	load->loaded = true;
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_unlock(&load->lock);
+#endif
+
+	return NULL;
+}
+
+// Wait for the background thread to finish the CPU stage
+static void WaitGLTFModelAsync(GLTFModelAsync *load)
+{
+#if defined(RGLTF_SUPPORT_THREADS)
+	if (load->threadRunning)
 	{
-		model.meshCount = 1;
-		model.meshes = (Mesh *)RL_CALLOC(model.meshCount, sizeof(Mesh));
-#if defined(SUPPORT_MESH_GENERATION)
-		TRACELOG(LOG_WARNING, "MESH: [%s] Failed to load mesh data, default to cube mesh", fileName);
-		model.meshes[0] = GenMeshCube(1.0f, 1.0f, 1.0f);
+		pthread_join(load->thread, NULL);
+		load->threadRunning = false;
+	}
 #else
-		TRACELOG(LOG_WARNING, "MESH: [%s] Failed to load mesh data", fileName);
+	(void)load;
 #endif
+}
+
+// Load glTF pModel asynchronously, CPU stages run on a background thread
+// NOTE: options->resolveUri is called from the background thread, GPU uploads are done by UpdateGLTFModelAsync()
+GLTFModelAsync *LoadGLTFModelAsync(const char *fileName, const GLTFLoadOptions *options)
+{
+	GLTFModelAsync *load = RL_CALLOC(1, sizeof(GLTFModelAsync));
+
+	size_t fileNameLength = strlen(fileName);
+	load->fileName = RL_MALLOC(fileNameLength + 1);
+	memcpy(load->fileName, fileName, fileNameLength + 1);
+	if (options != NULL) load->options = *options;
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_init(&load->lock, NULL);
+	load->threadRunning = (pthread_create(&load->thread, NULL, LoadGLTFModelAsyncWorker, load) == 0);
+
+	if (!load->threadRunning)
+	{
+		TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to start loading thread, loading synchronously", fileName);
+		LoadGLTFModelAsyncWorker(load);
 	}
-	else
+#else
+	LoadGLTFModelAsyncWorker(load);
+#endif
+
+	return load;
+}
+
+// Upload loaded pModel data to GPU within the given budget (0: no limit), returns true when the pModel is ready
+// NOTE: Call it every frame from the GL thread, at least one texture or mesh is uploaded per call
+bool UpdateGLTFModelAsync(GLTFModelAsync *load, int byteBudget, float timeBudget)
+{
+	if (load == NULL) return false;
+	if (load->ready) return true;
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_lock(&load->lock);
+	bool loaded = load->loaded;
+	pthread_mutex_unlock(&load->lock);
+#else
+	bool loaded = load->loaded;
+#endif
+
+	if (!loaded) return false;
+
+	WaitGLTFModelAsync(load);
+
+	if (!load->uploading)
 	{
-		// Upload vertex data to GPU (static mesh)
-		for (int i = 0; i < model.meshCount; i++) UploadMesh(&model.meshes[i], false);
+		BeginGLTFModelUpload(&load->upload, load->fileName);
+		load->uploading = true;
 	}
 
-	if (model.materialCount == 0)
+	if (UploadGLTFModelData(&load->upload, byteBudget, timeBudget))
 	{
-		TRACELOG(LOG_WARNING, "MATERIAL: [%s] Failed to load material data, default to white material", fileName);
+		UnloadGLTFModelUpload(&load->upload);
+		load->ready = true;
 
-		model.materialCount = 1;
-		model.materials = (Material *)RL_CALLOC(model.materialCount, sizeof(Material));
-		model.materials[0] = LoadMaterialDefault();
+		if (load->options.loadedCallback != NULL) load->options.loadedCallback(load, load->options.userData);
+	}
+
+	return load->ready;
+}
+
+// Check if asynchronously loaded pModel is ready (every resource uploaded)
+bool IsGLTFModelAsyncReady(const GLTFModelAsync *load)
+{
+	return (load != NULL) && load->ready;
+}
 
-		if (model.meshMaterial == NULL) model.meshMaterial = (int *)RL_CALLOC(model.meshCount, sizeof(int));
+// Get asynchronously loaded pModel, waits for loading and uploads remaining data if required
+// NOTE: The load handle is released, pModel must be unloaded with UnloadGLTFModel()
+GLTFModel FinishGLTFModelAsync(GLTFModelAsync *load)
+{
+	if (load == NULL) return (GLTFModel){ 0 };
+
+	WaitGLTFModelAsync(load);
+
+	if (!load->ready)
+	{
+		if (!load->uploading) BeginGLTFModelUpload(&load->upload, load->fileName);
+		UploadGLTFModelData(&load->upload, 0, 0.0f);
+		UnloadGLTFModelUpload(&load->upload);
 	}
 
-	return model;
+	GLTFModel model = load->upload.model;
+
+#if defined(RGLTF_SUPPORT_THREADS)
+	pthread_mutex_destroy(&load->lock);
+#endif
+	RL_FREE(load->fileName);
+	RL_FREE(load);
 
+	return model;
 }
 
 
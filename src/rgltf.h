@@ -32,6 +32,42 @@ extern "C" {            // Prevents name mangling of functions
 
 struct GLTFModel;
 
+// Memory arena backing pModel CPU data (GLTFLoadOptions.arena)
+typedef struct GLTFArena GLTFArena;
+
+// Model acceleration structure for ray and box queries (GenGLTFModelBVH())
+typedef struct GLTFModelBVH GLTFModelBVH;
+
+// Textures, materials and shaders shared by the models loaded with it (GLTFLoadOptions.assetCache), refcounted
+typedef struct GLTFAssetCache GLTFAssetCache;
+
+// GPU skinning shader interface: skinned meshes joints and weights vertex attributes locations (vec4, joint indices
+// are not normalized, declare them with layout(location = n)) and joint matrices uniform, every joint matrix is sent
+// as its 3 first rows (affine transform), so a vertex position (w = 1) is transformed by joint j as:
+// vec3(dot(jointMatrices[3*j], pos), dot(jointMatrices[3*j + 1], pos), dot(jointMatrices[3*j + 2], pos))
+#define GLTF_SHADER_ATTRIB_LOCATION_JOINTS      6
+#define GLTF_SHADER_ATTRIB_LOCATION_WEIGHTS     7
+#define GLTF_SHADER_UNIFORM_JOINT_MATRICES      "jointMatrices"     // uniform vec4 jointMatrices[3*MAX_JOINTS]
+
+// GPU morph targets shader interface: morphed meshes deltas vertex attribute location (vec2: first delta and number of
+// deltas of the vertex), deltas texture sampler (RGBA32F, GLTF_MORPH_TEXTURE_WIDTH texels per row) and weights uniform.
+// Only the vertices moved by a target have a delta for it, delta d is stored as 2 texels: 2*d (position delta xyz,
+// target index w) and 2*d + 1 (normal delta xyz), so a vertex is morphed adding for every one of its deltas:
+// weight*delta, with weight = morphWeights[target/4][target%4] (texelFetch(morphDeltas, ivec2(i%WIDTH, i/WIDTH), 0))
+#define GLTF_SHADER_ATTRIB_LOCATION_MORPH       8
+#define GLTF_SHADER_UNIFORM_MORPH_DELTAS        "morphDeltas"       // uniform sampler2D morphDeltas
+#define GLTF_SHADER_UNIFORM_MORPH_WEIGHTS       "morphWeights"      // uniform vec4 morphWeights[GLTF_MAX_MORPH_TARGETS/4]
+#define GLTF_MORPH_TEXTURE_WIDTH                1024
+#if !defined(GLTF_MORPH_TEXTURE_MAX_HEIGHT)
+    #define GLTF_MORPH_TEXTURE_MAX_HEIGHT       4096    // Deltas texture height limit (GL_MAX_TEXTURE_SIZE, meshes with more deltas are not morphed)
+#endif
+#define GLTF_MAX_MORPH_TARGETS                  128     // Maximum number of morph targets of a mesh (further targets are ignored)
+
+// Level of detail (MSFT_lod) hysteresis: a node switches to a finer level once its screen coverage is this fraction
+// above the level threshold, and to a coarser one once it is this fraction below, so levels don't flicker at the limit
+// NOTE: It needs the levels drawn last by every pModel instance (GLTFDrawList.lodLevels, SetGLTFDrawLodLevels())
+#define GLTF_LOD_HYSTERESIS     0.1f
+
 // glTF Model Node
 typedef struct GLTFNode {
     int childrenCount;            // Children nodes count;
@@ -41,8 +77,80 @@ typedef struct GLTFNode {
 	int meshEnd;                  // End position of the interval in the pModel mesh array;
 	Transform transform;          // Transform for node meshes;
 	Matrix transformMatrix;       // Transform matrix for node meshes;
+	int parent;                   // Parent node id (-1 for root nodes);
+	// nodes are also kept topologically sorted in pModel.sortedNodes, every subtree is a contiguous range
+	int orderStart;               // Position of the node in the pModel sorted node array;
+	int orderEnd;                 // End position of the node subtree in the pModel sorted node array;
+	bool dirty;                   // Transform changed since the last world transforms update;
+	int instanceCount;            // Number of mesh instances (EXT_mesh_gpu_instancing), 0 if not instanced;
+	Matrix *instanceTransforms;   // Instance transform matrices, relative to the node;
+	BoundingBox bounds;           // Bounds of the node meshes (in pModel space);
+	BoundingBox subtreeBounds;    // Bounds of the node and its descendants meshes (in pModel space);
+	int skin;                     // Skin id of the node meshes (-1: not skinned), skinned meshes ignore the node transform;
+	// MSFT_lod levels: level 0 is the node itself, level i (1..lodCount) is lodNodes[i - 1], drawn instead of the node subtree
+	int lodCount;                 // Number of lower levels of detail (0: no levels of detail);
+	int *lodNodes;                // Node ids of the lower levels (-1: the node itself, drawn with its materials lower levels);
+	float *lodCoverage;           // Minimum screen coverage (projected height / viewport height) of every level (lodCount + 1 values),
+	                              // the node isn't drawn below the last one (MSFT_screencoverage, 0: always drawn);
+	int weightCount;              // Number of morph target weights of the node meshes (0: not morphed);
+	float *weights;               // Morph target weights (node or mesh weights, padded with zeros to a multiple of 4);
 } GLTFNode;
 
+// Skin, joints are pModel nodes
+typedef struct GLTFSkin {
+	int jointCount;               // Number of joints
+	int *joints;                  // Joint node ids
+	Matrix *inverseBindMatrices;  // Inverse bind matrix of every joint
+	float *jointMatrices;         // Joint matrices palette (3 rows per joint), updated with the world transforms
+} GLTFSkin;
+
+// Animated node property of an animation track
+typedef enum {
+	GLTF_ANIMATION_TRANSLATION = 0,   // Node translation (3 floats per key)
+	GLTF_ANIMATION_ROTATION,          // Node rotation quaternion (4 floats per key)
+	GLTF_ANIMATION_SCALE,             // Node scale (3 floats per key)
+	GLTF_ANIMATION_WEIGHTS            // Node meshes morph target weights (one float per target per key)
+} GLTFAnimationPath;
+
+// Keyframes interpolation of an animation track
+typedef enum {
+	GLTF_INTERPOLATION_LINEAR = 0,    // Linear interpolation (spherical for rotations)
+	GLTF_INTERPOLATION_STEP,          // Previous keyframe value
+	GLTF_INTERPOLATION_CUBICSPLINE    // Cubic spline, every key stores in-tangent, value and out-tangent
+} GLTFInterpolation;
+
+// Animation track, keyframes of an animated node property
+typedef struct GLTFAnimationTrack {
+	int node;                     // Animated node id
+	int path;                     // Animated node property (GLTFAnimationPath)
+	int interpolation;            // Keyframes interpolation (GLTFInterpolation)
+	int components;               // Number of floats per key (3, 4, number of morph targets for weights)
+	int keyCount;                 // Number of keyframes
+	float *times;                 // Keyframe times (seconds, increasing)
+	float *values;                // Keyframe values (components floats per key, 3 times as many for cubic splines)
+} GLTFAnimationTrack;
+
+// Animation, keyframe times and values of all its tracks are kept in two contiguous arrays
+typedef struct GLTFAnimation {
+	char name[32];                // Animation name
+	float duration;               // Animation duration (seconds, last keyframe time)
+	int trackCount;               // Number of tracks
+	GLTFAnimationTrack *tracks;   // Tracks array
+	int nodeCount;                // Number of nodes with animated transforms
+	int *nodes;                   // Ids of the nodes with animated transforms
+	int weightCount;              // Number of morph target weights of the weights tracks
+} GLTFAnimation;
+
+// Mesh morph targets, deltas of the vertices actually moved by every target, blended on GPU
+// NOTE: Deltas are sorted by vertex, vertex v deltas are [vertexDeltas[v], vertexDeltas[v + 1])
+typedef struct GLTFMorphTargets {
+	int targetCount;              // Number of morph targets (0: mesh not morphed)
+	int deltaCount;               // Number of deltas (one per target moving a vertex)
+	int *vertexDeltas;            // First delta of every vertex (vertexCount + 1 values)
+	float *deltas;                // Deltas, 8 floats each: position delta, target index, normal delta, 0 (uploaded texels)
+	unsigned int textureId;       // Deltas texture (RGBA32F, 0: not uploaded)
+} GLTFMorphTargets;
+
 // Scene
 typedef struct GLTFScene {
 	int nodeCount;          // Number of nodes
@@ -58,29 +166,256 @@ typedef struct GLTFModel {
 	Mesh *meshes;           // Meshes array
 	Material *materials;    // Materials array
 	int *meshMaterial;      // Mesh material number
+	BoundingBox *meshBounds;    // Meshes bounds (in mesh local space, morph targets with weights in [0, 1] included)
+	GLTFMorphTargets *meshMorphs;   // Morph targets of every mesh (NULL: no mesh has morph targets)
+	int textureCount;       // Number of textures
+	Texture2D *textures;    // Textures loaded from glTF images (shared by materials, unloaded with the model)
 
 	// Scene and node data
 	int nodeCount;          // Number of nodes;
 	GLTFNode *nodes;       // Nodes array;
+	int *sortedNodes;       // Node ids sorted topologically (parents before children)
+	Matrix *worldTransforms;    // Cached world transform matrix of every node
+	bool transformsDirty;   // Some node transform changed since the last world transforms update
 
 	int sceneCount;         // Number of scenes
 	GLTFScene *scenes;          // Scenes array
 	int scene;              // Scene should be displayed
+
+	int skinCount;          // Number of skins
+	GLTFSkin *skins;        // Skins array
+
+	int animationCount;     // Number of animations
+	GLTFAnimation *animations;  // Animations array
+
+	GLTFArena *arena;       // Memory arena backing pModel arrays (NULL: every array is allocated with RL_MALLOC())
+
+	// Shared GPU buffers (GLTF_VERTEX_LAYOUT_SHARED), every mesh vertex array reads its range of them
+	unsigned int vertexBuffer;  // Vertex buffer of every mesh interleaved vertices (0: meshes have their own buffers)
+	unsigned int indexBuffer;   // Index buffer of every mesh indices (0: meshes have their own buffers)
+	int *meshFirstIndex;        // First index of every mesh in the shared index buffer (NULL: meshes indices start at 0)
+
+	// Material levels of detail (MSFT_lod), materials of level i (1..n) of material m are materialLods[materialLodStart[m] + i - 1]
+	int *materialLodStart;      // First lower level of every material (materialCount + 1 values, NULL: no levels of detail)
+	int *materialLods;          // Material ids of the materials lower levels
+
+	GLTFModelBVH *bvh;          // Ray and box queries acceleration structure (NULL: not generated, unloaded with the pModel)
+	GLTFAssetCache *assetCache; // Asset cache sharing pModel textures and materials (NULL: pModel owns them)
 } GLTFModel;
 
+// Draw list item, a mesh to be drawn with a material and a world transform
+typedef struct GLTFDrawItem {
+	const Mesh *mesh;            // Mesh to draw
+	const Material *material;    // Material to draw the mesh with
+	Color color;                 // Material diffuse color, already multiplied by tint
+	Matrix transform;            // Mesh world transform
+	int firstIndex;              // First mesh index in its index buffer (shared pModel buffers)
+	int jointCount;              // Number of skin joints (0: not skinned)
+	int jointStart;              // First joint matrix in the draw list joint matrices
+	const GLTFMorphTargets *morphTargets;   // Mesh morph targets (NULL: not morphed)
+	int weightStart;             // First morph target weight in the draw list weights
+} GLTFDrawItem;
+
+// Draw statistics, accumulated by the draw functions when enabled (GLTFDrawList.stats, SetGLTFDrawStats())
+// NOTE: Counters are never reset by rgltf, clear them (i.e. every frame) to get per frame values
+typedef struct GLTFDrawStats {
+	int nodesVisited;            // Nodes visited while collecting meshes to draw
+	int nodesCulled;             // Nodes skipped by frustum culling (skipped subtrees nodes included)
+	int drawCalls;               // Mesh draw calls (DrawMesh() equivalent, once per eye with stereo rendering)
+	int materialSwitches;        // Material binds (textures and material colors)
+	int shaderSwitches;          // Shader program binds
+} GLTFDrawStats;
+
+// Node of a draw list node subtree, placed without the subtree root ancestors (internal)
+typedef struct GLTFDrawNode GLTFDrawNode;
+
+// Draw list, collects meshes of one or more models to draw them sorted by shader, material and mesh
+typedef struct GLTFDrawList {
+	int itemCount;               // Number of items
+	int itemCapacity;            // Number of allocated items
+	GLTFDrawItem *items;         // Items array
+	int colorCapacity;           // Number of allocated tinted colors
+	Color *colors;               // Tinted material colors (one per material of the model being added)
+	int jointCount;              // Number of joint matrices
+	int jointCapacity;           // Number of allocated joint matrices
+	float *jointMatrices;        // Joint matrices of the skinned items (3 rows per joint), copied when added
+	int skinCapacity;            // Number of allocated skin joint starts
+	int *skinStarts;             // First joint matrix of every skin of the model being added (-1: not copied yet)
+	int weightCount;             // Number of morph target weights
+	int weightCapacity;          // Number of allocated morph target weights
+	float *weights;              // Morph target weights of the morphed items (multiple of 4 per item), copied when added
+	int instanceCapacity;        // Number of allocated instance transforms
+	Matrix *instances;           // Combined node and instance transforms (DrawGLTFModelInstanced())
+	int nodeCapacity;            // Number of allocated subtree nodes
+	GLTFDrawNode *nodes;         // Transforms and bounds of the node subtree being added, relative to the node parent
+	int lodLevelCount;           // Number of node levels of detail (pModel nodeCount, 0: levels selected without hysteresis)
+	int *lodLevels;              // Levels of detail drawn last by the pModel instance being added, one per node (user owned,
+	                             // zero initialized, set before adding every instance so each one keeps its own levels)
+	GLTFDrawStats *stats;        // Draw statistics accumulated by the draw list functions (NULL: not collected)
+} GLTFDrawList;
+
+// Animation playback state of a pModel instance, animations of many instances are sampled in one batch
+typedef struct GLTFAnimationState {
+	int animation;               // Animation id
+	float time;                  // Playback time (seconds)
+	bool loop;                   // Wrap playback time around the animation duration
+	int *cursors;                // Current keyframe of every animation track (sampling moves it forward)
+	Transform *pose;             // Sampled local transform of every pModel node (only animated nodes are written)
+	float *weights;              // Sampled morph target weights of the animation weights tracks (in tracks order)
+} GLTFAnimationState;
+
+// External resource (buffer or image) loading callback, returned data must be allocated with RL_MALLOC()
+// NOTE: rgltf releases it with RL_FREE(), return NULL if the resource can't be loaded
+typedef unsigned char *(*GLTFResolveUriCallback)(const char *uri, int *dataSize, void *userData);
+
+// Draco compressed primitive (KHR_draco_mesh_compression) to be decoded
+// NOTE: Attribute ids are the Draco unique ids of the mesh attributes (-1: attribute not present)
+typedef struct GLTFDracoPrimitive {
+	const unsigned char *data;    // Compressed data
+	int dataSize;                 // Compressed data size in bytes
+	int positionId;               // POSITION attribute id
+	int normalId;                 // NORMAL attribute id
+	int tangentId;                // TANGENT attribute id
+	int texcoordId;               // TEXCOORD_0 attribute id
+	int colorId;                  // COLOR_0 attribute id
+	unsigned int *indices32;      // Output u32 indices, used instead of mesh indices for more than 65536 vertices (NULL if not required)
+} GLTFDracoPrimitive;
+
+// Draco decoder callback, decodes primitive data into the mesh arrays, returns false if it can't be decoded
+// NOTE: Mesh vertexCount, triangleCount and arrays (vertices, normals, tangents, texcoords: float, colors: u8,
+// indices: u16) are allocated by rgltf for the primitive attributes, decoded vertices must be written to them
+typedef bool (*GLTFDecodeDracoCallback)(const GLTFDracoPrimitive *primitive, Mesh *mesh, void *userData);
+
+// Image transcoding callback (KHR_texture_basisu KTX2 images), returns the image in the requested pixel format
+// NOTE: Called from image decoding threads, image data must be allocated with RL_MALLOC() (released with UnloadImage()),
+// a smaller format can be returned for images without alpha (i.e. DXT1 instead of DXT5), return an empty image on failure
+typedef Image (*GLTFTranscodeImageCallback)(const unsigned char *data, int dataSize, int format, void *userData);
+
+// Mesh CPU arrays freed once uploaded to GPU (GLTFLoadOptions.freeMeshData), flags can be combined
+// NOTE: Vertex and triangle counts are kept, meshes are drawn from their GPU buffers (OpenGL 1.1 is not supported)
+// Freed arrays of tightly packed GPU-ready accessors (float attributes, u8 colors, u16 indices) in memory-mapped files
+// are not copied, they are uploaded straight from the mapped pages
+typedef enum {
+	GLTF_MESH_DATA_VERTICES = 1,      // Vertex positions (mesh.vertices)
+	GLTF_MESH_DATA_TEXCOORDS = 2,     // Texture coordinates (mesh.texcoords, mesh.texcoords2)
+	GLTF_MESH_DATA_NORMALS = 4,       // Normals (mesh.normals)
+	GLTF_MESH_DATA_TANGENTS = 8,      // Tangents (mesh.tangents)
+	GLTF_MESH_DATA_COLORS = 16,       // Colors (mesh.colors)
+	GLTF_MESH_DATA_INDICES = 32,      // Triangle indices (mesh.indices)
+	GLTF_MESH_DATA_ATTRIBUTES = 30,   // Every array but positions and indices (kept for picking and collisions)
+	GLTF_MESH_DATA_ALL = 63           // Every array
+} GLTFMeshDataFlags;
+
+// Mesh vertex buffers layout on GPU (GLTFLoadOptions.vertexLayout)
+// NOTE: Interleaved layouts require vertex arrays (VAO), separate buffers are used if not supported. Meshes of a
+// shared layout pModel must be drawn with rgltf functions, raylib DrawMesh() always starts at index 0
+typedef enum {
+	GLTF_VERTEX_LAYOUT_SEPARATE = 0,  // One vertex buffer per attribute (as UploadMesh())
+	GLTF_VERTEX_LAYOUT_INTERLEAVED,   // One interleaved vertex buffer per mesh (attributes in shader location order)
+	GLTF_VERTEX_LAYOUT_SHARED         // Interleaved vertices and indices of every mesh in a single vertex and index buffer
+} GLTFVertexLayout;
+
+// Model loading statistics, filled by the loading functions when requested (GLTFLoadOptions.stats), times in seconds
+// NOTE: Models loaded from a binary cache have no buffers, images and meshes stages, asynchronously loaded
+// models statistics are complete once the model is ready
+typedef struct GLTFLoadStats {
+	double parseTime;            // glTF/glb parsing (binary cache loading and validation)
+	double bufferTime;           // Buffers loading and decoding (base64 data uris, EXT_meshopt_compression)
+	double imageTime;            // Images loading and decoding (or transcoding)
+	double meshTime;             // Materials, mesh attributes, nodes, skins and animations conversion
+	double uploadTime;           // Textures and meshes upload to GPU
+	unsigned int bytesRead;      // Bytes read: glTF/glb data, external buffers and images (binary cache file)
+	int texturesDecoded;         // Images decoded (or transcoded)
+	int duplicatedImages;        // Material textures sharing an image already requested (decoded once)
+	unsigned int vertexBytes;    // Vertex data uploaded to GPU
+	unsigned int indexBytes;     // Index data uploaded to GPU
+	int sharedTextures;          // Textures shared from the asset cache (not decoded or not uploaded again)
+	int sharedMaterials;         // Materials shared from the asset cache
+} GLTFLoadStats;
+
+// Asynchronous model loading handle
+typedef struct GLTFModelAsync GLTFModelAsync;
+
+// Asynchronous model loading completion callback
+typedef void (*GLTFModelLoadedCallback)(GLTFModelAsync *load, void *userData);
+
+// Model loading options, zero initialized options use default values
+typedef struct GLTFLoadOptions {
+	GLTFResolveUriCallback resolveUri;    // Load external resources with this callback instead of reading files (NULL: read files)
+	void *userData;                       // User data passed to callbacks
+	int imageThreads;                     // Number of threads decoding images (0: one per CPU core, 1: calling thread only)
+	GLTFModelLoadedCallback loadedCallback;   // Called by UpdateGLTFModelAsync() when an asynchronously loaded model is ready
+	bool dequantize;                      // Upload quantized (KHR_mesh_quantization) vertex attributes to GPU as floats instead of their compact formats
+	GLTFDecodeDracoCallback decodeDraco;  // Decode KHR_draco_mesh_compression primitives with this callback (NULL: not supported)
+	GLTFTranscodeImageCallback transcodeImage;    // Transcode KHR_texture_basisu (KTX2) images with this callback (NULL: fallback images are used)
+	int textureFormat;                    // Pixel format of transcoded images (0: best compressed format supported by the GPU)
+	bool arena;                           // Allocate pModel arrays (nodes, meshes data...) from a few large memory blocks, released at once by UnloadGLTFModel()
+	unsigned int freeMeshData;            // Mesh CPU arrays freed once uploaded to GPU (GLTFMeshDataFlags, 0: keep all arrays)
+	int vertexLayout;                     // Mesh vertex buffers layout on GPU (GLTFVertexLayout, 0: one buffer per attribute)
+	GLTFLoadStats *stats;                 // Filled with loading statistics (NULL: not collected)
+	int meshThreads;                      // Number of threads decoding mesh primitives (0: one per CPU core, 1: calling thread only)
+	GLTFAssetCache *assetCache;           // Share textures and materials with the models loaded with the same cache (NULL: not shared)
+} GLTFLoadOptions;
+
 RLAPI GLTFModel LoadGLTFModel(const char *fileName);	//Load GTLF pModel
+RLAPI GLTFModel LoadGLTFModelEx(const char *fileName, const GLTFLoadOptions *options);    // Load glTF pModel with loading options
+RLAPI GLTFModel LoadGLTFModelFromMemory(const unsigned char *data, int size, const char *basePath, GLTFLoadOptions *options);  // Load glTF pModel from memory (.gltf or .glb data), external uris are relative to basePath
+RLAPI bool SaveGLTFModelCache(const char *fileName, const char *cacheFileName, const GLTFLoadOptions *options);  // Load glTF pModel CPU data and save it to a binary cache file
+RLAPI GLTFModel LoadGLTFModelCache(const char *cacheFileName, const char *fileName, const GLTFLoadOptions *options);  // Load glTF pModel from a binary cache file, a missing or stale cache falls back to fileName (and is saved again)
+RLAPI GLTFModelAsync *LoadGLTFModelAsync(const char *fileName, const GLTFLoadOptions *options);  // Start loading glTF pModel on a background thread
+RLAPI bool UpdateGLTFModelAsync(GLTFModelAsync *load, int byteBudget, float timeBudget);  // Upload loaded data to GPU within budget (bytes, seconds, 0: no limit), call every frame, returns true when ready
+RLAPI bool IsGLTFModelAsyncReady(const GLTFModelAsync *load);       // Check if asynchronously loaded pModel is ready
+RLAPI GLTFModel FinishGLTFModelAsync(GLTFModelAsync *load);         // Get asynchronously loaded pModel (waits if required), releases the handle
 RLAPI void UnloadGLTFModel(GLTFModel model);
+RLAPI GLTFAssetCache *LoadGLTFAssetCache(void);                                    // Load asset cache, textures (by image uri or content) and materials are shared by the models loaded with it
+RLAPI void UnloadGLTFAssetCache(GLTFAssetCache *cache);                            // Unload asset cache and its remaining resources (unload the models using it first)
+RLAPI Shader LoadGLTFAssetShader(GLTFAssetCache *cache, const char *vsFileName, const char *fsFileName);  // Load shader shared through the asset cache, loaded once per files pair
+RLAPI void UnloadGLTFAssetShader(GLTFAssetCache *cache, Shader shader);           // Release shader loaded with LoadGLTFAssetShader(), unloaded by its last user
+
+// NOTE: Immediate draw functions (DrawGLTFModel(), DrawGLTFScene()...) share an internal draw queue, call them from the main thread only
 RLAPI void DrawGLTFModel(GLTFModel model, Vector3 position, float scale, Color tint);                           // Draw a pModel (with texture if set)
 RLAPI void DrawGLTFModelEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint); // Draw a pModel with extended parameters
 RLAPI void DrawGLTFModelWires(GLTFModel model, Vector3 position, float scale, Color tint);                      // Draw a pModel wires (with texture if set)
 RLAPI void DrawGLTFModelWiresEx(GLTFModel model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint); // Draw a pModel wires (with texture if set) with extended parameters
 
+RLAPI void DrawGLTFModelInstanced(GLTFModel model, const Matrix *transforms, int count, Color tint);           // Draw a pModel many times with GPU instancing (requires an instancing shader)
+
 RLAPI void DrawGLTFNode(GLTFModel model, int node_id, Matrix Transform, Color tint);        // Draw a Model's node (with texture if set)
 RLAPI void DrawGLTFNodeWires(GLTFModel model,int node_id, Matrix Transform, Color tint);   // Draw a Model's node wires (with texture if set)
 
 RLAPI void DrawGLTFScene(GLTFModel model,int scene_id, Matrix Transform, Color tint);        // Draw a Model's scene (with texture if set)
 RLAPI void DrawGLTFSceneWires(GLTFModel model,int scene_id, Matrix Transform, Color tint);   // Draw a Model's scene wires (with texture if set)
 
+RLAPI GLTFDrawList LoadGLTFDrawList(int capacity);                                          // Load a draw list with an initial item capacity
+RLAPI void UnloadGLTFDrawList(GLTFDrawList list);                                          // Unload draw list
+RLAPI void ClearGLTFDrawList(GLTFDrawList *list);                                          // Remove all draw list items (keeps allocated memory)
+RLAPI void AddGLTFNodeToDrawList(GLTFDrawList *list, GLTFModel model, int node_id, Matrix transform, Color tint);    // Add a Model's node meshes to draw list
+RLAPI void AddGLTFSceneToDrawList(GLTFDrawList *list, GLTFModel model, int scene_id, Matrix transform, Color tint);  // Add a Model's scene meshes to draw list
+RLAPI void DrawGLTFDrawList(GLTFDrawList *list);                                           // Sort and draw draw list items
+RLAPI void SetGLTFDrawStats(GLTFDrawStats *stats);                                          // Set draw statistics accumulated by the Draw*() functions (NULL: not collected)
+RLAPI void SetGLTFDrawLodLevels(int *lodLevels, int count);                                 // Set levels of detail of the pModel instance drawn by the next Draw*() calls (one per node, NULL: no hysteresis)
+RLAPI void UnloadGLTFDrawQueue(void);                                                        // Unload internal draw queue memory of the Draw*() functions (call before CloseWindow())
+
+RLAPI void AddGLTFSceneToDrawListCulled(GLTFDrawList *list, GLTFModel model, int scene_id, Matrix transform, Matrix viewProjection, Color tint);  // Add a Model's scene meshes inside the view frustum to draw list
+RLAPI void DrawGLTFSceneCulled(GLTFModel model, int scene_id, Matrix transform, Matrix viewProjection, Color tint);  // Draw a Model's scene, skipping node subtrees outside the view frustum
+RLAPI void DrawGLTFNodeCulled(GLTFModel model, int node_id, Matrix transform, Matrix viewProjection, Color tint);    // Draw a Model's node, skipping node subtrees outside the view frustum
+RLAPI Matrix GetGLTFCameraViewProjection(Camera camera, float aspect);                     // Get camera view-projection matrix (as set by BeginMode3D()) for culling
+
+RLAPI void GenGLTFModelBVH(GLTFModel *model);                                               // Generate pModel acceleration structure for ray and box queries (refit by UpdateGLTFModelTransforms())
+RLAPI RayCollision GetRayCollisionGLTFModel(GLTFModel model, Ray ray, Matrix transform);    // Get collision info between ray and pModel (pModel scene meshes)
+RLAPI RayCollision GetRayCollisionGLTFModelEx(GLTFModel model, Ray ray, Matrix transform, int *node_id, int *mesh_id);  // Get collision info between ray and pModel, with hit node and mesh ids (-1: no hit)
+RLAPI int GetGLTFModelBoxOverlaps(GLTFModel model, BoundingBox box, Matrix transform, int *node_ids, int *instances, int maxCount);  // Get pModel node instances with bounds overlapping a box, returns the number of nodes written
+
+RLAPI void SetGLTFNodeTransform(GLTFModel *model, int node_id, Transform transform);        // Set a Model's node local transform (marks the node subtree dirty)
+RLAPI void UpdateGLTFModelTransforms(GLTFModel *model);                                    // Update cached world transforms of the dirty node subtrees
+RLAPI Matrix GetGLTFNodeWorldTransform(GLTFModel model, int node_id);                      // Get a Model's node cached world transform
+
+RLAPI GLTFAnimationState LoadGLTFAnimationState(GLTFModel model, int animation_id, bool loop);  // Load animation playback state of a pModel instance (pose starts as the nodes transforms)
+RLAPI void UnloadGLTFAnimationState(GLTFAnimationState state);                             // Unload animation playback state
+RLAPI void UpdateGLTFAnimationStates(GLTFModel model, GLTFAnimationState *states, int count, float deltaTime);  // Advance playback time of many states and sample their animations pose
+RLAPI void ApplyGLTFAnimationState(GLTFModel *model, const GLTFAnimationState *state);     // Set a Model's animated nodes transforms and morph target weights from a sampled pose (marks them dirty)
+RLAPI void SetGLTFNodeMorphWeights(GLTFModel *model, int node_id, const float *weights, int count);  // Set a Model's node meshes morph target weights (blended on GPU when drawn)
+
 #if defined(__cplusplus)
 }            // Prevents name mangling of functions
 #endif
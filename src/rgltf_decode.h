@@ -0,0 +1,263 @@
+/*
+ * rgltf
+ *
+ * Vertex attribute and base64 decoding kernels used by the glTF loader
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef RGLTF_DECODE_H
+#define RGLTF_DECODE_H
+
+// NOTE: This header is internal to rgltf (and its benchmarks), it only depends on the C library.
+// Every vertex kernel reads "count" elements from "src", placed "stride" bytes apart, and writes them
+// tightly packed into "dst". No temporary buffers are used.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Define RGLTF_NO_SIMD to only use the portable kernels
+#if !defined(RGLTF_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define RGLTF_DECODE_SSE2
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define RGLTF_DECODE_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+// Copy elements of elementSize bytes, a single memcpy() if source data is tightly packed
+static void DecodeCopy(void *dst, const void *src, size_t stride, size_t count, size_t elementSize)
+{
+	if (stride == elementSize) {
+		memcpy(dst, src, count*elementSize);
+		return;
+	}
+
+	unsigned char *out = (unsigned char *)dst;
+	const unsigned char *in = (const unsigned char *)src;
+
+	// NOTE: Fixed size copies are compiled to plain (SIMD) register moves
+	switch (elementSize) {
+	case 4: for (size_t i = 0; i < count; i++, in += stride, out += 4) memcpy(out, in, 4); break;
+	case 8: for (size_t i = 0; i < count; i++, in += stride, out += 8) memcpy(out, in, 8); break;
+	case 12: for (size_t i = 0; i < count; i++, in += stride, out += 12) memcpy(out, in, 12); break;
+	case 16: for (size_t i = 0; i < count; i++, in += stride, out += 16) memcpy(out, in, 16); break;
+	default: for (size_t i = 0; i < count; i++, in += stride, out += elementSize) memcpy(out, in, elementSize); break;
+	}
+}
+
+// Normalized u16 to u8 conversion: floor(x*255/65535) == floor(x/257) == ((x*65281) >> 16) >> 8
+static unsigned char DecodeUnorm16ToUnorm8(unsigned short value)
+{
+	return (unsigned char)((((unsigned int)value*65281u) >> 16) >> 8);
+}
+
+#if !defined(RGLTF_DECODE_SSE2) && !defined(RGLTF_DECODE_NEON)
+// Normalized float to u8 conversion, out of range values are clamped (portable kernels only)
+static unsigned char DecodeFloatToUnorm8(float value)
+{
+	return (value > 0.0f)? ((value < 1.0f)? (unsigned char)(value*255.0f) : 255) : 0;
+}
+#endif
+
+// Decode vec4 u16 normalized colors into vec4 u8 colors
+static void DecodeColorsU16(unsigned char *dst, const void *src, size_t stride, size_t count)
+{
+	const unsigned char *in = (const unsigned char *)src;
+	size_t i = 0;
+
+	if (stride == 4*sizeof(unsigned short)) {
+		// Tightly packed: convert 16 components (4 colors) per iteration
+		const unsigned short *values = (const unsigned short *)src;
+		size_t n = count*4, c = 0;
+#if defined(RGLTF_DECODE_SSE2)
+		const __m128i scale = _mm_set1_epi16((short)65281);
+		for (; c + 16 <= n; c += 16) {
+			__m128i a = _mm_srli_epi16(_mm_mulhi_epu16(_mm_loadu_si128((const __m128i *)(values + c)), scale), 8);
+			__m128i b = _mm_srli_epi16(_mm_mulhi_epu16(_mm_loadu_si128((const __m128i *)(values + c + 8)), scale), 8);
+			_mm_storeu_si128((__m128i *)(dst + c), _mm_packus_epi16(a, b));
+		}
+#elif defined(RGLTF_DECODE_NEON)
+		const uint16x4_t scale = vdup_n_u16(65281);
+		for (; c + 8 <= n; c += 8) {
+			uint16x8_t v = vld1q_u16(values + c);
+			uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(v), scale), 16);
+			uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(v), scale), 16);
+			vst1_u8(dst + c, vshrn_n_u16(vcombine_u16(lo, hi), 8));
+		}
+#endif
+		for (; c < n; c++) dst[c] = DecodeUnorm16ToUnorm8(values[c]);
+		return;
+	}
+
+	// Strided (interleaved) data: convert one color per iteration
+	for (; i < count; i++, in += stride, dst += 4) {
+#if defined(RGLTF_DECODE_SSE2)
+		__m128i v = _mm_srli_epi16(_mm_mulhi_epu16(_mm_loadl_epi64((const __m128i *)in), _mm_set1_epi16((short)65281)), 8);
+		int packed = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+		memcpy(dst, &packed, 4);
+#else
+		unsigned short color[4];
+		memcpy(color, in, sizeof(color));
+		for (int c = 0; c < 4; c++) dst[c] = DecodeUnorm16ToUnorm8(color[c]);
+#endif
+	}
+}
+
+// Decode vec4 float normalized colors into vec4 u8 colors
+static void DecodeColorsF32(unsigned char *dst, const void *src, size_t stride, size_t count)
+{
+	const unsigned char *in = (const unsigned char *)src;
+	size_t i = 0;
+
+#if defined(RGLTF_DECODE_SSE2)
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	// NOTE: _mm_max_ps() returns its second operand on NaN, so NaN values become 0
+
+	// Tightly packed: 4 colors per iteration
+	if (stride == 4*sizeof(float)) {
+		for (; i + 4 <= count; i += 4, in += 64, dst += 16) {
+			__m128i c0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps((const float *)in), zero), one), scale));
+			__m128i c1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps((const float *)(in + 16)), zero), one), scale));
+			__m128i c2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps((const float *)(in + 32)), zero), one), scale));
+			__m128i c3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps((const float *)(in + 48)), zero), one), scale));
+			_mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+		}
+	}
+	for (; i < count; i++, in += stride, dst += 4) {
+		__m128i c = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps((const float *)in), zero), one), scale));
+		c = _mm_packs_epi32(c, c);
+		int packed = _mm_cvtsi128_si32(_mm_packus_epi16(c, c));
+		memcpy(dst, &packed, 4);
+	}
+#elif defined(RGLTF_DECODE_NEON)
+	for (; i < count; i++, in += stride, dst += 4) {
+		float color[4];
+		memcpy(color, in, sizeof(color));
+		// NOTE: Float to unsigned conversion saturates, negative and NaN values become 0
+		uint16x4_t c = vqmovn_u32(vcvtq_u32_f32(vmulq_n_f32(vld1q_f32(color), 255.0f)));
+		unsigned int packed = vget_lane_u32(vreinterpret_u32_u8(vqmovn_u16(vcombine_u16(c, c))), 0);
+		memcpy(dst, &packed, 4);
+	}
+#else
+	for (; i < count; i++, in += stride, dst += 4) {
+		float color[4];
+		memcpy(color, in, sizeof(color));
+		for (int c = 0; c < 4; c++) dst[c] = DecodeFloatToUnorm8(color[c]);
+	}
+#endif
+}
+
+// Decode u32 indices into u16 indices (higher bits are dropped)
+static void DecodeIndicesU32(unsigned short *dst, const void *src, size_t count)
+{
+	const unsigned int *in = (const unsigned int *)src;
+	size_t i = 0;
+
+#if defined(RGLTF_DECODE_SSE2)
+	// NOTE: SSE2 has no unsigned 32bit pack, sign extend the low 16 bits so signed pack keeps them unchanged
+	for (; i + 8 <= count; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(in + i));
+		__m128i b = _mm_loadu_si128((const __m128i *)(in + i + 4));
+		a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+		b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(a, b));
+	}
+#elif defined(RGLTF_DECODE_NEON)
+	for (; i + 8 <= count; i += 8) {
+		uint16x4_t lo = vmovn_u32(vld1q_u32(in + i));
+		uint16x4_t hi = vmovn_u32(vld1q_u32(in + i + 4));
+		vst1q_u16(dst + i, vcombine_u16(lo, hi));
+	}
+#endif
+	for (; i < count; i++) dst[i] = (unsigned short)in[i];
+}
+
+// Base64 character values, 255 for characters out of the alphabet (including '=' and the null terminator)
+static const unsigned char base64Values[256] = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+	 52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+	255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+	 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+	255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+	 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+// Get decoded size of base64 text of srcLength characters, padding characters are not data
+static size_t GetBase64DecodedSize(const char *src, size_t srcLength)
+{
+	while ((srcLength > 0) && (src[srcLength - 1] == '=')) srcLength--;
+
+	// NOTE: A final group of n < 4 characters holds n - 1 bytes
+	return srcLength/4*3 + ((srcLength%4 > 1)? srcLength%4 - 1 : 0);
+}
+
+// Decode exactly dstSize bytes of base64 text, false if the text is shorter or not valid base64
+// NOTE: Characters are validated one by one, so the null terminator of a short text is never passed
+static bool DecodeBase64(unsigned char *dst, size_t dstSize, const char *src)
+{
+	const unsigned char *in = (const unsigned char *)src;
+	unsigned int a, b, c, d;
+
+	// Full groups: 4 characters into 3 bytes
+	for (size_t n = dstSize/3; n > 0; n--, in += 4, dst += 3) {
+		if (((a = base64Values[in[0]]) > 63) || ((b = base64Values[in[1]]) > 63) ||
+			((c = base64Values[in[2]]) > 63) || ((d = base64Values[in[3]]) > 63)) return false;
+
+		unsigned int bits = (a << 18) | (b << 12) | (c << 6) | d;
+		dst[0] = (unsigned char)(bits >> 16);
+		dst[1] = (unsigned char)(bits >> 8);
+		dst[2] = (unsigned char)bits;
+	}
+
+	// Last group: 2 characters for 1 byte, 3 characters for 2 bytes
+	switch (dstSize%3) {
+	case 1:
+		if (((a = base64Values[in[0]]) > 63) || ((b = base64Values[in[1]]) > 63)) return false;
+		dst[0] = (unsigned char)((a << 2) | (b >> 4));
+		break;
+	case 2:
+		if (((a = base64Values[in[0]]) > 63) || ((b = base64Values[in[1]]) > 63) || ((c = base64Values[in[2]]) > 63)) return false;
+		dst[0] = (unsigned char)((a << 2) | (b >> 4));
+		dst[1] = (unsigned char)((b << 4) | (c >> 2));
+		break;
+	default: break;
+	}
+
+	return true;
+}
+
+#endif // RGLTF_DECODE_H
@@ -0,0 +1,436 @@
+/*
+ * rgltf
+ *
+ * EXT_meshopt_compression buffer view decoding used by the glTF loader
+ *
+ * MIT License
+ * Copyright (c) 2022 Roy Qu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef RGLTF_MESHOPT_H
+#define RGLTF_MESHOPT_H
+
+// NOTE: This header is internal to rgltf, it only depends on the C library.
+// Decoders follow the bitstream described by the EXT_meshopt_compression specification
+// (meshoptimizer vertex codec v0, index codec v0/v1 and index sequence codec v0/v1).
+// Every decoder validates its input and returns false on malformed data.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MESHOPT_VERTEX_HEADER       0xa0
+#define MESHOPT_INDEX_HEADER        0xe0
+#define MESHOPT_SEQUENCE_HEADER     0xd0
+#define MESHOPT_BYTE_GROUP_SIZE     16
+#define MESHOPT_VERTEX_BLOCK_BYTES  8192
+#define MESHOPT_VERTEX_BLOCK_MAX    256
+#define MESHOPT_TAIL_MIN_SIZE       32
+
+// Decode a group of 16 bytes encoded with 0, 2, 4 or 8 bits per byte, returns NULL if data is too short
+static const unsigned char *DecodeMeshoptBytesGroup(const unsigned char *data, const unsigned char *end, unsigned char *dst, int bitsLog2)
+{
+	if (bitsLog2 == 0) {
+		memset(dst, 0, MESHOPT_BYTE_GROUP_SIZE);
+		return data;
+	}
+
+	if (bitsLog2 == 3) {
+		if (end - data < MESHOPT_BYTE_GROUP_SIZE) return NULL;
+		memcpy(dst, data, MESHOPT_BYTE_GROUP_SIZE);
+		return data + MESHOPT_BYTE_GROUP_SIZE;
+	}
+
+	// NOTE: Values are packed msb first, the biggest value is a sentinel for a byte stored after the group bits
+	int bits = (bitsLog2 == 1)? 2 : 4;
+	int sentinel = (1 << bits) - 1;
+	const unsigned char *extra = data + MESHOPT_BYTE_GROUP_SIZE*bits/8;
+	if (extra > end) return NULL;
+
+	for (int i = 0; i < MESHOPT_BYTE_GROUP_SIZE; i++) {
+		int shift = 8 - bits - (i*bits)%8;
+		int value = (data[i*bits/8] >> shift) & sentinel;
+
+		if (value == sentinel) {
+			if (extra >= end) return NULL;
+			dst[i] = *extra++;
+		}
+		else dst[i] = (unsigned char)value;
+	}
+
+	return extra;
+}
+
+// Decode count bytes (multiple of 16) of a vertex block byte channel
+static const unsigned char *DecodeMeshoptBytes(const unsigned char *data, const unsigned char *end, unsigned char *dst, size_t count)
+{
+	size_t groupCount = count/MESHOPT_BYTE_GROUP_SIZE;
+	size_t headerSize = (groupCount + 3)/4;
+	if ((size_t)(end - data) < headerSize) return NULL;
+
+	const unsigned char *header = data;
+	data += headerSize;
+
+	for (size_t i = 0; i < groupCount; i++) {
+		int bitsLog2 = (header[i/4] >> ((i%4)*2)) & 3;
+		data = DecodeMeshoptBytesGroup(data, end, dst + i*MESHOPT_BYTE_GROUP_SIZE, bitsLog2);
+		if (data == NULL) return NULL;
+	}
+
+	return data;
+}
+
+// Decode attributes mode data: count vertices of stride bytes (multiple of 4, up to 256)
+static bool DecodeMeshoptVertices(unsigned char *dst, size_t count, size_t stride, const unsigned char *src, size_t size)
+{
+	if ((stride == 0) || (stride > 256) || (stride%4 != 0) || (size < 1 + stride)) return false;
+	if (src[0] != MESHOPT_VERTEX_HEADER) return false;   // Only version 0 is defined
+
+	const unsigned char *data = src + 1;
+	const unsigned char *end = src + size;
+
+	// NOTE: The first vertex (base of the deltas) is stored in the tail of the data
+	unsigned char lastVertex[256];
+	memcpy(lastVertex, end - stride, stride);
+
+	size_t tailSize = (stride < MESHOPT_TAIL_MIN_SIZE)? MESHOPT_TAIL_MIN_SIZE : stride;
+	if (size < 1 + tailSize) return false;
+	const unsigned char *dataEnd = end - tailSize;
+
+	size_t blockSize = (MESHOPT_VERTEX_BLOCK_BYTES/stride) & ~(size_t)(MESHOPT_BYTE_GROUP_SIZE - 1);
+	if (blockSize > MESHOPT_VERTEX_BLOCK_MAX) blockSize = MESHOPT_VERTEX_BLOCK_MAX;
+
+	unsigned char buffer[MESHOPT_VERTEX_BLOCK_MAX];
+
+	for (size_t offset = 0; offset < count; offset += blockSize) {
+		size_t blockCount = (count - offset < blockSize)? count - offset : blockSize;
+		size_t alignedCount = (blockCount + MESHOPT_BYTE_GROUP_SIZE - 1) & ~(size_t)(MESHOPT_BYTE_GROUP_SIZE - 1);
+		unsigned char *vertices = dst + offset*stride;
+
+		// Every byte of the vertex is a channel of zigzag encoded deltas
+		for (size_t k = 0; k < stride; k++) {
+			data = DecodeMeshoptBytes(data, dataEnd, buffer, alignedCount);
+			if (data == NULL) return false;
+
+			unsigned char previous = lastVertex[k];
+			for (size_t i = 0; i < blockCount; i++) {
+				unsigned char delta = (unsigned char)((buffer[i] >> 1) ^ -(buffer[i] & 1));
+				previous = (unsigned char)(previous + delta);
+				vertices[i*stride + k] = previous;
+			}
+		}
+
+		memcpy(lastVertex, vertices + (blockCount - 1)*stride, stride);
+	}
+
+	return (data == dataEnd);
+}
+
+// Decode a variable length (7 bits per byte) value, returns NULL if data is too short
+static const unsigned char *DecodeMeshoptVByte(const unsigned char *data, const unsigned char *end, unsigned int *value)
+{
+	if (data >= end) return NULL;
+
+	unsigned char lead = *data++;
+	*value = lead & 127;
+
+	for (int i = 0, shift = 7; (lead >= 128) && (i < 4); i++, shift += 7) {
+		if (data >= end) return NULL;
+		lead = *data++;
+		*value |= (unsigned int)(lead & 127) << shift;
+	}
+
+	return data;
+}
+
+// Decode a zigzag delta encoded index
+static const unsigned char *DecodeMeshoptIndex(const unsigned char *data, const unsigned char *end, unsigned int *last)
+{
+	unsigned int value = 0;
+	data = DecodeMeshoptVByte(data, end, &value);
+	if (data != NULL) *last += (value >> 1) ^ (0u - (value & 1));
+
+	return data;
+}
+
+// Write triangle indices (u16 or u32)
+static void WriteMeshoptTriangle(void *dst, size_t offset, size_t indexSize, unsigned int a, unsigned int b, unsigned int c)
+{
+	if (indexSize == 2) {
+		unsigned short *indices = (unsigned short *)dst + offset;
+		indices[0] = (unsigned short)a;
+		indices[1] = (unsigned short)b;
+		indices[2] = (unsigned short)c;
+	}
+	else {
+		unsigned int *indices = (unsigned int *)dst + offset;
+		indices[0] = a;
+		indices[1] = b;
+		indices[2] = c;
+	}
+}
+
+// Decode triangles mode data: count indices (multiple of 3) of indexSize bytes (2 or 4)
+// NOTE: Triangles are encoded with a 16 entries edge FIFO and vertex FIFO, the (stream specific)
+// 16 bytes auxiliary code table is stored at the end of the data
+static bool DecodeMeshoptTriangles(void *dst, size_t count, size_t indexSize, const unsigned char *src, size_t size)
+{
+	if ((count%3 != 0) || ((indexSize != 2) && (indexSize != 4))) return false;
+	if (size < 1 + count/3 + 16) return false;
+	if (((src[0] & 0xf0) != MESHOPT_INDEX_HEADER) || ((src[0] & 0x0f) > 1)) return false;
+
+	int version = src[0] & 0x0f;
+	int fecMax = (version >= 1)? 13 : 15;
+
+	unsigned int edgeFifo[16][2];
+	unsigned int vertexFifo[16];
+	memset(edgeFifo, 0xff, sizeof(edgeFifo));
+	memset(vertexFifo, 0xff, sizeof(vertexFifo));
+	unsigned int edgeOffset = 0;
+	unsigned int vertexOffset = 0;
+	unsigned int next = 0;
+	unsigned int last = 0;
+
+	const unsigned char *code = src + 1;
+	const unsigned char *data = code + count/3;
+	const unsigned char *dataEnd = src + size - 16;
+	const unsigned char *codeAuxTable = dataEnd;
+
+#define PUSH_VERTEX(v, cond) { vertexFifo[vertexOffset] = (v); vertexOffset = (vertexOffset + (cond)) & 15; }
+#define PUSH_EDGE(a, b) { edgeFifo[edgeOffset][0] = (a); edgeFifo[edgeOffset][1] = (b); edgeOffset = (edgeOffset + 1) & 15; }
+
+	for (size_t i = 0; i < count; i += 3) {
+		if (data > dataEnd) return false;
+
+		unsigned char codeTri = *code++;
+
+		if (codeTri < 0xf0) {
+			// Triangle sharing an edge of the edge FIFO
+			int fe = codeTri >> 4;
+			unsigned int a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+			unsigned int b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+			unsigned int c = 0;
+			int fec = codeTri & 15;
+			int pushed = 1;
+
+			if (fec < fecMax) {
+				// Third vertex is the next new vertex or a vertex of the vertex FIFO
+				c = (fec == 0)? next : vertexFifo[(vertexOffset - 1 - fec) & 15];
+				pushed = (fec == 0);
+				next += pushed;
+			}
+			else {
+				// Third vertex is explicit (delta encoded), version 1 encodes last -1/+1 as 13/14
+				if (fec != 15) last += (fec == 13)? -1 : 1;
+				else if ((data = DecodeMeshoptIndex(data, dataEnd, &last)) == NULL) return false;
+				c = last;
+			}
+
+			WriteMeshoptTriangle(dst, i, indexSize, a, b, c);
+
+			PUSH_VERTEX(c, pushed);
+			PUSH_EDGE(c, b);
+			PUSH_EDGE(a, c);
+		}
+		else {
+			// Triangle not sharing an edge, vertices FIFO positions are in the auxiliary code
+			unsigned char codeAux = 0;
+			int fea = 0;
+
+			if (codeTri < 0xfe) codeAux = codeAuxTable[codeTri & 15];
+			else {
+				if (data >= dataEnd) return false;
+				codeAux = *data++;
+				fea = (codeTri == 0xfe)? 0 : 15;
+
+				// NOTE: A zero auxiliary code not read from the table resets the next vertex
+				if (codeAux == 0) next = 0;
+			}
+
+			int feb = codeAux >> 4;
+			int fec = codeAux & 15;
+
+			// NOTE: Next vertex is incremented for every vertex before decoding explicit indices
+			unsigned int a = (fea == 0)? next++ : 0;
+			unsigned int b = (feb == 0)? next++ : vertexFifo[(vertexOffset - feb) & 15];
+			unsigned int c = (fec == 0)? next++ : vertexFifo[(vertexOffset - fec) & 15];
+
+			if (fea == 15) {
+				if ((data = DecodeMeshoptIndex(data, dataEnd, &last)) == NULL) return false;
+				a = last;
+			}
+			if (feb == 15) {
+				if ((data = DecodeMeshoptIndex(data, dataEnd, &last)) == NULL) return false;
+				b = last;
+			}
+			if (fec == 15) {
+				if ((data = DecodeMeshoptIndex(data, dataEnd, &last)) == NULL) return false;
+				c = last;
+			}
+
+			WriteMeshoptTriangle(dst, i, indexSize, a, b, c);
+
+			PUSH_VERTEX(a, 1);
+			PUSH_VERTEX(b, (feb == 0) || (feb == 15));
+			PUSH_VERTEX(c, (fec == 0) || (fec == 15));
+			PUSH_EDGE(b, a);
+			PUSH_EDGE(c, b);
+			PUSH_EDGE(a, c);
+		}
+	}
+
+#undef PUSH_VERTEX
+#undef PUSH_EDGE
+
+	return (data == dataEnd);
+}
+
+// Decode indices mode data: count indices of indexSize bytes (2 or 4), delta encoded from one of two baselines
+static bool DecodeMeshoptIndices(void *dst, size_t count, size_t indexSize, const unsigned char *src, size_t size)
+{
+	if ((indexSize != 2) && (indexSize != 4)) return false;
+	if (size < 1 + count + 4) return false;
+	if (((src[0] & 0xf0) != MESHOPT_SEQUENCE_HEADER) || ((src[0] & 0x0f) > 1)) return false;
+
+	const unsigned char *data = src + 1;
+	const unsigned char *dataEnd = src + size - 4;
+	unsigned int last[2] = { 0, 0 };
+
+	for (size_t i = 0; i < count; i++) {
+		unsigned int value = 0;
+		if ((data = DecodeMeshoptVByte(data, dataEnd, &value)) == NULL) return false;
+
+		unsigned int baseline = value & 1;
+		value >>= 1;
+		last[baseline] += (value >> 1) ^ (0u - (value & 1));
+
+		if (indexSize == 2) ((unsigned short *)dst)[i] = (unsigned short)last[baseline];
+		else ((unsigned int *)dst)[i] = last[baseline];
+	}
+
+	return (data == dataEnd);
+}
+
+// Round float to nearest integer (halfway cases away from zero)
+static int RoundMeshoptFloat(float value)
+{
+	return (int)(value + ((value >= 0.0f)? 0.5f : -0.5f));
+}
+
+// Octahedral filter: i8/i16 vec4 (x, y, encoded 1, w) to normalized vec3 (x, y, z) and unchanged w
+// NOTE: Stride must be 4 (i8) or 8 (i16), data is not modified otherwise
+static bool DecodeMeshoptFilterOct(void *data, size_t count, size_t stride)
+{
+	if ((stride != 4) && (stride != 8)) return false;
+
+	const float max = (stride == 4)? 127.0f : 32767.0f;
+
+	for (size_t i = 0; i < count; i++) {
+		int v[3];
+
+		// NOTE: Components are read as signed values of stride/4 bytes
+		if (stride == 4) for (int k = 0; k < 3; k++) v[k] = ((signed char *)data)[i*4 + k];
+		else for (int k = 0; k < 3; k++) v[k] = ((short *)data)[i*4 + k];
+
+		float x = (float)v[0];
+		float y = (float)v[1];
+		float z = (float)v[2] - fabsf(x) - fabsf(y);
+
+		// Fix octahedral coordinates for z < 0
+		float t = (z >= 0.0f)? 0.0f : z;
+		x += (x >= 0.0f)? t : -t;
+		y += (y >= 0.0f)? t : -t;
+
+		float length = sqrtf(x*x + y*y + z*z);
+		float scale = (length > 0.0f)? max/length : 0.0f;
+
+		v[0] = RoundMeshoptFloat(x*scale);
+		v[1] = RoundMeshoptFloat(y*scale);
+		v[2] = RoundMeshoptFloat(z*scale);
+
+		if (stride == 4) for (int k = 0; k < 3; k++) ((signed char *)data)[i*4 + k] = (signed char)v[k];
+		else for (int k = 0; k < 3; k++) ((short *)data)[i*4 + k] = (short)v[k];
+	}
+
+	return true;
+}
+
+// Quaternion filter: i16 vec4 (3 smallest components, scale and max component index) to normalized quaternion
+// NOTE: Stride must be 8, data is not modified otherwise
+static bool DecodeMeshoptFilterQuat(short *data, size_t count, size_t stride)
+{
+	if (stride != 8) return false;
+
+	const float scale = 1.0f/sqrtf(2.0f);
+
+	for (size_t i = 0; i < count; i++) {
+		short *q = &data[i*4];
+
+		// Scale is stored in the high bits of the last component, max component index in its 2 low bits
+		int sf = q[3] | 3;
+		float ss = scale/(float)sf;
+
+		float x = (float)q[0]*ss;
+		float y = (float)q[1]*ss;
+		float z = (float)q[2]*ss;
+
+		// NOTE: Clamped to avoid NaN due to precision errors
+		float ww = 1.0f - x*x - y*y - z*z;
+		float w = sqrtf((ww >= 0.0f)? ww : 0.0f);
+
+		int qc = q[3] & 3;
+		int xf = RoundMeshoptFloat(x*32767.0f);
+		int yf = RoundMeshoptFloat(y*32767.0f);
+		int zf = RoundMeshoptFloat(z*32767.0f);
+		int wf = RoundMeshoptFloat(w*32767.0f);
+
+		q[(qc + 1) & 3] = (short)xf;
+		q[(qc + 2) & 3] = (short)yf;
+		q[(qc + 3) & 3] = (short)zf;
+		q[(qc + 0) & 3] = (short)wf;
+	}
+
+	return true;
+}
+
+// Exponential filter: 32 bit values (24 bit signed mantissa, 8 bit signed exponent) to floats
+// NOTE: Stride must be a multiple of 4, data is not modified otherwise
+static bool DecodeMeshoptFilterExp(unsigned int *data, size_t count, size_t stride)
+{
+	if ((stride == 0) || (stride%4 != 0)) return false;
+
+	for (size_t i = 0; i < count*stride/4; i++) {
+		unsigned int v = data[i];
+		int mantissa = (int)(v << 8) >> 8;
+		int exponent = (int)v >> 24;
+
+		// NOTE: ldexpf(mantissa, exponent) computed as mantissa*2^exponent
+		union { float f; unsigned int u; } value;
+		value.u = (unsigned int)(exponent + 127) << 23;
+		value.f = value.f*(float)mantissa;
+
+		data[i] = value.u;
+	}
+
+	return true;
+}
+
+#endif // RGLTF_MESHOPT_H